@@ -0,0 +1,254 @@
+/*
+	arrivals.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: arrivals.c moves the random sampling of the scheduling loop onto a producer thread. The
+	records travel through a single-producer/single-consumer ring: only the producer writes tail and only
+	the consumer writes head, so neither side ever needs a compare-and-swap and every push and pop
+	finishes in a bounded number of steps. Each side keeps a cached copy of the other side's index and
+	only reloads it when the ring looks full (or empty), which keeps the two cache lines from bouncing.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+
+#include "arrivals.h"
+#include "simulator.h"
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ *	Arrival Ring ADT
+ *
+ *+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/************************************************************************************************************
+ * createArrivalRing
+ *
+ * Synopsis: ArrivalRing_p createArrivalRing(int size)
+ *
+ * Description: This function allocates a cache line aligned ring in the heap, rounding size up to a power
+ * of two.
+ *
+ * Returns: A pointer to the ring in the heap, NULL if size is invalid or memory ran out.
+ *
+ ************************************************************************************************************/
+ArrivalRing_p createArrivalRing(int size) {
+	size_t capacity = 2;
+
+	if (size <= 0)
+		return NULL;
+	while (capacity < (size_t) size)
+		capacity <<= 1;
+
+	ArrivalRing_p ring = (ArrivalRing_p) aligned_alloc(CACHE_LINE_SIZE, sizeof(ArrivalRing));
+	if (ring == NULL)
+		return NULL;
+	ring->buffer = (Arrival_p) malloc (sizeof(Arrival) * capacity);
+	if (ring->buffer == NULL) {
+		free(ring);
+		return NULL;
+	}
+	ring->mask = capacity - 1;
+	atomic_init(&ring->head, 0);
+	atomic_init(&ring->tail, 0);
+	ring->cached_head = 0;
+	ring->cached_tail = 0;
+	return ring;
+}
+/************************************************************************************************************
+ * destroyArrivalRing
+ *
+ * Synopsis: void destroyArrivalRing(ArrivalRing_p ring)
+ *
+ * Description: This function frees the records and the ring itself.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void destroyArrivalRing(ArrivalRing_p ring) {
+	if (ring != NULL) {
+		free(ring->buffer);
+		free(ring);
+	}
+}
+/************************************************************************************************************
+ * pushArrival
+ *
+ * Synopsis: int pushArrival(ArrivalRing_p ring, const Arrival * record)
+ *
+ * Description: This function copies the record into the slot at tail and then publishes it with a
+ * release store of the new tail. The consumer's head is only reloaded when the cached copy says the
+ * ring is full.
+ *
+ * Returns: TRUE if the record was stored, FALSE if the ring is full.
+ *
+ ************************************************************************************************************/
+int pushArrival(ArrivalRing_p ring, const Arrival * record) {
+	size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+	if (tail - ring->cached_head > ring->mask) {
+		ring->cached_head = atomic_load_explicit(&ring->head, memory_order_acquire);
+		if (tail - ring->cached_head > ring->mask)
+			return FALSE;
+	}
+	ring->buffer[tail & ring->mask] = *record;
+	atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+	return TRUE;
+}
+/************************************************************************************************************
+ * peekArrival
+ *
+ * Synopsis: Arrival_p peekArrival(ArrivalRing_p ring)
+ *
+ * Description: This function returns the record at head without releasing it. The producer's tail is
+ * only reloaded when the cached copy says the ring is empty.
+ *
+ * Returns: A pointer to the oldest record, NULL if the ring is empty.
+ *
+ ************************************************************************************************************/
+Arrival_p peekArrival(ArrivalRing_p ring) {
+	size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+	if (head == ring->cached_tail) {
+		ring->cached_tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+		if (head == ring->cached_tail)
+			return NULL;
+	}
+	return &ring->buffer[head & ring->mask];
+}
+/************************************************************************************************************
+ * popArrival
+ *
+ * Synopsis: void popArrival(ArrivalRing_p ring)
+ *
+ * Description: This function hands the slot at head back to the producer.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void popArrival(ArrivalRing_p ring) {
+	size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+/************************************************************************************************************
+ * nextArrival
+ *
+ * Synopsis: Arrival_p nextArrival(ArrivalRing_p ring)
+ *
+ * Description: This function waits for the producer when the scheduling loop has caught up with it.
+ *
+ * Returns: A pointer to the oldest record.
+ *
+ ************************************************************************************************************/
+Arrival_p nextArrival(ArrivalRing_p ring) {
+	Arrival_p record;
+
+	while ((record = peekArrival(ring)) == NULL)
+		sched_yield();
+	return record;
+}
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ *	Arrival Producer
+ *
+ *+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/************************************************************************************************************
+ * produceArrivals
+ *
+ * Synopsis: static void * produceArrivals(void * arg)
+ *
+ * Description: This is the producer thread. For every tick it draws the two samples start_loop() draws
+ * inline, from the same substreams, so the run is the same as in the single-threaded mode. Ticks where
+ * nothing happens are not sent. The last record is an ARRIVAL_END one dated after max_ticks.
+ *
+ * Returns: NULL.
+ *
+ ************************************************************************************************************/
+static void * produceArrivals(void * arg) {
+	ArrivalGen_p gen = (ArrivalGen_p) arg;
+	Arrival record;
+	Tick tick;
+
+	for (tick = 1; tick <= gen->max_ticks; tick++) {
+		double demand = expon(&gen->arrivals, gen->avg_proc);
+		double term = expon(&gen->terminations, gen->mean_times);
+
+		record.flags = 0;
+		if (demand > gen->mean_times)
+			record.flags |= ARRIVAL_NEW;
+		if (term < 1.0)
+			record.flags |= ARRIVAL_TERMINATE;
+		if (record.flags == 0)
+			continue;
+		record.tick = tick;
+		record.demand = demand;
+		while (!pushArrival(gen->ring, &record)) {
+			if (atomic_load_explicit(&gen->stop, memory_order_relaxed))
+				return NULL;
+			sched_yield();
+		}
+	}
+	record.tick = gen->max_ticks + 1;
+	record.flags = ARRIVAL_END;
+	record.demand = 0;
+	while (!pushArrival(gen->ring, &record)) {
+		if (atomic_load_explicit(&gen->stop, memory_order_relaxed))
+			return NULL;
+		sched_yield();
+	}
+	return NULL;
+}
+/************************************************************************************************************
+ * startArrivalProducer
+ *
+ * Synopsis: ArrivalGen_p startArrivalProducer(Tick max_ticks, int avg_proc, int mean_times,
+ *                                           const RandStream * streams)
+ *
+ * Description: This function creates the ring and starts the producer thread on copies of the arrival
+ * and termination substreams. The caller keeps drawing from its other substreams meanwhile; the two it
+ * handed over it must leave alone until stopArrivalProducer() is called.
+ *
+ * Returns: A pointer to the generator in the heap, NULL if not successful.
+ *
+ ************************************************************************************************************/
+ArrivalGen_p startArrivalProducer(Tick max_ticks, int avg_proc, int mean_times, const RandStream * streams) {
+	ArrivalGen_p gen = (ArrivalGen_p) malloc (sizeof(ArrivalGen));
+	if (gen == NULL)
+		return NULL;
+	gen->ring = createArrivalRing(ARRIVAL_RING_SIZE);
+	if (gen->ring == NULL) {
+		free(gen);
+		return NULL;
+	}
+	gen->max_ticks = max_ticks;
+	gen->avg_proc = avg_proc;
+	gen->mean_times = mean_times;
+	gen->arrivals = streams[STREAM_ARRIVALS];
+	gen->terminations = streams[STREAM_TERMINATIONS];
+	atomic_init(&gen->stop, FALSE);
+	if (pthread_create(&gen->thread, NULL, produceArrivals, gen) != 0) {
+		destroyArrivalRing(gen->ring);
+		free(gen);
+		return NULL;
+	}
+	return gen;
+}
+/************************************************************************************************************
+ * stopArrivalProducer
+ *
+ * Synopsis: void stopArrivalProducer(ArrivalGen_p gen)
+ *
+ * Description: This function tells the producer to give up if it is waiting on a full ring, joins the
+ * thread and frees the ring and the generator.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void stopArrivalProducer(ArrivalGen_p gen) {
+	if (gen == NULL)
+		return;
+	atomic_store_explicit(&gen->stop, TRUE, memory_order_relaxed);
+	pthread_join(gen->thread, NULL);
+	destroyArrivalRing(gen->ring);
+	free(gen);
+}
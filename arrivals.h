@@ -0,0 +1,108 @@
+/*
+	arrivals.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Header file for the pipelined arrival generator.
+
+	arrivals.c runs the random sampling of start_loop() on a producer thread. The producer walks the
+	ticks of the run in order, draws the same random numbers the scheduling loop would draw and pushes
+	a timestamped record for every tick on which something happens into a single-producer/single-consumer
+	ring. The scheduling loop only has to look at the head of the ring each tick.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _ARRIVALS_H_
+#define _ARRIVALS_H_
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "lf_queue.h"		// for CACHE_LINE_SIZE
+#include "sim_stats.h"
+#include "rand_stream.h"
+
+// record flags
+#define ARRIVAL_NEW 1		// a new process starts on this tick
+#define ARRIVAL_TERMINATE 2	// the running process terminates on this tick
+#define ARRIVAL_END 4		// no more records, the run is over
+
+#define ARRIVAL_RING_SIZE 4096
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct arrival {
+	Tick tick;				// tick of the run the record belongs to
+	int flags;				// combination of the ARRIVAL_ codes
+	double demand;			// exponential sample drawn for the arrival test
+} Arrival;
+
+typedef Arrival * Arrival_p;
+
+typedef struct arrival_ring {
+	_Alignas(CACHE_LINE_SIZE) Arrival * buffer;
+	size_t mask;			// size - 1, size is a power of two
+
+	_Alignas(CACHE_LINE_SIZE) atomic_size_t head;	// next record the consumer reads
+	size_t cached_tail;		// consumer's last view of tail
+
+	_Alignas(CACHE_LINE_SIZE) atomic_size_t tail;	// next record the producer writes
+	size_t cached_head;		// producer's last view of head
+} ArrivalRing;
+
+typedef ArrivalRing * ArrivalRing_p;
+
+typedef struct arrival_gen {
+	ArrivalRing_p ring;
+	pthread_t thread;
+	Tick max_ticks;			// last tick to generate records for
+	int avg_proc;			// mean of the exponential samples
+	int mean_times;			// threshold a sample has to pass for a new process, mean CPU demand
+	RandStream arrivals;	// the producer's own copies of the substreams it draws from
+	RandStream terminations;
+	atomic_int stop;		// set by the consumer to end the producer early
+} ArrivalGen;
+
+typedef ArrivalGen * ArrivalGen_p;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+ArrivalRing_p createArrivalRing(int size);
+// constructor for a ring of at least size records, NULL if
+// not successful
+
+void destroyArrivalRing(ArrivalRing_p ring);
+// destructor for an instantiated ring
+
+int pushArrival(ArrivalRing_p ring, const Arrival * record);
+// producer side only. Returns TRUE if the record was stored,
+// FALSE if the ring is full. Never waits
+
+Arrival_p peekArrival(ArrivalRing_p ring);
+// consumer side only. Returns the oldest record, NULL if the
+// ring is empty. Never waits
+
+void popArrival(ArrivalRing_p ring);
+// consumer side only. Releases the record returned by the
+// last peekArrival()
+
+Arrival_p nextArrival(ArrivalRing_p ring);
+// consumer side only. Same as peekArrival() but yields the
+// CPU until the producer has made a record available
+
+ArrivalGen_p startArrivalProducer(Tick max_ticks, int avg_proc, int mean_times, const RandStream * streams);
+// creates the ring and starts the producer thread drawing from
+// copies of the arrival and termination substreams of streams,
+// NULL if the thread could not be started
+
+void stopArrivalProducer(ArrivalGen_p gen);
+// stops and joins the producer thread and frees the ring
+
+#endif
@@ -0,0 +1,215 @@
+/*
+	batch_means.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Implementation of batch means with MSER warm-up detection (see batch_means.h).
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "batch_means.h"
+#include "queue.h"			// TRUE and FALSE
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * createBatchMeans
+ *
+ * Synopsis: BatchMeans_p createBatchMeans (int limit, Tick size)
+ *
+ * Description: Allocates room for limit batch means, at least 2 * BATCH_MEANS_MIN and rounded up to an
+ * even number so pairs can merge, and starts the first batch.
+ *
+ * Returns: A pointer to the batch means in the heap, NULL if not successful.
+ *
+ ************************************************************************************************************/
+BatchMeans_p createBatchMeans (int limit, Tick size) {
+	BatchMeans_p bm = (BatchMeans_p) malloc (sizeof(BatchMeans));
+
+	if (bm == NULL)
+		return NULL;
+	if (limit < 2 * BATCH_MEANS_MIN)
+		limit = 2 * BATCH_MEANS_MIN;
+	bm->limit = (limit + 1) & ~1;
+	bm->means = (double *) malloc (sizeof(double) * (size_t) bm->limit);
+	if (bm->means == NULL) {
+		free(bm);
+		return NULL;
+	}
+	bm->batches = 0;
+	bm->size = (size > 0) ? size : 1;
+	kahanInit(&bm->partial);
+	return bm;
+}
+/************************************************************************************************************
+ * destroyBatchMeans
+ *
+ * Synopsis: void destroyBatchMeans (BatchMeans_p bm)
+ *
+ * Description: Frees the batch means.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void destroyBatchMeans (BatchMeans_p bm) {
+	if (bm == NULL)
+		return;
+	free(bm->means);
+	free(bm);
+}
+/************************************************************************************************************
+ * addObservation
+ *
+ * Synopsis: int addObservation (BatchMeans_p bm, double x)
+ *
+ * Description: Adds x to the batch being filled. A batch that is full becomes a mean; if that was the
+ * last one there is room for, neighbouring batches are merged and the batch size doubles, so the batch
+ * being filled next is as long as the merged ones.
+ *
+ * Returns: TRUE if x completed a batch, FALSE otherwise.
+ *
+ ************************************************************************************************************/
+int addObservation (BatchMeans_p bm, double x) {
+	int i;
+
+	kahanAdd(&bm->partial, x);
+	if (bm->partial.n < bm->size)
+		return FALSE;
+	bm->means[bm->batches++] = kahanMean(&bm->partial);
+	kahanInit(&bm->partial);
+	if (bm->batches == bm->limit) {
+		for (i = 0; i < bm->limit / 2; i++)
+			bm->means[i] = (bm->means[2 * i] + bm->means[2 * i + 1]) / 2.0;
+		bm->batches = bm->limit / 2;
+		bm->size *= 2;
+	}
+	return TRUE;
+}
+/************************************************************************************************************
+ * msErrors
+ *
+ * Synopsis: static double msErrors (const double * x, int n, double * mean)
+ *
+ * Description: Sets mean to the mean of x[0..n-1] and adds up the squared deviations from it.
+ *
+ * Returns: The sum of squared deviations.
+ *
+ ************************************************************************************************************/
+static double msErrors (const double * x, int n, double * mean) {
+	double sum = 0.0;
+	double squares = 0.0;
+	int i;
+
+	for (i = 0; i < n; i++)
+		sum += x[i];
+	*mean = sum / n;
+	for (i = 0; i < n; i++)
+		squares += (x[i] - *mean) * (x[i] - *mean);
+	return squares;
+}
+/************************************************************************************************************
+ * estimateBatchMeans
+ *
+ * Synopsis: int estimateBatchMeans (BatchMeans_p bm, BatchEstimate * est)
+ *
+ * Description: Picks the warm-up d by MSER over the full batches, then estimates the mean of the rest,
+ * the half width of its confidence interval and the lag 1 autocorrelation of the batch means. With at
+ * most `limit` batches this is a few thousand operations, cheap enough to run after every batch.
+ *
+ * Returns: The # of batch means the estimate rests on, 0 if too few are left after the warm-up or the
+ * warm-up may not be over yet.
+ *
+ * Adapted from: K. P. White, "An effective truncation heuristic for bias reduction in simulation output,"
+ * Simulation 69(6), 1997.
+ *
+ ************************************************************************************************************/
+int estimateBatchMeans (BatchMeans_p bm, BatchEstimate * est) {
+	const double * x;
+	double best = HUGE_VAL;
+	double mean;
+	double squares;
+	double lagged = 0.0;
+	int n = bm->batches;
+	int warmup = 0;
+	int d;
+	int i;
+
+	for (d = 0; d <= n / 2 && n - d >= BATCH_MEANS_MIN; d++) {
+		squares = msErrors(bm->means + d, n - d, &mean) / ((double) (n - d) * (n - d));
+		if (squares < best) {
+			best = squares;
+			warmup = d;
+		}
+	}
+	// a transient that reaches the last d tried may go on past it: wait for more batches
+	if (best == HUGE_VAL || (warmup > 0 && warmup == d - 1))
+		return 0;
+
+	x = bm->means + warmup;
+	n -= warmup;
+	squares = msErrors(x, n, &mean);
+	for (i = 0; i + 1 < n; i++)
+		lagged += (x[i] - mean) * (x[i + 1] - mean);
+
+	est->mean = mean;
+	est->halfWidth = tQuantile(n - 1) * sqrt(squares / (n - 1) / n);
+	est->lag1 = (squares > 0.0) ? lagged / squares : 0.0;
+	est->warmup = warmup * bm->size;
+	est->batches = n;
+	return n;
+}
+/************************************************************************************************************
+ * isPrecise
+ *
+ * Synopsis: int isPrecise (const BatchEstimate * est, double relative)
+ *
+ * Description: The stopping test: the confidence interval is narrow enough, and the batches are long
+ * enough for their means to be uncorrelated (otherwise the half width is too optimistic).
+ *
+ * Returns: TRUE if the estimate is good to within relative, FALSE otherwise.
+ *
+ ************************************************************************************************************/
+int isPrecise (const BatchEstimate * est, double relative) {
+	return est->halfWidth <= relative * fabs(est->mean) && est->lag1 <= BATCH_MEANS_LAG1;
+}
+/************************************************************************************************************
+ * saveBatchMeans / restoreBatchMeans
+ *
+ * Synopsis: int saveBatchMeans (const BatchMeans * bm, BatchState * state)
+ *
+ * Description: Copy the full batches, the batch size and the batch being filled out of bm and back in. A
+ * restored state has to hold fewer batches than bm keeps, as a saved one always does (a full set is
+ * merged at once).
+ *
+ * Returns: TRUE, or FALSE if the batches do not fit.
+ *
+ ************************************************************************************************************/
+int saveBatchMeans (const BatchMeans * bm, BatchState * state) {
+	if (bm->limit > BATCH_MEANS_LIMIT)
+		return FALSE;
+	memset(state, 0, sizeof(BatchState));
+	memcpy(state->means, bm->means, sizeof(double) * (size_t) bm->batches);
+	state->size = bm->size;
+	state->partial = bm->partial;
+	state->batches = bm->batches;
+	return TRUE;
+}
+
+int restoreBatchMeans (BatchMeans_p bm, const BatchState * state) {
+	if (state->batches < 0 || state->batches >= bm->limit || state->size < 1)
+		return FALSE;
+	memcpy(bm->means, state->means, sizeof(double) * (size_t) state->batches);
+	bm->size = state->size;
+	bm->partial = state->partial;
+	bm->batches = state->batches;
+	return TRUE;
+}
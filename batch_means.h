@@ -0,0 +1,95 @@
+/*
+	batch_means.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Header file for batch means, the online error estimate behind the sequential stopping rule.
+
+	One observation per tick goes into the batch being filled. A full batch is reduced to its mean, so a
+	run of any length keeps at most `limit` numbers: when that many batches are full, neighbouring pairs
+	are merged and the batch size doubles. Batches grow with the run, and so their means become nearly
+	independent even when the observations are strongly correlated from one tick to the next.
+
+	    ticks     |--b1--|--b2--|--b3--| ... |--b64--|       limit reached: pairs merge,
+	    after     |----b1----|----b2----| ... |--b32--|      size doubles, filling goes on
+
+	An estimate first cuts off the initial transient with MSER: the number d of leading batches that
+	minimizes the squared deviations of the remaining ones over (n - d)^2, d at most n / 2. A minimum at
+	the last d tried means the transient may not be over, and there is no estimate yet. The mean of what
+	is left, with a 95% confidence interval from the Student t distribution, is the estimate.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _BATCH_MEANS_H_
+#define _BATCH_MEANS_H_
+
+#include "sim_stats.h"
+
+#define BATCH_MEANS_LIMIT 64	// batches kept before pairs are merged
+#define BATCH_MEANS_MIN 16		// batches an estimate needs after the warm-up is cut off
+#define BATCH_MEANS_LAG1 0.1	// lag 1 autocorrelation of the batch means above which they are not trusted
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct batch_means {
+	double * means;			// the full batches, oldest first
+	int batches;			// # of full batches
+	int limit;				// # of batches kept, even
+	Tick size;				// observations per batch
+	KahanSum partial;		// the batch being filled
+} BatchMeans;
+
+typedef BatchMeans * BatchMeans_p;
+
+typedef struct batch_state {	// batch means of at most BATCH_MEANS_LIMIT batches by value, for checkpoints
+	double means[BATCH_MEANS_LIMIT];
+	Tick size;
+	KahanSum partial;
+	int batches;
+	int reserved;
+} BatchState;
+
+typedef struct batch_estimate {
+	double mean;
+	double halfWidth;		// of the 95% confidence interval of the mean
+	double lag1;			// lag 1 autocorrelation of the batch means used
+	Tick warmup;			// observations cut off as the initial transient
+	int batches;			// # of batch means used
+} BatchEstimate;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+BatchMeans_p createBatchMeans (int limit, Tick size);
+// returns empty batch means keeping at most limit (rounded up to
+// an even number) batches of size observations to start with,
+// NULL if not successful
+
+void destroyBatchMeans (BatchMeans_p bm);
+
+int addObservation (BatchMeans_p bm, double x);
+// returns TRUE if x completed a batch
+
+int estimateBatchMeans (BatchMeans_p bm, BatchEstimate * est);
+// fills est in and returns the # of batch means it rests on,
+// 0 (est untouched) if fewer than BATCH_MEANS_MIN are left after
+// the warm-up, or the warm-up may go on past the batches tried
+
+int isPrecise (const BatchEstimate * est, double relative);
+// returns TRUE if the half width is within relative of the mean
+// and the batch means look uncorrelated
+
+int saveBatchMeans (const BatchMeans * bm, BatchState * state);
+// copies bm into state, FALSE if bm keeps more batches than a
+// state has room for
+
+int restoreBatchMeans (BatchMeans_p bm, const BatchState * state);
+// puts state back into bm, FALSE (bm untouched) if it does not
+// fit the limit of bm
+
+#endif
@@ -0,0 +1,587 @@
+/*
+	c_linkedList.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: c_linkedList.c implements a list of strings shared between threads. Writers lock the nodes
+	around the links they change (see c_linkedList.h) and publish every change to the next links with a
+	release store, so a reader that follows the links with acquire loads always sees complete nodes.
+	Readers take no lock; removed nodes are only freed once no read section that could have reached them
+	is still open.
+
+	A writer only ever reads a link of a node it holds the lock of, and every link that leads to a node
+	is changed under that node's lock or its neighbour's. So the node a writer moves to next cannot be
+	unlinked (let alone freed) while it waits for its lock, and writers need no read sections of their own.
+
+	Memory ordering in short: a reader stores its epoch and then issues a full fence before it loads any
+	link; a writer issues a full fence after unlinking and before it looks at the readers' epochs. So
+	either the writer sees the reader in its section (and waits for it) or the reader sees the node
+	already unlinked.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sched.h>
+
+#include "c_linkedList.h"
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ *	Epoch based reclamation
+ *
+ *+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/************************************************************************************************************
+ * freeNodes
+ *
+ * Synopsis: static void freeNodes (CLNode_p node)
+ *
+ * Description: Frees a chain of retired nodes.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void freeNodes (CLNode_p node) {
+	CLNode_p next;
+
+	while (node != NULL) {
+		next = node->retired;
+		pthread_mutex_destroy(&node->lock);
+		free(node);
+		node = next;
+	}
+}
+/************************************************************************************************************
+ * tryAdvance
+ *
+ * Synopsis: static void tryAdvance (ConcurrentList_p myList)
+ *
+ * Description: Called by a writer holding the limbo lock. If every reader inside a read section has announced
+ * the current epoch e, the epoch moves to e + 1. Nodes retired in e - 1 were unlinked before any of those
+ * readers started, and readers starting from now on cannot find them either, so they are freed.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void tryAdvance (ConcurrentList_p myList) {
+	unsigned long e = atomic_load_explicit(&myList->epoch, memory_order_relaxed);
+	int slots = atomic_load_explicit(&myList->readerSlots, memory_order_acquire);
+	int i;
+
+	atomic_thread_fence(memory_order_seq_cst);
+	for (i = 0; i < slots; i++) {
+		unsigned long state = atomic_load_explicit(&myList->readers[i].state, memory_order_acquire);
+		if ((state & 1) && (state >> 1) != e)
+			return;		// still reading in an older epoch
+	}
+	atomic_store_explicit(&myList->epoch, e + 1, memory_order_release);
+	freeNodes(myList->limbo[(e + 2) % CL_EPOCHS]);	// (e + 2) % 3 == (e - 1) % 3
+	myList->limbo[(e + 2) % CL_EPOCHS] = NULL;
+}
+/************************************************************************************************************
+ * retireNode
+ *
+ * Synopsis: static void retireNode (ConcurrentList_p myList, CLNode_p node)
+ *
+ * Description: Called by a writer right after unlinking node, with the node locks let go: no writer can
+ * reach node any more. The node goes on the limbo list of the current epoch, then the writer tries to
+ * move the epoch on. Writers retiring at once take turns on the limbo lock.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void retireNode (ConcurrentList_p myList, CLNode_p node) {
+	unsigned long e;
+
+	pthread_mutex_lock(&myList->limboLock);
+	atomic_thread_fence(memory_order_seq_cst);	// the unlink is visible before the epoch is read
+	e = atomic_load_explicit(&myList->epoch, memory_order_relaxed);
+	node->retired = myList->limbo[e % CL_EPOCHS];
+	myList->limbo[e % CL_EPOCHS] = node;
+	tryAdvance(myList);
+	pthread_mutex_unlock(&myList->limboLock);
+}
+/************************************************************************************************************
+ * attachReaderCL
+ *
+ * Synopsis: CLReader * attachReaderCL (ConcurrentList_p myList)
+ *
+ * Description: Claims a free reader slot and makes sure writers scan it.
+ *
+ * Returns: The reader handle, NULL if every slot is taken.
+ *
+ ************************************************************************************************************/
+CLReader * attachReaderCL (ConcurrentList_p myList) {
+	int i, expected, slots;
+
+	if (myList == NULL)
+		return NULL;
+	for (i = 0; i < CL_MAX_READERS; i++) {
+		expected = 0;
+		if (atomic_compare_exchange_strong(&myList->readers[i].used, &expected, 1)) {
+			slots = atomic_load(&myList->readerSlots);
+			while (slots < i + 1 && !atomic_compare_exchange_weak(&myList->readerSlots, &slots, i + 1))
+				;
+			return &myList->readers[i];
+		}
+	}
+	return NULL;
+}
+/************************************************************************************************************
+ * detachReaderCL
+ *
+ * Synopsis: void detachReaderCL (CLReader * reader)
+ *
+ * Description: Frees the reader's slot for another thread.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void detachReaderCL (CLReader * reader) {
+	if (reader == NULL)
+		return;
+	atomic_store_explicit(&reader->state, 0, memory_order_release);
+	atomic_store_explicit(&reader->used, 0, memory_order_release);
+}
+/************************************************************************************************************
+ * readBeginCL
+ *
+ * Synopsis: void readBeginCL (CLReader * reader)
+ *
+ * Description: Announces the current epoch in the reader's slot. The fence keeps every later load of a
+ * link after the announcement.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void readBeginCL (CLReader * reader) {
+	unsigned long e = atomic_load_explicit(&reader->list->epoch, memory_order_acquire);
+
+	atomic_store_explicit(&reader->state, (e << 1) | 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+}
+/************************************************************************************************************
+ * readEndCL
+ *
+ * Synopsis: void readEndCL (CLReader * reader)
+ *
+ * Description: Leaves the read section; nodes seen in it may be freed from now on.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void readEndCL (CLReader * reader) {
+	atomic_store_explicit(&reader->state, 0, memory_order_release);
+}
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ *	Concurrent List ADT
+ *
+ *+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/************************************************************************************************************
+ * createNodeCL
+ *
+ * Synopsis: static CLNode_p createNodeCL (const char * data)
+ *
+ * Description: Creates an unlocked node with the string stored right behind the links.
+ *
+ * Returns: A pointer to the new node, NULL if the allocation failed.
+ *
+ ************************************************************************************************************/
+static CLNode_p createNodeCL (const char * data) {
+	size_t length = strlen(data);
+	CLNode_p ret = (CLNode_p) malloc (sizeof(CLNode) + length + 1);
+
+	if (ret == NULL)
+		return NULL;
+	memcpy(ret->data, data, length + 1);
+	atomic_init(&ret->next, NULL);
+	ret->prev = NULL;
+	ret->retired = NULL;
+	pthread_mutex_init(&ret->lock, NULL);
+	return ret;
+}
+/************************************************************************************************************
+ * createListCL
+ *
+ * Synopsis: ConcurrentList_p createListCL (const char * lname)
+ *
+ * Description: Creates an empty list in the heap, the two sentinels linked to each other, with every
+ * reader slot free. The list is aligned to a cache line so the reader slots really sit one per line.
+ *
+ * Returns: A pointer to the new list in the heap, NULL if not successful.
+ *
+ ************************************************************************************************************/
+ConcurrentList_p createListCL (const char * lname) {
+	ConcurrentList_p myList = (ConcurrentList_p) aligned_alloc (CACHE_LINE_SIZE, sizeof(ConcurrentList));
+	int i;
+
+	if (myList == NULL)
+		return NULL;
+	myList->head = createNodeCL("");
+	myList->tail = createNodeCL("");
+	if (myList->head == NULL || myList->tail == NULL) {
+		free(myList->head);
+		free(myList->tail);
+		free(myList);
+		return NULL;
+	}
+	atomic_init(&myList->head->next, myList->tail);
+	myList->tail->prev = myList->head;
+	myList->listName = NULL;
+	if (lname != NULL) {
+		myList->listName = (char *) malloc (sizeof(char) * strlen(lname) + 1);
+		strcpy(myList->listName, lname);
+	}
+	atomic_init(&myList->count, 0);
+	pthread_mutex_init(&myList->limboLock, NULL);
+	for (i = 0; i < CL_EPOCHS; i++)
+		myList->limbo[i] = NULL;
+	atomic_init(&myList->epoch, 0);
+	atomic_init(&myList->readerSlots, 0);
+	for (i = 0; i < CL_MAX_READERS; i++) {
+		atomic_init(&myList->readers[i].state, 0);
+		atomic_init(&myList->readers[i].used, 0);
+		myList->readers[i].list = myList;
+	}
+	return myList;
+}
+/************************************************************************************************************
+ * destroyListCL
+ *
+ * Synopsis: int destroyListCL (ConcurrentList_p myList)
+ *
+ * Description: Frees the nodes still in the list (sentinels included), the nodes waiting in limbo and the
+ * list itself.
+ *
+ * Returns: NO_ERROR if success, else DELETE_ERROR.
+ *
+ ************************************************************************************************************/
+int destroyListCL (ConcurrentList_p myList) {
+	CLNode_p curr, next;
+	int i;
+
+	if (myList == NULL)
+		return DELETE_ERROR;
+	for (curr = myList->head; curr != NULL; curr = next) {
+		next = atomic_load_explicit(&curr->next, memory_order_relaxed);
+		pthread_mutex_destroy(&curr->lock);
+		free(curr);
+	}
+	for (i = 0; i < CL_EPOCHS; i++)
+		freeNodes(myList->limbo[i]);
+	pthread_mutex_destroy(&myList->limboLock);
+	free(myList->listName);
+	free(myList);
+	return NO_ERROR;
+}
+/************************************************************************************************************
+ * lockLastCL
+ *
+ * Synopsis: static CLNode_p lockLastCL (ConcurrentList_p myList)
+ *
+ * Description: Locks the tail sentinel and the node before it (the head sentinel if the list is empty).
+ * That node comes before the tail in the lock order, so it is only tried; if a writer walking towards
+ * the tail holds it, everything is let go and tried again once that writer had a chance to move on.
+ * While the tail is locked, the node before it cannot change.
+ *
+ * Returns: The node before the tail, locked along with the tail.
+ *
+ ************************************************************************************************************/
+static CLNode_p lockLastCL (ConcurrentList_p myList) {
+	CLNode_p last;
+
+	for (;;) {
+		pthread_mutex_lock(&myList->tail->lock);
+		last = myList->tail->prev;
+		if (pthread_mutex_trylock(&last->lock) == 0)
+			return last;
+		pthread_mutex_unlock(&myList->tail->lock);
+		sched_yield();
+	}
+}
+/************************************************************************************************************
+ * appendDataCL
+ *
+ * Synopsis: int appendDataCL (ConcurrentList_p myList, const char * nodeData)
+ *
+ * Description: Links a new node between the last one and the tail, holding the locks of both. The node is
+ * complete before the release store that makes it reachable.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR.
+ *
+ ************************************************************************************************************/
+int appendDataCL (ConcurrentList_p myList, const char * nodeData) {
+	CLNode_p newNode, last;
+
+	if (myList == NULL || nodeData == NULL)
+		return INSERT_ERROR;
+	if ((newNode = createNodeCL(nodeData)) == NULL)
+		return INSERT_ERROR;
+
+	last = lockLastCL(myList);
+	newNode->prev = last;
+	atomic_init(&newNode->next, myList->tail);
+	atomic_store_explicit(&last->next, newNode, memory_order_release);
+	myList->tail->prev = newNode;
+	atomic_fetch_add_explicit(&myList->count, 1, memory_order_relaxed);
+	pthread_mutex_unlock(&last->lock);
+	pthread_mutex_unlock(&myList->tail->lock);
+	return NO_ERROR;
+}
+/************************************************************************************************************
+ * insertDataAtFrontCL
+ *
+ * Synopsis: int insertDataAtFrontCL (ConcurrentList_p myList, const char * nodeData)
+ *
+ * Description: Links a new node between the head and the first node, holding the locks of both.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR.
+ *
+ ************************************************************************************************************/
+int insertDataAtFrontCL (ConcurrentList_p myList, const char * nodeData) {
+	CLNode_p newNode, first;
+
+	if (myList == NULL || nodeData == NULL)
+		return INSERT_ERROR;
+	if ((newNode = createNodeCL(nodeData)) == NULL)
+		return INSERT_ERROR;
+
+	pthread_mutex_lock(&myList->head->lock);
+	first = atomic_load_explicit(&myList->head->next, memory_order_relaxed);
+	pthread_mutex_lock(&first->lock);
+	newNode->prev = myList->head;
+	atomic_init(&newNode->next, first);
+	atomic_store_explicit(&myList->head->next, newNode, memory_order_release);
+	first->prev = newNode;
+	atomic_fetch_add_explicit(&myList->count, 1, memory_order_relaxed);
+	pthread_mutex_unlock(&first->lock);
+	pthread_mutex_unlock(&myList->head->lock);
+	return NO_ERROR;
+}
+/************************************************************************************************************
+ * unlinkNodeCL
+ *
+ * Synopsis: static char * unlinkNodeCL (ConcurrentList_p myList, CLNode_p pred, CLNode_p curr,
+ *                                      CLNode_p succ)
+ *
+ * Description: Called with pred, curr and succ locked, in that order in the list. Bypasses curr and lets
+ * go of the three locks; curr keeps its own next link, so a reader standing on it still finds the rest of
+ * the list. No writer can reach curr from here on, so it is retired.
+ *
+ * Returns: A copy of the node's data in the heap.
+ *
+ ************************************************************************************************************/
+static char * unlinkNodeCL (ConcurrentList_p myList, CLNode_p pred, CLNode_p curr, CLNode_p succ) {
+	char * data = (char *) malloc (sizeof(char) * strlen(curr->data) + 1);
+
+	if (data != NULL)
+		strcpy(data, curr->data);
+	atomic_store_explicit(&pred->next, succ, memory_order_release);
+	succ->prev = pred;
+	atomic_fetch_sub_explicit(&myList->count, 1, memory_order_relaxed);
+	pthread_mutex_unlock(&succ->lock);
+	pthread_mutex_unlock(&curr->lock);
+	pthread_mutex_unlock(&pred->lock);
+	retireNode(myList, curr);
+	return data;
+}
+/************************************************************************************************************
+ * removeDataCL
+ *
+ * Synopsis: char * removeDataCL (ConcurrentList_p myList, const char * searchData)
+ *
+ * Description: Walks the list hand over hand from the head, holding the lock of the node it stands on and
+ * of the one before, and removes the first node holding searchData. Writers further down the list are not
+ * held up until the walk reaches them.
+ *
+ * Returns: A copy of the removed data in the heap, NULL if not found.
+ *
+ ************************************************************************************************************/
+char * removeDataCL (ConcurrentList_p myList, const char * searchData) {
+	CLNode_p pred, curr, succ;
+
+	if (myList == NULL || searchData == NULL)
+		return NULL;
+	pred = myList->head;
+	pthread_mutex_lock(&pred->lock);
+	curr = atomic_load_explicit(&pred->next, memory_order_relaxed);
+	while (curr != myList->tail) {
+		pthread_mutex_lock(&curr->lock);
+		if (!strcmp(curr->data, searchData)) {
+			succ = atomic_load_explicit(&curr->next, memory_order_relaxed);
+			pthread_mutex_lock(&succ->lock);
+			return unlinkNodeCL(myList, pred, curr, succ);
+		}
+		pthread_mutex_unlock(&pred->lock);
+		pred = curr;
+		curr = atomic_load_explicit(&curr->next, memory_order_relaxed);
+	}
+	pthread_mutex_unlock(&pred->lock);
+	return NULL;
+}
+/************************************************************************************************************
+ * removeDataFromHeadCL / removeDataFromTailCL
+ *
+ * Synopsis: char * removeDataFromHeadCL (ConcurrentList_p myList)
+ *
+ * Description: Removes the first (last) node of the list. From the tail the node before the last one is
+ * only tried, like the last one itself in lockLastCL().
+ *
+ * Returns: A copy of the removed data in the heap, NULL if the list is empty.
+ *
+ ************************************************************************************************************/
+char * removeDataFromHeadCL (ConcurrentList_p myList) {
+	CLNode_p first, succ;
+
+	if (myList == NULL)
+		return NULL;
+	pthread_mutex_lock(&myList->head->lock);
+	first = atomic_load_explicit(&myList->head->next, memory_order_relaxed);
+	if (first == myList->tail) {
+		pthread_mutex_unlock(&myList->head->lock);
+		return NULL;
+	}
+	pthread_mutex_lock(&first->lock);
+	succ = atomic_load_explicit(&first->next, memory_order_relaxed);
+	pthread_mutex_lock(&succ->lock);
+	return unlinkNodeCL(myList, myList->head, first, succ);
+}
+
+char * removeDataFromTailCL (ConcurrentList_p myList) {
+	CLNode_p last, pred;
+
+	if (myList == NULL)
+		return NULL;
+	for (;;) {
+		last = lockLastCL(myList);
+		if (last == myList->head) {
+			pthread_mutex_unlock(&last->lock);
+			pthread_mutex_unlock(&myList->tail->lock);
+			return NULL;
+		}
+		pred = last->prev;
+		if (pthread_mutex_trylock(&pred->lock) == 0)
+			break;
+		pthread_mutex_unlock(&last->lock);
+		pthread_mutex_unlock(&myList->tail->lock);
+		sched_yield();
+	}
+	return unlinkNodeCL(myList, pred, last, myList->tail);
+}
+/************************************************************************************************************
+ * findDataCL
+ *
+ * Synopsis: char * findDataCL (CLReader * reader, const char * searchData)
+ *
+ * Description: Follows the links without locking. Must be called inside a read section.
+ *
+ * Returns: The list's copy of searchData (valid until readEndCL), NULL if not found.
+ *
+ ************************************************************************************************************/
+char * findDataCL (CLReader * reader, const char * searchData) {
+	CLNode_p curr;
+
+	if (reader == NULL || searchData == NULL)
+		return NULL;
+	for (curr = atomic_load_explicit(&reader->list->head->next, memory_order_acquire); curr != reader->list->tail;
+			curr = atomic_load_explicit(&curr->next, memory_order_acquire))
+		if (!strcmp(curr->data, searchData))
+			return curr->data;
+	return NULL;
+}
+/************************************************************************************************************
+ * containsDataCL
+ *
+ * Synopsis: int containsDataCL (CLReader * reader, const char * searchData)
+ *
+ * Description: findDataCL in a read section of its own.
+ *
+ * Returns: 1 if searchData is in the list, else 0.
+ *
+ ************************************************************************************************************/
+int containsDataCL (CLReader * reader, const char * searchData) {
+	int found;
+
+	if (reader == NULL)
+		return 0;
+	readBeginCL(reader);
+	found = findDataCL(reader, searchData) != NULL;
+	readEndCL(reader);
+	return found;
+}
+/************************************************************************************************************
+ * forEachCL
+ *
+ * Synopsis: int forEachCL (CLReader * reader, void (*visit)(const char * data, void * arg), void * arg)
+ *
+ * Description: Calls visit on every item inside one read section.
+ *
+ * Returns: The # of items visited.
+ *
+ ************************************************************************************************************/
+int forEachCL (CLReader * reader, void (*visit)(const char * data, void * arg), void * arg) {
+	CLNode_p curr;
+	int n = 0;
+
+	if (reader == NULL || visit == NULL)
+		return 0;
+	readBeginCL(reader);
+	for (curr = atomic_load_explicit(&reader->list->head->next, memory_order_acquire); curr != reader->list->tail;
+			curr = atomic_load_explicit(&curr->next, memory_order_acquire)) {
+		visit(curr->data, arg);
+		n++;
+	}
+	readEndCL(reader);
+	return n;
+}
+/************************************************************************************************************
+ * printItemCL
+ *
+ * Synopsis: static void printItemCL (const char * data, void * arg)
+ *
+ * Description: forEachCL visitor used by printListCL.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void printItemCL (const char * data, void * arg) {
+	fprintf((FILE *) arg, "\nNODE: %s\n", data);
+}
+/************************************************************************************************************
+ * printListCL
+ *
+ * Synopsis: void printListCL (CLReader * reader, FILE * output, int * error)
+ *
+ * Description: Prints the list name and count, then every item, walking the list in one read section.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void printListCL (CLReader * reader, FILE * output, int * error) {
+	if (reader == NULL) {
+		if (error)
+			*error = PRINT_ERROR;
+		return;
+	}
+	if (output == NULL)
+		output = stdout;
+	fprintf(output, "\nList name: %s\nItems in list: %d\n",
+		reader->list->listName ? reader->list->listName : "", sizeListCL(reader->list));
+	forEachCL(reader, printItemCL, output);
+	if (error)
+		*error = ferror(output) ? PRINT_ERROR : NO_ERROR;
+}
+/************************************************************************************************************
+ * sizeListCL
+ *
+ * Synopsis: int sizeListCL (ConcurrentList_p myList)
+ *
+ * Description: Reads the item count.
+ *
+ * Returns: # of items, NOT_FOUND if myList is NULL.
+ *
+ ************************************************************************************************************/
+int sizeListCL (ConcurrentList_p myList) {
+	if (myList == NULL)
+		return NOT_FOUND;
+	return atomic_load_explicit(&myList->count, memory_order_relaxed);
+}
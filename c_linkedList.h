@@ -0,0 +1,144 @@
+/*
+	c_linkedList.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: Header file for the concurrent list ADT.
+
+	c_linkedList.c implements a list of strings that many threads can share: a few writers that add and
+	remove items and any number of readers that search and walk it. Readers never lock and never write to
+	anything shared with other readers, so lookups scale with the number of cores; they only announce in
+	their own cache line which epoch they are reading in.
+
+	Writers lock nodes, not the list. Every node has its own lock, and the list is framed by a head and a
+	tail sentinel that are never removed:
+
+	    head <-> A <-> B <-> C <-> tail
+
+	A writer that changes a link holds the locks of both nodes the link joins, so writers at different
+	places of the list go ahead in parallel. A search for the node to remove walks hand over hand: it
+	locks the next node before it lets go of the one it stands on, so the node it moves to cannot be
+	removed under it. Locks are taken in list order; the operations at the tail, which start from the
+	tail sentinel and need the node before it, only try that lock and start over if it is taken, so
+	two writers never wait for each other in a circle.
+
+	A removed node cannot be freed right away since a reader may still be standing on it. The writer
+	puts it on the limbo list of the current epoch instead, and the epoch only moves on once every reader
+	inside a read section has seen it. Nodes retired two epochs ago can then no longer be reached by
+	anybody and are freed (epoch based reclamation).
+
+	Every thread that reads gets its own CLReader from attachReaderCL(). Data returned by findDataCL()
+	points into the list and is only valid until that reader's readEndCL().
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _C_LINKEDLIST_H_
+#define _C_LINKEDLIST_H_
+
+#include <stdio.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "d_linkedList.h"	// shares the error codes
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+#define CL_MAX_READERS 128	// reader threads attached to one list at a time
+#define CL_EPOCHS 3			// limbo lists: current epoch, previous one, and the one being freed
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct cl_node {
+	_Atomic(struct cl_node *) next;	// followed by readers without a lock, changed under this node's lock
+	struct cl_node * prev;			// writers only, changed under this node's lock
+	struct cl_node * retired;		// link in a limbo list once removed
+	pthread_mutex_t lock;
+	char data[];					// the string, never changed once the node is in the list
+} CLNode;
+
+typedef CLNode * CLNode_p;
+
+typedef struct cl_reader {
+	// one cache line per reader, so announcing an epoch does not disturb the others
+	_Alignas(CACHE_LINE_SIZE) atomic_ulong state;	// (epoch << 1) | 1 inside a read section, 0 outside
+	atomic_int used;								// slot taken by a thread
+	struct concurrent_list * list;
+} CLReader;
+
+typedef struct concurrent_list {
+	char * listName;					// optional name of the list
+	CLNode_p head;						// sentinels: head->next is the first item, tail->prev the
+	CLNode_p tail;						// last; the list is empty when they point at each other
+	atomic_int count;
+
+	pthread_mutex_t limboLock;			// held by a writer retiring a node
+	CLNode_p limbo[CL_EPOCHS];			// removed nodes by the epoch they were removed in
+	_Alignas(CACHE_LINE_SIZE) atomic_ulong epoch;	// global epoch, moved on by writers
+	atomic_int readerSlots;				// slots [0, readerSlots) have ever been used
+	CLReader readers[CL_MAX_READERS];
+} ConcurrentList;
+
+typedef ConcurrentList * ConcurrentList_p;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+ConcurrentList_p createListCL (const char * lname);
+// returns pointer to an empty concurrent list in the heap,
+// NULL if not successful
+
+int destroyListCL (ConcurrentList_p myList);
+// frees every node, removed or not, and the list. No thread
+// may use the list any more. Returns NO_ERROR or DELETE_ERROR
+
+CLReader * attachReaderCL (ConcurrentList_p myList);
+// returns a reader handle for the calling thread, NULL if all
+// CL_MAX_READERS are taken. A handle is used by one thread
+
+void detachReaderCL (CLReader * reader);
+// gives the handle back, outside of a read section
+
+void readBeginCL (CLReader * reader);
+void readEndCL (CLReader * reader);
+// bracket a read section. Nodes seen inside it are not freed
+// before readEndCL. Keep sections short: a reader inside one
+// holds back the freeing of every node removed meanwhile
+
+char * findDataCL (CLReader * reader, const char * searchData);
+// inside a read section: returns the list's copy of searchData,
+// valid until readEndCL, NULL if not found
+
+int containsDataCL (CLReader * reader, const char * searchData);
+// opens its own read section: returns 1 if searchData is in
+// the list, 0 if not
+
+int forEachCL (CLReader * reader, void (*visit)(const char * data, void * arg), void * arg);
+// opens its own read section and calls visit on every item,
+// first to last. Returns the # of items visited. Items added
+// or removed meanwhile may or may not be seen
+
+void printListCL (CLReader * reader, FILE * output, int * error);
+// prints the list name, count and every item like printList.
+// If output == NULL stdout is assumed
+
+int appendDataCL (ConcurrentList_p myList, const char * nodeData);
+int insertDataAtFrontCL (ConcurrentList_p myList, const char * nodeData);
+// copy nodeData into a new node at the end (front) of the
+// list. Return NO_ERROR or INSERT_ERROR
+
+char * removeDataCL (ConcurrentList_p myList, const char * searchData);
+char * removeDataFromHeadCL (ConcurrentList_p myList);
+char * removeDataFromTailCL (ConcurrentList_p myList);
+// remove the first node holding searchData (the first node,
+// the last node) and return a copy of its data in the heap
+// that the caller frees. NULL if there is none
+
+int sizeListCL (ConcurrentList_p myList);
+// returns the # of items, a snapshot if writers are active
+
+#endif
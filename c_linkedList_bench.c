@@ -0,0 +1,175 @@
+/*
+	c_linkedList_bench.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Reader scaling benchmark of the concurrent list (see c_linkedList.h).
+
+	1, 2, 4 ... 64 reader threads look up random items of a list of BENCH_ITEMS for BENCH_SECONDS each,
+	first alone and then with BENCH_WRITERS writers that keep removing the first item and appending it
+	again (so the list keeps its items and its epochs keep moving). The table gives the lookups per second
+	of all readers together and per reader, and the speedup over one reader. Readers take no lock, so the
+	total should grow with the readers up to the # of cores and stay flat beyond it.
+
+	Build: gcc -std=gnu11 -O2 -pthread c_linkedList_bench.c c_linkedList.c -o c_linkedList_bench
+	Execute: c_linkedList_bench [max_readers items seconds]
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "c_linkedList.h"
+
+#define BENCH_READERS 64		// readers at most unless the arguments say
+#define BENCH_ITEMS 1000
+#define BENCH_SECONDS 0.5
+#define BENCH_WRITERS 2
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct bench {
+	ConcurrentList_p list;
+	int items;
+	atomic_int stop;
+	atomic_long lookups;
+	atomic_long writes;
+} Bench;
+
+typedef struct bench_thread {
+	pthread_t thread;
+	Bench * bench;
+	int index;
+} BenchThread;
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * readItems / writeItems
+ *
+ * Synopsis: static void * readItems (void * arg)
+ *
+ * Description: A reader looks up random items (most of them in the list) until told to stop and adds
+ * up how many it did. A writer keeps removing the first item and appending it again.
+ *
+ * Returns: NULL.
+ *
+ ************************************************************************************************************/
+static void * readItems (void * arg) {
+	BenchThread * self = (BenchThread *) arg;
+	Bench * b = self->bench;
+	CLReader * reader = attachReaderCL(b->list);
+	unsigned int seed = (unsigned int) self->index + 1;
+	char item[32];
+	long n = 0;
+
+	if (reader == NULL)
+		return NULL;
+	while (!atomic_load_explicit(&b->stop, memory_order_relaxed)) {
+		snprintf(item, sizeof(item), "item-%d", rand_r(&seed) % b->items);
+		containsDataCL(reader, item);
+		n++;
+	}
+	detachReaderCL(reader);
+	atomic_fetch_add(&b->lookups, n);
+	return NULL;
+}
+
+static void * writeItems (void * arg) {
+	Bench * b = ((BenchThread *) arg)->bench;
+	char * data;
+	long n = 0;
+
+	while (!atomic_load_explicit(&b->stop, memory_order_relaxed)) {
+		data = removeDataFromHeadCL(b->list);
+		if (data == NULL)
+			continue;
+		appendDataCL(b->list, data);
+		free(data);
+		n++;
+	}
+	atomic_fetch_add(&b->writes, n);
+	return NULL;
+}
+/************************************************************************************************************
+ * runBench
+ *
+ * Synopsis: static double runBench (Bench * b, int readers, int writers, double seconds, double * writes)
+ *
+ * Description: Runs readers and writers on the list for seconds.
+ *
+ * Returns: Lookups per second of all readers together; *writes gets the items moved per second.
+ *
+ ************************************************************************************************************/
+static double runBench (Bench * b, int readers, int writers, double seconds, double * writes) {
+	BenchThread threads[CL_MAX_READERS + BENCH_WRITERS];
+	struct timespec pause, start, end;
+	double elapsed;
+	int t;
+
+	atomic_store(&b->stop, 0);
+	atomic_store(&b->lookups, 0);
+	atomic_store(&b->writes, 0);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (t = 0; t < readers + writers; t++) {
+		threads[t].bench = b;
+		threads[t].index = t;
+		pthread_create(&threads[t].thread, NULL, (t < readers) ? readItems : writeItems, &threads[t]);
+	}
+	pause.tv_sec = (time_t) seconds;
+	pause.tv_nsec = (long) ((seconds - (double) pause.tv_sec) * 1e9);
+	nanosleep(&pause, NULL);
+	atomic_store(&b->stop, 1);
+	for (t = 0; t < readers + writers; t++)
+		pthread_join(threads[t].thread, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	elapsed = (double) (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+	*writes = b->writes / elapsed;
+	return b->lookups / elapsed;
+}
+
+int main (int argc, char * argv[]) {
+	int max_readers = (argc > 1) ? atoi(argv[1]) : BENCH_READERS;
+	double seconds = (argc > 3) ? atof(argv[3]) : BENCH_SECONDS;
+	double one = 0, rate, writes;
+	char item[32];
+	Bench b;
+	int readers, writers, i;
+
+	b.items = (argc > 2) ? atoi(argv[2]) : BENCH_ITEMS;
+	if (max_readers < 1 || max_readers > CL_MAX_READERS || b.items < 1 || seconds <= 0) {
+		printf("usage: %s [max_readers (1 .. %d) items seconds]\n", argv[0], CL_MAX_READERS);
+		return 2;
+	}
+	b.list = createListCL("bench");
+	if (b.list == NULL)
+		return 1;
+	for (i = 0; i < b.items; i++) {
+		snprintf(item, sizeof(item), "item-%d", i);
+		appendDataCL(b.list, item);
+	}
+	atomic_init(&b.stop, 0);
+	atomic_init(&b.lookups, 0);
+	atomic_init(&b.writes, 0);
+
+	printf("%d items\nwriters  readers  lookups/s  per reader  speedup  writes/s\n", b.items);
+	for (writers = 0; writers <= BENCH_WRITERS; writers += BENCH_WRITERS)
+		for (readers = 1; readers <= max_readers; readers *= 2) {
+			rate = runBench(&b, readers, writers, seconds, &writes);
+			if (readers == 1)
+				one = rate;
+			printf("%7d  %7d  %9.0f  %10.0f  %6.2fx  %8.0f\n", writers, readers, rate, rate / readers,
+				rate / one, writes);
+		}
+	destroyListCL(b.list);
+	return 0;
+}
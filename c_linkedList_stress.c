@@ -0,0 +1,268 @@
+/*
+	c_linkedList_stress.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Stress test of the concurrent list (see c_linkedList.h), meant to be run under
+	-fsanitize=address (a node freed while a reader stands on it) and -fsanitize=thread (a link changed
+	without the locks that guard it).
+
+	Writers add items of their own at both ends and take items out from the head, the tail and by value,
+	all at once, while readers walk the list, look items up and print it. Every item is "w<writer>-<seq>"
+	and is added once. At the end every item must be either in the list or have been handed back by
+	exactly one remove, the count must match, and the list must read the same forwards (next links)
+	and backwards (prev links).
+
+	Build: gcc -std=gnu11 -O1 -g -fsanitize=thread -pthread c_linkedList_stress.c c_linkedList.c -o c_linkedList_stress
+	   or: gcc -std=gnu11 -O1 -g -fsanitize=address,undefined -pthread c_linkedList_stress.c c_linkedList.c -o ...
+	Execute: c_linkedList_stress [writers readers items_per_writer]
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "c_linkedList.h"
+
+#define STRESS_WRITERS 4
+#define STRESS_READERS 4
+#define STRESS_ITEMS 20000		// items each writer adds unless the arguments say
+#define MAX_WRITERS 32
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct stress {
+	ConcurrentList_p list;
+	int writers;
+	int items;
+	atomic_uchar * removed;		// times item i of writer w was handed back, at w * items + i
+	atomic_int writing;			// writers not done yet
+	atomic_long bad;			// malformed items seen by readers or handed back by removes
+	atomic_long reads;
+} Stress;
+
+typedef struct stress_thread {
+	pthread_t thread;
+	Stress * stress;
+	int index;
+} StressThread;
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * itemIndex
+ *
+ * Synopsis: static long itemIndex (Stress * s, const char * data)
+ *
+ * Description: Parses "w<writer>-<seq>".
+ *
+ * Returns: writer * items + seq, -1 if data is not an item of this run.
+ *
+ ************************************************************************************************************/
+static long itemIndex (Stress * s, const char * data) {
+	int w, i, n = 0;
+
+	if (sscanf(data, "w%d-%d%n", &w, &i, &n) != 2 || data[n] != '\0' || w < 0 || w >= s->writers ||
+			i < 0 || i >= s->items)
+		return -1;
+	return (long) w * s->items + i;
+}
+/************************************************************************************************************
+ * handedBack
+ *
+ * Synopsis: static void handedBack (Stress * s, char * data)
+ *
+ * Description: Counts an item a remove returned (if any) and frees the copy.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void handedBack (Stress * s, char * data) {
+	long k;
+
+	if (data == NULL)
+		return;
+	k = itemIndex(s, data);
+	if (k < 0)
+		atomic_fetch_add(&s->bad, 1);
+	else
+		atomic_fetch_add(&s->removed[k], 1);
+	free(data);
+}
+/************************************************************************************************************
+ * write
+ *
+ * Synopsis: static void * writeItems (void * arg)
+ *
+ * Description: Adds the writer's items, every other one at the front, and after every third one removes
+ * an item: from the head, from the tail, or one of its own added a while ago, in turn.
+ *
+ * Returns: NULL.
+ *
+ ************************************************************************************************************/
+static void * writeItems (void * arg) {
+	StressThread * self = (StressThread *) arg;
+	Stress * s = self->stress;
+	char item[32];
+	int i;
+
+	for (i = 0; i < s->items; i++) {
+		snprintf(item, sizeof(item), "w%d-%d", self->index, i);
+		if (((i % 2) ? insertDataAtFrontCL(s->list, item) : appendDataCL(s->list, item)) != NO_ERROR)
+			atomic_fetch_add(&s->bad, 1);
+		if (i % 3 != 2)
+			continue;
+		switch ((i / 3) % 3) {
+			case 0:
+				handedBack(s, removeDataFromHeadCL(s->list));
+				break;
+			case 1:
+				handedBack(s, removeDataFromTailCL(s->list));
+				break;
+			default:
+				snprintf(item, sizeof(item), "w%d-%d", self->index, i / 2);
+				handedBack(s, removeDataCL(s->list, item));
+		}
+	}
+	atomic_fetch_sub(&s->writing, 1);
+	return NULL;
+}
+/************************************************************************************************************
+ * readItems
+ *
+ * Synopsis: static void * readItems (void * arg)
+ *
+ * Description: While writers are busy: walks the list checking every item, looks up items of random
+ * writers, and now and then prints the list to /dev/null.
+ *
+ * Returns: NULL.
+ *
+ ************************************************************************************************************/
+static void checkItem (const char * data, void * arg) {
+	Stress * s = (Stress *) arg;
+
+	if (itemIndex(s, data) < 0)
+		atomic_fetch_add(&s->bad, 1);
+}
+
+static void * readItems (void * arg) {
+	StressThread * self = (StressThread *) arg;
+	Stress * s = self->stress;
+	CLReader * reader = attachReaderCL(s->list);
+	FILE * devNull = fopen("/dev/null", "w");
+	unsigned int seed = (unsigned int) self->index + 1;
+	char item[32];
+	char * found;
+	long rounds = 0;
+
+	if (reader == NULL) {
+		atomic_fetch_add(&s->bad, 1);
+		return NULL;
+	}
+	while (atomic_load(&s->writing) > 0) {
+		forEachCL(reader, checkItem, s);
+		snprintf(item, sizeof(item), "w%d-%d", rand_r(&seed) % s->writers, rand_r(&seed) % s->items);
+		readBeginCL(reader);
+		found = findDataCL(reader, item);
+		if (found != NULL && strcmp(found, item) != 0)
+			atomic_fetch_add(&s->bad, 1);
+		readEndCL(reader);
+		containsDataCL(reader, item);
+		if (devNull != NULL && ++rounds % 16 == 0)
+			printListCL(reader, devNull, NULL);
+		atomic_fetch_add(&s->reads, 1);
+	}
+	if (devNull != NULL)
+		fclose(devNull);
+	detachReaderCL(reader);
+	return NULL;
+}
+/************************************************************************************************************
+ * checkList
+ *
+ * Synopsis: static long checkList (Stress * s, atomic_uchar * inList)
+ *
+ * Description: Once every thread is done: walks the list forwards counting every item in inList, and
+ * backwards checking that each prev link mirrors a next link.
+ *
+ * Returns: The # of nodes walked forwards, -1 if the links do not agree.
+ *
+ ************************************************************************************************************/
+static long checkList (Stress * s, atomic_uchar * inList) {
+	CLNode_p curr;
+	long n = 0, k;
+
+	for (curr = atomic_load(&s->list->head->next); curr != s->list->tail; curr = atomic_load(&curr->next)) {
+		if (atomic_load(&curr->next)->prev != curr)
+			return -1;
+		k = itemIndex(s, curr->data);
+		if (k < 0)
+			atomic_fetch_add(&s->bad, 1);
+		else
+			inList[k]++;
+		n++;
+	}
+	for (curr = s->list->tail->prev; curr != s->list->head; curr = curr->prev)
+		n--;
+	return (n == 0) ? sizeListCL(s->list) : -1;
+}
+
+int main (int argc, char * argv[]) {
+	StressThread threads[MAX_WRITERS + CL_MAX_READERS];
+	atomic_uchar * inList;
+	Stress s;
+	int readers = (argc == 4) ? atoi(argv[2]) : STRESS_READERS;
+	long lost = 0, twice = 0, n, k;
+	int t, passed;
+
+	s.writers = (argc == 4) ? atoi(argv[1]) : STRESS_WRITERS;
+	s.items = (argc == 4) ? atoi(argv[3]) : STRESS_ITEMS;
+	if ((argc != 1 && argc != 4) || s.writers < 1 || s.writers > MAX_WRITERS || readers < 0 ||
+			readers > CL_MAX_READERS || s.items < 1) {
+		printf("usage: %s [writers (1 .. %d) readers (0 .. %d) items_per_writer]\n", argv[0], MAX_WRITERS,
+			CL_MAX_READERS);
+		return 2;
+	}
+	s.list = createListCL("stress");
+	s.removed = (atomic_uchar *) calloc ((size_t) s.writers * s.items, sizeof(atomic_uchar));
+	inList = (atomic_uchar *) calloc ((size_t) s.writers * s.items, sizeof(atomic_uchar));
+	if (s.list == NULL || s.removed == NULL || inList == NULL) {
+		printf("out of memory\n");
+		return 1;
+	}
+	atomic_init(&s.writing, s.writers);
+	atomic_init(&s.bad, 0);
+	atomic_init(&s.reads, 0);
+
+	for (t = 0; t < s.writers + readers; t++) {
+		threads[t].stress = &s;
+		threads[t].index = (t < s.writers) ? t : t - s.writers;
+		pthread_create(&threads[t].thread, NULL, (t < s.writers) ? writeItems : readItems, &threads[t]);
+	}
+	for (t = 0; t < s.writers + readers; t++)
+		pthread_join(threads[t].thread, NULL);
+
+	n = checkList(&s, inList);
+	for (k = 0; k < (long) s.writers * s.items; k++) {
+		if (s.removed[k] + inList[k] == 0)
+			lost++;
+		else if (s.removed[k] + inList[k] > 1)
+			twice++;
+	}
+	passed = n >= 0 && lost == 0 && twice == 0 && s.bad == 0;
+	printf("%d writers %d readers: %ld items added, %ld left, %ld read rounds; lost %ld duplicated %ld "
+		"malformed %ld%s\n%s\n", s.writers, readers, (long) s.writers * s.items, n, (long) s.reads, lost, twice,
+		(long) s.bad, (n < 0) ? ", links or count do not agree" : "", passed ? "PASSED" : "FAILED");
+	destroyListCL(s.list);
+	free(s.removed);
+	free(inList);
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,625 @@
+/*
+	checkpoint.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Implementation of the checkpoints of the simulator (see checkpoint.h). A base or a delta is
+	built in memory first and goes out with a single write, the checksum (FNV-1a, 64 bits) last.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "checkpoint.h"
+
+#define CHECKPOINT_BYTE_ORDER 0x01020304u
+#define FNV64_OFFSET 0xcbf29ce484222325ull
+#define FNV64_PRIME 0x100000001b3ull
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct checkpoint_header {	// followed by SimConfig and SimScalars
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	int32_t slots;				// # of SlotRecords
+	int32_t queued;				// # of handles in the ready queue
+	int32_t blocked;			// # of handles in the device queues
+	int32_t reserved;
+} CheckpointHeader;
+
+typedef struct delta_header {		// followed by SimScalars
+	uint32_t magic;
+	int32_t blocked;
+	int32_t slots;
+	int32_t queued;
+} DeltaHeader;
+
+typedef struct slot_record {
+	int32_t handle;
+	int32_t live;				// FALSE: the slot was freed
+	Tick id;
+	Tick arrival;
+	Tick run_count;
+	Tick last_ran;
+	Tick burst_left;
+	Tick io_ticks;
+	Tick blocked_at;
+	uint64_t rand_state;
+} SlotRecord;
+
+typedef struct blob {				// growing byte buffer a base or a delta is built in
+	char * data;
+	size_t used;
+	size_t size;
+	int error;
+} Blob;
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * blobPut
+ *
+ * Synopsis: static void blobPut (Blob * b, const void * data, size_t length)
+ *
+ * Description: Appends length bytes to the blob, doubling it when full.
+ *
+ * Returns: Nothing (void), b->error is set if out of memory.
+ *
+ ************************************************************************************************************/
+static void blobPut (Blob * b, const void * data, size_t length) {
+	size_t size = (b->size > 0) ? b->size : 4096;
+	char * grown;
+
+	if (b->error)
+		return;
+	while (size - b->used < length)
+		size *= 2;
+	if (size != b->size) {
+		grown = (char *) realloc (b->data, size);
+		if (grown == NULL) {
+			b->error = 1;
+			return;
+		}
+		b->data = grown;
+		b->size = size;
+	}
+	memcpy(b->data + b->used, data, length);
+	b->used += length;
+}
+/************************************************************************************************************
+ * checksum
+ *
+ * Synopsis: static uint64_t checksum (const char * data, size_t length)
+ *
+ * Description: FNV-1a over length bytes.
+ *
+ * Returns: The 64 bit hash.
+ *
+ ************************************************************************************************************/
+static uint64_t checksum (const char * data, size_t length) {
+	uint64_t hash = FNV64_OFFSET;
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		hash ^= (unsigned char) data[i];
+		hash *= FNV64_PRIME;
+	}
+	return hash;
+}
+/************************************************************************************************************
+ * writeAll
+ *
+ * Synopsis: static int writeAll (int fd, const char * data, size_t length, off_t pos)
+ *
+ * Description: pwrite() of length bytes at pos, retrying short and interrupted writes.
+ *
+ * Returns: 0, or -1 if the write failed.
+ *
+ ************************************************************************************************************/
+static int writeAll (int fd, const char * data, size_t length, off_t pos) {
+	while (length > 0) {
+		ssize_t n = pwrite(fd, data, length, pos);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return -1;
+		data += n;
+		length -= (size_t) n;
+		pos += n;
+	}
+	return 0;
+}
+/************************************************************************************************************
+ * readFile
+ *
+ * Synopsis: static char * readFile (int fd, size_t * length)
+ *
+ * Description: Reads a whole file into the heap.
+ *
+ * Returns: The contents (free() them), NULL if not successful. An empty file gives a valid pointer.
+ *
+ ************************************************************************************************************/
+static char * readFile (int fd, size_t * length) {
+	struct stat st;
+	char * data;
+	size_t done = 0;
+
+	if (fstat(fd, &st) != 0 || (data = (char *) malloc ((size_t) st.st_size + 1)) == NULL)
+		return NULL;
+	while (done < (size_t) st.st_size) {
+		ssize_t n = pread(fd, data + done, (size_t) st.st_size - done, (off_t) done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0) {
+			free(data);
+			return NULL;
+		}
+		done += (size_t) n;
+	}
+	*length = done;
+	return data;
+}
+/************************************************************************************************************
+ * putSlot / putHandles / putScalars
+ *
+ * Synopsis: static void putSlot (Blob * b, ProcessTable_p table, ProcHandle h)
+ *
+ * Description: Appends the record of slot h (live or freed); appends the handles in a list of
+ * PROC_PAYLOAD()s (the ready queue's or a device's) from its head to its tail; appends the scalars, with
+ * the # of processes waiting for each device counted from its queue.
+ *
+ * Returns: Nothing (void); putHandles returns the # of handles.
+ *
+ ************************************************************************************************************/
+static void putSlot (Blob * b, ProcessTable_p table, ProcHandle h) {
+	SlotRecord record;
+
+	memset(&record, 0, sizeof(record));
+	record.handle = h;
+	record.live = isLiveProcess(table, h);
+	if (record.live) {
+		record.id = table->id[h];
+		record.arrival = table->arrival[h];
+		record.run_count = table->run_count[h];
+		record.last_ran = table->last_ran[h];
+		record.burst_left = table->burst_left[h];
+		record.io_ticks = table->io_ticks[h];
+		record.blocked_at = table->blocked_at[h];
+		record.rand_state = table->rand_state[h];
+	}
+	blobPut(b, &record, sizeof(record));
+}
+
+static int32_t putHandles (Blob * b, List_p list) {
+	ListIter iter;
+	char * data;
+	int32_t h;
+	int32_t n = 0;
+
+	listIterBegin(list, &iter);
+	while ((data = listIterNext(&iter)) != NULL) {
+		h = PROC_HANDLE(data);
+		blobPut(b, &h, sizeof(h));
+		n++;
+	}
+	return n;
+}
+
+static void putScalars (Blob * b, const SimScalars * scalars, int devices, List_p * deviceQueues) {
+	SimScalars s = *scalars;
+	int d;
+
+	for (d = 0; d < devices; d++)
+		s.devices[d].queued = sizeList(deviceQueues[d]);
+	blobPut(b, &s, sizeof(s));
+}
+/************************************************************************************************************
+ * openCheckpoint
+ *
+ * Synopsis: Checkpoint_p openCheckpoint (const char * path, const SimConfig * config)
+ *
+ * Description: Allocates the checkpoint and the names of its files.
+ *
+ * Returns: A pointer to the checkpoint in the heap, NULL if not successful.
+ *
+ ************************************************************************************************************/
+Checkpoint_p openCheckpoint (const char * path, const SimConfig * config) {
+	Checkpoint_p cp;
+
+	if (path == NULL || config == NULL || (cp = (Checkpoint_p) calloc (1, sizeof(Checkpoint))) == NULL)
+		return NULL;
+	cp->path = strdup(path);
+	cp->tmpPath = (char *) malloc (strlen(path) + sizeof(".tmp"));
+	cp->journalPath = (char *) malloc (strlen(path) + sizeof(".journal"));
+	if (cp->path == NULL || cp->tmpPath == NULL || cp->journalPath == NULL) {
+		closeCheckpoint(cp);
+		return NULL;
+	}
+	sprintf(cp->tmpPath, "%s.tmp", path);
+	sprintf(cp->journalPath, "%s.journal", path);
+	cp->journal = -1;
+	cp->config = *config;
+	return cp;
+}
+/************************************************************************************************************
+ * closeCheckpoint
+ *
+ * Synopsis: void closeCheckpoint (Checkpoint_p cp)
+ *
+ * Description: Closes the journal and frees the checkpoint; the files stay for a later --resume.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void closeCheckpoint (Checkpoint_p cp) {
+	if (cp == NULL)
+		return;
+	if (cp->journal >= 0)
+		close(cp->journal);
+	free(cp->path);
+	free(cp->tmpPath);
+	free(cp->journalPath);
+	free(cp);
+}
+/************************************************************************************************************
+ * openJournal
+ *
+ * Synopsis: static int openJournal (Checkpoint_p cp)
+ *
+ * Description: Opens (creating) the journal if it is not open yet.
+ *
+ * Returns: 0, or -1 if not successful.
+ *
+ ************************************************************************************************************/
+static int openJournal (Checkpoint_p cp) {
+	if (cp->journal < 0)
+		cp->journal = open(cp->journalPath, O_RDWR | O_CREAT, 0644);
+	return (cp->journal >= 0) ? 0 : -1;
+}
+/************************************************************************************************************
+ * writeBase
+ *
+ * Synopsis: static int writeBase (Checkpoint_p cp, const SimScalars * scalars, ProcessTable_p table,
+ *                                 Queue_p queue, List_p * deviceQueues)
+ *
+ * Description: Builds the base from every live slot, empties the journal, then writes the base to the
+ * temporary file and renames it over the old one. Emptying the journal first means a crash in between
+ * leaves the old base with no deltas: an older checkpoint, but a whole one.
+ *
+ * Returns: 0, or -1 if not successful.
+ *
+ ************************************************************************************************************/
+static int writeBase (Checkpoint_p cp, const SimScalars * scalars, ProcessTable_p table, Queue_p queue,
+		List_p * deviceQueues) {
+	CheckpointHeader header;
+	Blob b = { NULL, 0, 0, 0 };
+	uint64_t sum;
+	int fd, d;
+	int error = 0;
+	ProcHandle h;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+	header.version = CHECKPOINT_VERSION;
+	header.byteOrder = CHECKPOINT_BYTE_ORDER;
+	blobPut(&b, &header, sizeof(header));
+	blobPut(&b, &cp->config, sizeof(SimConfig));
+	putScalars(&b, scalars, cp->config.devices, deviceQueues);
+	for (h = 0; h < table->capacity; h++) {
+		if (isLiveProcess(table, h)) {
+			putSlot(&b, table, h);
+			header.slots++;
+		}
+	}
+	header.queued = putHandles(&b, queue->queue);
+	for (d = 0; d < cp->config.devices; d++)
+		header.blocked += putHandles(&b, deviceQueues[d]);
+	if (!b.error)
+		memcpy(b.data, &header, sizeof(header));
+	sum = b.error ? 0 : checksum(b.data, b.used);
+	blobPut(&b, &sum, sizeof(sum));
+
+	if (b.error || openJournal(cp) != 0 || ftruncate(cp->journal, 0) != 0)
+		error = 1;
+	if (!error) {
+		cp->journalBytes = 0;
+		fd = open(cp->tmpPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0)
+			error = 1;
+		else {
+			if (writeAll(fd, b.data, b.used, 0) != 0 || fsync(fd) != 0)
+				error = 1;
+			if (close(fd) != 0)
+				error = 1;
+			if (!error && rename(cp->tmpPath, cp->path) != 0)
+				error = 1;
+			if (error)
+				unlink(cp->tmpPath);
+		}
+	}
+	if (!error) {
+		cp->baseBytes = (long long) b.used;
+		cp->bases++;
+	}
+	free(b.data);
+	return error ? -1 : 0;
+}
+/************************************************************************************************************
+ * appendDelta
+ *
+ * Synopsis: static int appendDelta (Checkpoint_p cp, const SimScalars * scalars, ProcessTable_p table,
+ *                                   Queue_p queue, List_p * deviceQueues)
+ *
+ * Description: Builds a delta from the dirty slots, one bitmap word at a time, and appends it to the
+ * journal.
+ *
+ * Returns: 0, or -1 if not successful.
+ *
+ ************************************************************************************************************/
+static int appendDelta (Checkpoint_p cp, const SimScalars * scalars, ProcessTable_p table, Queue_p queue,
+		List_p * deviceQueues) {
+	DeltaHeader header;
+	Blob b = { NULL, 0, 0, 0 };
+	uint64_t dirty;
+	uint64_t sum;
+	int error = 0;
+	int w, d;
+
+	memset(&header, 0, sizeof(header));
+	header.magic = CHECKPOINT_DELTA_MAGIC;
+	blobPut(&b, &header, sizeof(header));
+	putScalars(&b, scalars, cp->config.devices, deviceQueues);
+	for (w = 0; w < table->capacity / 64; w++) {
+		for (dirty = table->dirtyMap[w]; dirty != 0; dirty &= dirty - 1) {
+			putSlot(&b, table, w * 64 + __builtin_ctzll(dirty));
+			header.slots++;
+		}
+	}
+	header.queued = putHandles(&b, queue->queue);
+	for (d = 0; d < cp->config.devices; d++)
+		header.blocked += putHandles(&b, deviceQueues[d]);
+	if (!b.error)
+		memcpy(b.data, &header, sizeof(header));
+	sum = b.error ? 0 : checksum(b.data, b.used);
+	blobPut(&b, &sum, sizeof(sum));
+
+	if (b.error || openJournal(cp) != 0 || writeAll(cp->journal, b.data, b.used, (off_t) cp->journalBytes) != 0)
+		error = 1;
+	else
+		cp->journalBytes += (long long) b.used;
+	free(b.data);
+	return error ? -1 : 0;
+}
+/************************************************************************************************************
+ * saveCheckpoint
+ *
+ * Synopsis: int saveCheckpoint (Checkpoint_p cp, const SimScalars * scalars, ProcessTable_p table,
+ *                               Queue_p queue, List_p * deviceQueues)
+ *
+ * Description: Writes a base if there is none yet or the journal has grown past the base, a delta
+ * otherwise, and clears the dirty bits once it is written.
+ *
+ * Returns: CHECKPOINT_OK, or CHECKPOINT_ERROR.
+ *
+ ************************************************************************************************************/
+int saveCheckpoint (Checkpoint_p cp, const SimScalars * scalars, ProcessTable_p table, Queue_p queue,
+		List_p * deviceQueues) {
+	int ret;
+
+	if (cp == NULL || scalars == NULL || table == NULL || queue == NULL ||
+			(cp->config.devices > 0 && deviceQueues == NULL))
+		return CHECKPOINT_ERROR;
+	if (cp->baseBytes == 0 || cp->journalBytes > cp->baseBytes)
+		ret = writeBase(cp, scalars, table, queue, deviceQueues);
+	else
+		ret = appendDelta(cp, scalars, table, queue, deviceQueues);
+	if (ret != 0)
+		return CHECKPOINT_ERROR;
+	clearDirty(table);
+	cp->saves++;
+	return CHECKPOINT_OK;
+}
+/************************************************************************************************************
+ * applySlots
+ *
+ * Synopsis: static int applySlots (ProcessTable_p table, const char * data, int32_t slots)
+ *
+ * Description: Puts saved slot records back in the table: live ones are restored, freed ones freed.
+ *
+ * Returns: 0, or -1 if a record is not valid.
+ *
+ ************************************************************************************************************/
+static int applySlots (ProcessTable_p table, const char * data, int32_t slots) {
+	SlotRecord record;
+	int32_t i;
+
+	for (i = 0; i < slots; i++) {
+		memcpy(&record, data + (size_t) i * sizeof(SlotRecord), sizeof(record));
+		if (record.handle < 0)
+			return -1;
+		if (!record.live)
+			freeProcess(table, record.handle);
+		else if (restoreProcess(table, record.handle, record.id, record.arrival, record.run_count) == NO_PROCESS)
+			return -1;
+		else {
+			table->last_ran[record.handle] = record.last_ran;
+			table->burst_left[record.handle] = record.burst_left;
+			table->io_ticks[record.handle] = record.io_ticks;
+			table->blocked_at[record.handle] = record.blocked_at;
+			table->rand_state[record.handle] = record.rand_state;
+		}
+	}
+	return 0;
+}
+/************************************************************************************************************
+ * applyBase
+ *
+ * Synopsis: static int applyBase (Checkpoint_p cp, const char * base, size_t size, SimScalars * scalars,
+ *                                 ProcessTable_p table, const char ** queued, int32_t * count,
+ *                                 int32_t * blocked)
+ *
+ * Description: Checks the base (magic, version, byte order, sizes, checksum, then the configuration) and
+ * puts its scalars and slots in place. The ready queue is only located, in *queued and *count; the
+ * device queues follow it, *blocked handles in all.
+ *
+ * Returns: CHECKPOINT_OK, CHECKPOINT_MISMATCH or CHECKPOINT_ERROR.
+ *
+ ************************************************************************************************************/
+static int applyBase (Checkpoint_p cp, const char * base, size_t size, SimScalars * scalars,
+		ProcessTable_p table, const char ** queued, int32_t * count, int32_t * blocked) {
+	CheckpointHeader header;
+	SimConfig config;
+	uint64_t sum;
+	size_t pos = sizeof(header) + sizeof(SimConfig) + sizeof(SimScalars);
+
+	if (size < pos + sizeof(sum))
+		return CHECKPOINT_ERROR;
+	memcpy(&header, base, sizeof(header));
+	memcpy(&config, base + sizeof(header), sizeof(config));
+	memcpy(&sum, base + size - sizeof(sum), sizeof(sum));
+	if (memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0 ||
+			header.version != CHECKPOINT_VERSION || header.byteOrder != CHECKPOINT_BYTE_ORDER ||
+			header.slots < 0 || header.queued < 0 || header.blocked < 0 ||
+			size != pos + (size_t) header.slots * sizeof(SlotRecord) +
+				(size_t) (header.queued + header.blocked) * 4 + sizeof(sum) ||
+			sum != checksum(base, size - sizeof(sum)))
+		return CHECKPOINT_ERROR;
+	if (memcmp(&config, &cp->config, sizeof(config)) != 0)
+		return CHECKPOINT_MISMATCH;
+
+	memcpy(scalars, base + sizeof(header) + sizeof(SimConfig), sizeof(SimScalars));
+	if (applySlots(table, base + pos, header.slots) != 0)
+		return CHECKPOINT_ERROR;
+	*queued = base + pos + (size_t) header.slots * sizeof(SlotRecord);
+	*count = header.queued;
+	*blocked = header.blocked;
+	return CHECKPOINT_OK;
+}
+/************************************************************************************************************
+ * applyJournal
+ *
+ * Synopsis: static long long applyJournal (const char * journal, size_t size, SimScalars * scalars,
+ *                                          ProcessTable_p table, const char ** queued, int32_t * count,
+ *                                          int32_t * blocked)
+ *
+ * Description: Applies the deltas in order, stopping at the first one that is cut short or whose
+ * checksum does not hold. *queued, *count and *blocked move to the queues of the last delta applied.
+ *
+ * Returns: The # of bytes of whole deltas, -1 if a whole delta could not be applied.
+ *
+ ************************************************************************************************************/
+static long long applyJournal (const char * journal, size_t size, SimScalars * scalars, ProcessTable_p table,
+		const char ** queued, int32_t * count, int32_t * blocked) {
+	DeltaHeader delta;
+	uint64_t sum;
+	size_t pos = 0;
+	size_t length;
+
+	while (size - pos >= sizeof(delta) + sizeof(SimScalars) + sizeof(sum)) {
+		memcpy(&delta, journal + pos, sizeof(delta));
+		if (delta.magic != CHECKPOINT_DELTA_MAGIC || delta.slots < 0 || delta.queued < 0 || delta.blocked < 0)
+			break;
+		length = sizeof(delta) + sizeof(SimScalars) + (size_t) delta.slots * sizeof(SlotRecord) +
+			(size_t) (delta.queued + delta.blocked) * 4;
+		if (size - pos < length + sizeof(sum))
+			break;
+		memcpy(&sum, journal + pos + length, sizeof(sum));
+		if (sum != checksum(journal + pos, length))
+			break;
+
+		memcpy(scalars, journal + pos + sizeof(delta), sizeof(SimScalars));
+		if (applySlots(table, journal + pos + sizeof(delta) + sizeof(SimScalars), delta.slots) != 0)
+			return -1;
+		*queued = journal + pos + length - (size_t) (delta.queued + delta.blocked) * 4;
+		*count = delta.queued;
+		*blocked = delta.blocked;
+		pos += length + sizeof(sum);
+	}
+	return (long long) pos;
+}
+/************************************************************************************************************
+ * loadCheckpoint
+ *
+ * Synopsis: int loadCheckpoint (Checkpoint_p cp, SimScalars * scalars, ProcessTable_p table, Queue_p queue,
+ *                               List_p * deviceQueues)
+ *
+ * Description: Applies the base and the whole deltas of the journal, cuts the journal after the last
+ * whole delta so new ones follow it, and rebuilds the ready queue and the device queues of the last
+ * record; every handle in them has to be a live process, and the device queues have to hold as many as
+ * the scalars say.
+ *
+ * Returns: CHECKPOINT_OK, CHECKPOINT_NONE, CHECKPOINT_MISMATCH or CHECKPOINT_ERROR.
+ *
+ ************************************************************************************************************/
+int loadCheckpoint (Checkpoint_p cp, SimScalars * scalars, ProcessTable_p table, Queue_p queue,
+		List_p * deviceQueues) {
+	char * base;
+	char * journal = NULL;
+	const char * queued = NULL;
+	size_t baseSize, journalSize = 0;
+	long long whole = -1;
+	int32_t count = 0, blocked = 0, h, i, n;
+	int fd, d;
+	int ret;
+
+	if (cp == NULL || scalars == NULL || table == NULL || queue == NULL ||
+			(cp->config.devices > 0 && deviceQueues == NULL))
+		return CHECKPOINT_ERROR;
+	fd = open(cp->path, O_RDONLY);
+	if (fd < 0)
+		return (errno == ENOENT) ? CHECKPOINT_NONE : CHECKPOINT_ERROR;
+	base = readFile(fd, &baseSize);
+	close(fd);
+	if (base == NULL)
+		return CHECKPOINT_ERROR;
+
+	ret = applyBase(cp, base, baseSize, scalars, table, &queued, &count, &blocked);
+	if (ret == CHECKPOINT_OK) {
+		if (openJournal(cp) == 0 && (journal = readFile(cp->journal, &journalSize)) != NULL)
+			whole = applyJournal(journal, journalSize, scalars, table, &queued, &count, &blocked);
+		if (whole < 0 || ((size_t) whole != journalSize && ftruncate(cp->journal, (off_t) whole) != 0))
+			ret = CHECKPOINT_ERROR;
+	}
+	for (i = 0; ret == CHECKPOINT_OK && i < count; i++) {
+		memcpy(&h, queued + (size_t) i * 4, sizeof(h));
+		if (!isLiveProcess(table, h) || requeuePayload(queue, PROC_PAYLOAD(h)) != NO_ERROR)
+			ret = CHECKPOINT_ERROR;
+	}
+	if (ret == CHECKPOINT_OK)
+		queued += (size_t) count * 4;
+	for (d = 0; ret == CHECKPOINT_OK && d < cp->config.devices; d++) {
+		n = scalars->devices[d].queued;
+		if (n < 0 || n > blocked)
+			ret = CHECKPOINT_ERROR;
+		for (i = 0; ret == CHECKPOINT_OK && i < n; i++) {
+			memcpy(&h, queued + (size_t) i * 4, sizeof(h));
+			if (!isLiveProcess(table, h) || appendPayload(deviceQueues[d], PROC_PAYLOAD(h), NULL) != NO_ERROR)
+				ret = CHECKPOINT_ERROR;
+		}
+		queued += (size_t) n * 4;
+		blocked -= n;
+	}
+	if (ret == CHECKPOINT_OK && blocked != 0)
+		ret = CHECKPOINT_ERROR;
+	if (ret == CHECKPOINT_OK) {
+		cp->baseBytes = (long long) baseSize;
+		cp->journalBytes = whole;
+		clearDirty(table);
+	}
+	free(base);
+	free(journal);
+	return ret;
+}
@@ -0,0 +1,145 @@
+/*
+	checkpoint.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Header file for checkpoints of the simulator.
+
+	A checkpoint is two files: a base holding the whole state, and a journal of deltas appended after it.
+
+	  PATH           CheckpointHeader | config | scalars | live slots | ready queue | device queues | checksum
+	  PATH.journal   delta | delta | ...
+	                 each: DeltaHeader | scalars | dirty slots | ready queue | device queues | checksum
+
+	The base is written to PATH.tmp, flushed to disk and renamed over PATH, so PATH always holds a whole
+	base. Saving a checkpoint normally appends one delta: the scalars, the process table slots that changed
+	since the last checkpoint (their dirty bits), the ready queue and the queues of the --io devices (a few
+	bytes per queued process; how many wait for each device is in the scalars). Once the journal outgrows
+	the base the next save writes a new base and starts an empty journal, so the cost of a checkpoint
+	follows what changed, not the size of the state, and the files stay within twice the size of the state.
+
+	Every delta ends in a checksum. A delta cut short by a crash fails it, and loading stops at the last
+	whole delta: the run resumes from the checkpoint before, and the rest of the journal is cut off.
+	Numbers are stored in the byte order of the machine, a checkpoint is only read back where it was made.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _CHECKPOINT_H_
+#define _CHECKPOINT_H_
+
+#include <stdint.h>
+
+#include "sim_stats.h"
+#include "process_table.h"
+#include "queue.h"
+#include "rand_stream.h"
+#include "batch_means.h"
+
+#define CHECKPOINT_MAGIC "SIMCKPT"
+#define CHECKPOINT_VERSION 9
+#define CHECKPOINT_DEVICES 8		// --io devices a checkpoint has room for
+#define CHECKPOINT_DELTA_MAGIC 0x41544c44u		// "DLTA"
+
+#define CHECKPOINT_OK 0
+#define CHECKPOINT_ERROR -1			// a file could not be read or written, or is damaged
+#define CHECKPOINT_MISMATCH -2		// the checkpoint belongs to a run with another configuration
+#define CHECKPOINT_NONE -3			// there is no checkpoint to resume from
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct sim_config {		// what a resumed run has to agree on (max_ticks may grow)
+	int max_proc;
+	int avg_proc;
+	int mean_times;
+	int time_slice;
+	int admit_policy;
+	int switch_cost;
+	int refill;
+	int devices;				// of --io, 0 .. CHECKPOINT_DEVICES
+	long long seed;
+	double warmth;
+	double burst;
+	double io_service[CHECKPOINT_DEVICES];	// 0 past the last device
+	double precision;			// of --precision, 0 without
+} SimConfig;
+
+typedef struct device_scalars {	// the state of one --io device outside its queue
+	Tick done_at;
+	Tick busy_ticks;
+	Tick completions;
+	Tick response_ticks;
+	ProcHandle serving;
+	int32_t queued;				// # of handles in its queue
+} DeviceScalars;
+
+typedef struct sim_scalars {	// the state of the simulator outside the process table and the queue
+	Tick counter;
+	Tick total_run_count;
+	Tick id;
+	Tick full_ticks;
+	Tick blocked_ticks;
+	Tick overhead_left;			// of the dispatch under way
+	Tick overhead_ticks;
+	Tick switches;
+	Tick slice_end;				// of the running process
+	Tick dropped_ticks;
+	Tick io_blocked_ticks;
+	long long rand_state[RAND_STREAMS];	// of each substream
+	ProcHandle curr_proc;
+	ProcHandle idle_proc;
+	ProcHandle held_proc;
+	int nblocked;				// processes blocked on I/O
+	QueueStats queue;
+	DeviceScalars devices[CHECKPOINT_DEVICES];
+	BatchState in_system;		// the --precision batch means, zeroes without
+	BatchState busy;
+	KahanSum responses;			// of the processes terminated so far
+	TickHistogram response_times;
+} SimScalars;
+
+typedef struct checkpoint {
+	char * path;				// the base
+	char * tmpPath;				// the base while it is written
+	char * journalPath;
+	int journal;				// descriptor of the journal, -1 until the first base is written
+	long long baseBytes;		// size of the current base
+	long long journalBytes;		// size of the journal
+	SimConfig config;
+	long long saves;			// checkpoints written (bases + deltas)
+	long long bases;
+} Checkpoint;
+
+typedef Checkpoint * Checkpoint_p;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+Checkpoint_p openCheckpoint (const char * path, const SimConfig * config);
+// sets up checkpoints at path (and path.journal) for a run with
+// config. Nothing is read or written yet. NULL if not successful
+
+void closeCheckpoint (Checkpoint_p cp);
+
+int saveCheckpoint (Checkpoint_p cp, const SimScalars * scalars, ProcessTable_p table, Queue_p queue,
+	List_p * deviceQueues);
+// writes the state: a delta, or a new base the first time and
+// whenever the journal has outgrown the base. deviceQueues are the
+// config.devices lists of PROC_PAYLOAD() handles blocked on I/O
+// (the queued counts of scalars->devices are filled in from them).
+// The dirty bits of table are cleared. Returns CHECKPOINT_OK or
+// CHECKPOINT_ERROR
+
+int loadCheckpoint (Checkpoint_p cp, SimScalars * scalars, ProcessTable_p table, Queue_p queue,
+	List_p * deviceQueues);
+// reads the base and every whole delta after it into scalars, an
+// empty table, an empty queue and empty device queues (queue
+// statistics are left to the caller, in scalars->queue). Returns
+// CHECKPOINT_OK, CHECKPOINT_NONE, CHECKPOINT_MISMATCH or
+// CHECKPOINT_ERROR
+
+#endif
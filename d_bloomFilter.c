@@ -0,0 +1,215 @@
+/*
+	d_bloomFilter.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: d_bloomFilter.c implements a counting Bloom filter over strings. One 64 bit FNV-1a hash is
+	computed per string and split in two halves; the BLOOM_HASHES counter positions are h1 + i * h2
+	(double hashing), which behaves like independent hash functions for this purpose. Counters are one
+	byte: a counter that reaches BLOOM_SATURATED is never decremented again, since its true value is not
+	known any more, and such removals are counted so the list can rebuild the filter.
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "d_bloomFilter.h"
+
+/************************************************************************************************************
+ * sizeCounters
+ *
+ * Synopsis: static size_t sizeCounters (int capacity)
+ *
+ * Description: Picks the # of counters for capacity items, rounded up to a power of two.
+ *
+ * Returns: The # of counters.
+ *
+ ************************************************************************************************************/
+static size_t sizeCounters (int capacity) {
+	size_t wanted = (size_t) (capacity > 0 ? capacity : 1) * BLOOM_COUNTERS_PER_ITEM;
+	size_t size = BLOOM_MIN_COUNTERS;
+
+	while (size < wanted)
+		size <<= 1;
+	return size;
+}
+/************************************************************************************************************
+ * hashString
+ *
+ * Synopsis: static uint64_t hashString (const char * data)
+ *
+ * Description: 64 bit FNV-1a hash of the string, with a final mix so both halves are usable.
+ *
+ * Returns: The hash.
+ *
+ ************************************************************************************************************/
+static uint64_t hashString (const char * data) {
+	uint64_t h = 14695981039346656037ULL;
+
+	while (*data) {
+		h ^= (unsigned char) *data++;
+		h *= 1099511628211ULL;
+	}
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	return h;
+}
+/************************************************************************************************************
+ * bloomCreate
+ *
+ * Synopsis: BloomFilter * bloomCreate (int capacity)
+ *
+ * Description: Creates an empty filter with BLOOM_COUNTERS_PER_ITEM counters per expected item.
+ *
+ * Returns: A pointer to the filter in the heap, NULL if the allocation failed.
+ *
+ ************************************************************************************************************/
+BloomFilter * bloomCreate (int capacity) {
+	BloomFilter * filter = (BloomFilter *) malloc (sizeof(BloomFilter));
+
+	if (filter == NULL)
+		return NULL;
+	filter->counters = NULL;
+	filter->queries = 0;
+	filter->skipped = 0;
+	filter->falsePositives = 0;
+	filter->rebuilds = 0;
+	bloomClear(filter, capacity);
+	if (filter->counters == NULL) {
+		free(filter);
+		return NULL;
+	}
+	return filter;
+}
+/************************************************************************************************************
+ * bloomDestroy
+ *
+ * Synopsis: void bloomDestroy (BloomFilter * filter)
+ *
+ * Description: Frees the counters and the filter.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void bloomDestroy (BloomFilter * filter) {
+	if (filter == NULL)
+		return;
+	free(filter->counters);
+	free(filter);
+}
+/************************************************************************************************************
+ * bloomClear
+ *
+ * Synopsis: void bloomClear (BloomFilter * filter, int capacity)
+ *
+ * Description: Zeroes the filter, reallocating the counters if capacity calls for a different size. The
+ * query statistics are kept across rebuilds.
+ *
+ * Returns: Nothing (void). On allocation failure the old counters are kept.
+ *
+ ************************************************************************************************************/
+void bloomClear (BloomFilter * filter, int capacity) {
+	size_t size = sizeCounters(capacity);
+
+	if (filter->counters == NULL || size != filter->mask + 1) {
+		unsigned char * counters = (unsigned char *) malloc (size);
+		if (counters != NULL) {
+			free(filter->counters);
+			filter->counters = counters;
+			filter->mask = size - 1;
+		}
+	}
+	if (filter->counters != NULL)
+		memset(filter->counters, 0, filter->mask + 1);
+	filter->capacity = capacity;
+	filter->items = 0;
+	filter->stale = 0;
+}
+/************************************************************************************************************
+ * bloomAdd
+ *
+ * Synopsis: void bloomAdd (BloomFilter * filter, const char * data)
+ *
+ * Description: Bumps the counters of data, leaving saturated counters alone.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void bloomAdd (BloomFilter * filter, const char * data) {
+	uint64_t h = hashString(data);
+	uint32_t h1 = (uint32_t) h, h2 = (uint32_t) (h >> 32) | 1;
+	int i;
+
+	for (i = 0; i < BLOOM_HASHES; i++) {
+		unsigned char * counter = &filter->counters[(h1 + (uint32_t) i * h2) & filter->mask];
+		if (*counter < BLOOM_SATURATED)
+			(*counter)++;
+	}
+	filter->items++;
+}
+/************************************************************************************************************
+ * bloomRemove
+ *
+ * Synopsis: void bloomRemove (BloomFilter * filter, const char * data)
+ *
+ * Description: Drops the counters of data. Saturated counters cannot be dropped, that removal is counted
+ * as stale instead.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void bloomRemove (BloomFilter * filter, const char * data) {
+	uint64_t h = hashString(data);
+	uint32_t h1 = (uint32_t) h, h2 = (uint32_t) (h >> 32) | 1;
+	int i, stuck = 0;
+
+	for (i = 0; i < BLOOM_HASHES; i++) {
+		unsigned char * counter = &filter->counters[(h1 + (uint32_t) i * h2) & filter->mask];
+		if (*counter == BLOOM_SATURATED)
+			stuck = 1;
+		else if (*counter > 0)
+			(*counter)--;
+	}
+	filter->stale += stuck;
+	filter->items--;
+}
+/************************************************************************************************************
+ * bloomMayContain
+ *
+ * Synopsis: int bloomMayContain (BloomFilter * filter, const char * data)
+ *
+ * Description: Checks the counters of data, stopping at the first zero.
+ *
+ * Returns: 0 if data is certainly not in the list, 1 if it may be.
+ *
+ ************************************************************************************************************/
+int bloomMayContain (BloomFilter * filter, const char * data) {
+	uint64_t h = hashString(data);
+	uint32_t h1 = (uint32_t) h, h2 = (uint32_t) (h >> 32) | 1;
+	int i;
+
+	filter->queries++;
+	for (i = 0; i < BLOOM_HASHES; i++) {
+		if (filter->counters[(h1 + (uint32_t) i * h2) & filter->mask] == 0) {
+			filter->skipped++;
+			return 0;
+		}
+	}
+	return 1;
+}
+/************************************************************************************************************
+ * bloomNeedsRebuild
+ *
+ * Synopsis: int bloomNeedsRebuild (BloomFilter * filter)
+ *
+ * Description: The false positive rate climbs quickly once a filter holds more than about twice what it
+ * was sized for, and every removal that hit a saturated counter leaves counters too high for good.
+ *
+ * Returns: 1 if the filter should be rebuilt, 0 otherwise.
+ *
+ ************************************************************************************************************/
+int bloomNeedsRebuild (BloomFilter * filter) {
+	return filter->items > 2 * filter->capacity || (size_t) filter->stale > (filter->mask + 1) / 64;
+}
@@ -0,0 +1,69 @@
+/*
+	d_bloomFilter.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: Header file for the counting Bloom filter that Lists can use to answer misses early.
+
+	The filter keeps an array of small counters. Adding a string bumps BLOOM_HASHES counters picked by
+	hashing it, removing it drops them again. If any of the counters of a string is zero the string is
+	certainly not in the list and the search can stop without touching a node. If all are non-zero the
+	string is probably there and the list is searched as usual.
+
+	These functions are only called by d_linkedList.c, users go through enableListFilter() and friends.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _D_BLOOMFILTER_H_
+#define _D_BLOOMFILTER_H_
+
+#include <stddef.h>
+
+#define BLOOM_HASHES 7				// counters per string, best for ~10 counters per item
+#define BLOOM_COUNTERS_PER_ITEM 10	// ~1% false positives at the expected size
+#define BLOOM_MIN_COUNTERS 64
+#define BLOOM_SATURATED 255			// a counter this high is stuck, it can no longer be decremented
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct bloom_filter {
+	unsigned char * counters;
+	size_t mask;			// # of counters - 1, the # of counters is a power of two
+	int capacity;			// # of items the filter was sized for
+	int items;				// # of items currently added
+	int stale;				// removals that hit a saturated counter since the last rebuild
+	long queries;			// searches that consulted the filter
+	long skipped;			// searches answered "not there" by the filter alone
+	long falsePositives;	// searches the filter let through that then missed
+	long rebuilds;			// # of times the filter was rebuilt
+} BloomFilter;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+BloomFilter * bloomCreate (int capacity);
+// returns an empty filter sized for capacity items, NULL if
+// not successful
+
+void bloomDestroy (BloomFilter * filter);
+
+void bloomClear (BloomFilter * filter, int capacity);
+// empties the filter, resizing it for capacity items; the
+// statistics are kept
+
+void bloomAdd (BloomFilter * filter, const char * data);
+
+void bloomRemove (BloomFilter * filter, const char * data);
+
+int bloomMayContain (BloomFilter * filter, const char * data);
+// returns 0 if data was certainly never added (or was removed
+// again), 1 if it may have been
+
+int bloomNeedsRebuild (BloomFilter * filter);
+// returns 1 once the filter holds far more items than it was
+// sized for, or too many removals could not be counted
+
+#endif
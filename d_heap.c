@@ -0,0 +1,339 @@
+/*
+	d_heap.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: d_heap.c implements the 4-ary heap of handles (see d_heap.h). Entries are moved, not swapped:
+	a sift carries the entry it places in a local and shifts the others over the hole it leaves, so every
+	level costs one write and one update of the position table.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "d_heap.h"
+
+#define AT(heap, i) ((heap)->entries[HEAP_PAD + (i)])
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ *	Heap ADT
+ *
+ *+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/************************************************************************************************************
+ * allocEntries
+ *
+ * Synopsis: static HeapEntry * allocEntries (int capacity)
+ *
+ * Description: Allocates the padding and capacity entries on a cache line boundary (see d_heap.h).
+ *
+ * Returns: A pointer to the entries in the heap, NULL if the allocation failed.
+ *
+ ************************************************************************************************************/
+static HeapEntry * allocEntries (int capacity) {
+	size_t bytes = sizeof(HeapEntry) * (size_t) (HEAP_PAD + capacity);
+
+	return (HeapEntry *) aligned_alloc (HEAP_LINE, (bytes + HEAP_LINE - 1) / HEAP_LINE * HEAP_LINE);
+}
+/************************************************************************************************************
+ * createHeap
+ *
+ * Synopsis: Heap_p createHeap (int capacity)
+ *
+ * Description: Creates an empty heap with room for capacity entries (HEAP_MIN_CAPACITY at the least). The
+ * position table starts empty and grows with the largest item put in.
+ *
+ * Returns: A pointer to the heap in the heap, NULL if the allocation failed.
+ *
+ ************************************************************************************************************/
+Heap_p createHeap (int capacity) {
+	Heap_p heap = (Heap_p) calloc (1, sizeof(Heap));
+
+	if (heap == NULL)
+		return NULL;
+	heap->capacity = (capacity > HEAP_MIN_CAPACITY) ? capacity : HEAP_MIN_CAPACITY;
+	heap->entries = allocEntries(heap->capacity);
+	if (heap->entries == NULL) {
+		free(heap);
+		return NULL;
+	}
+	return heap;
+}
+/************************************************************************************************************
+ * destroyHeap
+ *
+ * Synopsis: void destroyHeap (Heap_p heap)
+ *
+ * Description: Frees the entries, the position table and the heap. The items are plain integers, there is
+ * nothing else to release.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void destroyHeap (Heap_p heap) {
+	if (heap == NULL)
+		return;
+	free(heap->entries);
+	free(heap->position);
+	free(heap);
+}
+/************************************************************************************************************
+ * growEntries
+ *
+ * Synopsis: static int growEntries (Heap_p heap)
+ *
+ * Description: Doubles the room for entries. realloc() does not keep the alignment, so the entries are
+ * copied over to a new block.
+ *
+ * Returns: HEAP_OK, HEAP_ERROR if the heap is left as it was for lack of memory.
+ *
+ ************************************************************************************************************/
+static int growEntries (Heap_p heap) {
+	HeapEntry * entries;
+
+	if (heap->capacity > INT_MAX / 8)		// keeps i * HEAP_ARITY + HEAP_ARITY within an int
+		return HEAP_ERROR;
+	entries = allocEntries(heap->capacity * 2);
+	if (entries == NULL)
+		return HEAP_ERROR;
+	memcpy(entries, heap->entries, sizeof(HeapEntry) * (size_t) (HEAP_PAD + heap->size));
+	free(heap->entries);
+	heap->entries = entries;
+	heap->capacity *= 2;
+	return HEAP_OK;
+}
+/************************************************************************************************************
+ * growPositions
+ *
+ * Synopsis: static int growPositions (Heap_p heap, int item)
+ *
+ * Description: Widens the position table so it covers item, at least doubling it, and marks the new
+ * items as not in the heap.
+ *
+ * Returns: HEAP_OK, HEAP_ERROR if the heap is left as it was for lack of memory.
+ *
+ ************************************************************************************************************/
+static int growPositions (Heap_p heap, int item) {
+	long long items = (heap->items > 0) ? (long long) heap->items * 2 : HEAP_MIN_CAPACITY;
+	int * position;
+	int i;
+
+	if (items <= item)
+		items = (long long) item + 1;
+	if (items > INT_MAX)
+		items = INT_MAX;
+	position = (int *) realloc (heap->position, sizeof(int) * (size_t) items);
+	if (position == NULL)
+		return HEAP_ERROR;
+	for (i = heap->items; i < items; i++)
+		position[i] = NOT_IN_HEAP;
+	heap->position = position;
+	heap->items = (int) items;
+	return HEAP_OK;
+}
+/************************************************************************************************************
+ * before
+ *
+ * Synopsis: static int before (const HeapEntry * a, const HeapEntry * b)
+ *
+ * Description: The order of the heap: lower priority first, then earlier insertion.
+ *
+ * Returns: TRUE (1) if a comes out before b, FALSE (0) if not.
+ *
+ ************************************************************************************************************/
+static int before (const HeapEntry * a, const HeapEntry * b) {
+	return a->priority < b->priority || (a->priority == b->priority && a->seq < b->seq);
+}
+/************************************************************************************************************
+ * siftUp / siftDown
+ *
+ * Synopsis: static void siftUp (Heap_p heap, int i, HeapEntry entry)
+ *
+ * Description: Places entry in the hole at index i, moving it up past the parents it comes before
+ * (siftUp) or down past the best of its children while one comes before it (siftDown).
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void siftUp (Heap_p heap, int i, HeapEntry entry) {
+	int parent;
+
+	while (i > 0) {
+		parent = (i - 1) / HEAP_ARITY;
+		if (!before(&entry, &AT(heap, parent)))
+			break;
+		AT(heap, i) = AT(heap, parent);
+		heap->position[AT(heap, i).item] = i;
+		i = parent;
+	}
+	AT(heap, i) = entry;
+	heap->position[entry.item] = i;
+}
+
+static void siftDown (Heap_p heap, int i, HeapEntry entry) {
+	int first, last, best, c;
+
+	for (;;) {
+		first = i * HEAP_ARITY + 1;
+		if (first >= heap->size)
+			break;
+		last = (first + HEAP_ARITY < heap->size) ? first + HEAP_ARITY : heap->size;
+		best = first;
+		for (c = first + 1; c < last; c++)
+			if (before(&AT(heap, c), &AT(heap, best)))
+				best = c;
+		if (!before(&AT(heap, best), &entry))
+			break;
+		AT(heap, i) = AT(heap, best);
+		heap->position[AT(heap, i).item] = i;
+		i = best;
+	}
+	AT(heap, i) = entry;
+	heap->position[entry.item] = i;
+}
+/************************************************************************************************************
+ * removeAt
+ *
+ * Synopsis: static int removeAt (Heap_p heap, int i)
+ *
+ * Description: Takes the entry at index i out and fills its hole with the last entry, which then moves
+ * up or down to where it belongs.
+ *
+ * Returns: The item removed.
+ *
+ ************************************************************************************************************/
+static int removeAt (Heap_p heap, int i) {
+	int item = AT(heap, i).item;
+	HeapEntry last;
+
+	heap->position[item] = NOT_IN_HEAP;
+	heap->size--;
+	if (i < heap->size) {
+		last = AT(heap, heap->size);
+		if (i > 0 && before(&last, &AT(heap, (i - 1) / HEAP_ARITY)))
+			siftUp(heap, i, last);
+		else
+			siftDown(heap, i, last);
+	}
+	return item;
+}
+/************************************************************************************************************
+ * inHeap
+ *
+ * Synopsis: static int inHeap (Heap_p heap, int item)
+ *
+ * Description: Looks item up in the position table.
+ *
+ * Returns: Its index in the heap, NOT_IN_HEAP if it is not there (or heap is NULL).
+ *
+ ************************************************************************************************************/
+static int inHeap (Heap_p heap, int item) {
+	if (heap == NULL || item < 0 || item >= heap->items)
+		return NOT_IN_HEAP;
+	return heap->position[item];
+}
+/************************************************************************************************************
+ * heapInsert
+ *
+ * Synopsis: int heapInsert (Heap_p heap, int item, int priority)
+ *
+ * Description: Adds item at the next leaf and sifts it up. It is stamped with the next seq, so it comes
+ * out after every item of the same priority that is already in.
+ *
+ * Returns: HEAP_OK, HEAP_ERROR if item is negative or already in, or memory ran out.
+ *
+ ************************************************************************************************************/
+int heapInsert (Heap_p heap, int item, int priority) {
+	HeapEntry entry;
+
+	if (heap == NULL || item < 0)
+		return HEAP_ERROR;
+	if (item >= heap->items && growPositions(heap, item) != HEAP_OK)
+		return HEAP_ERROR;
+	if (heap->position[item] != NOT_IN_HEAP)
+		return HEAP_ERROR;
+	if (heap->size == heap->capacity && growEntries(heap) != HEAP_OK)
+		return HEAP_ERROR;
+	entry.priority = priority;
+	entry.item = item;
+	entry.seq = heap->seq++;
+	siftUp(heap, heap->size++, entry);
+	return HEAP_OK;
+}
+/************************************************************************************************************
+ * heapPeek / heapPop
+ *
+ * Synopsis: int heapPeek (Heap_p heap)
+ *
+ * Description: The item at the root: lowest priority, first in among those. heapPop() removes it as well.
+ *
+ * Returns: The item, HEAP_EMPTY if the heap is empty.
+ *
+ ************************************************************************************************************/
+int heapPeek (Heap_p heap) {
+	return (heap != NULL && heap->size > 0) ? AT(heap, 0).item : HEAP_EMPTY;
+}
+
+int heapPop (Heap_p heap) {
+	return (heap != NULL && heap->size > 0) ? removeAt(heap, 0) : HEAP_EMPTY;
+}
+/************************************************************************************************************
+ * heapDecreaseKey
+ *
+ * Synopsis: int heapDecreaseKey (Heap_p heap, int item, int priority)
+ *
+ * Description: Lowers the priority of item in place and sifts it up. Its seq stays, so among the items of
+ * its new priority it goes where its insertion time puts it.
+ *
+ * Returns: HEAP_OK, HEAP_ERROR if item is not in the heap or priority is above its own.
+ *
+ ************************************************************************************************************/
+int heapDecreaseKey (Heap_p heap, int item, int priority) {
+	int i = inHeap(heap, item);
+
+	if (i == NOT_IN_HEAP || priority > AT(heap, i).priority)
+		return HEAP_ERROR;
+	AT(heap, i).priority = priority;
+	siftUp(heap, i, AT(heap, i));
+	return HEAP_OK;
+}
+/************************************************************************************************************
+ * heapRemove
+ *
+ * Synopsis: int heapRemove (Heap_p heap, int item)
+ *
+ * Description: Takes item out from wherever the position table says it is.
+ *
+ * Returns: HEAP_OK, HEAP_ERROR if item is not in the heap.
+ *
+ ************************************************************************************************************/
+int heapRemove (Heap_p heap, int item) {
+	int i = inHeap(heap, item);
+
+	if (i == NOT_IN_HEAP)
+		return HEAP_ERROR;
+	removeAt(heap, i);
+	return HEAP_OK;
+}
+/************************************************************************************************************
+ * heapPriority
+ *
+ * Synopsis: int heapPriority (Heap_p heap, int item, int * priority)
+ *
+ * Description: Reads the priority of item.
+ *
+ * Returns: HEAP_OK, HEAP_ERROR if item is not in the heap.
+ *
+ ************************************************************************************************************/
+int heapPriority (Heap_p heap, int item, int * priority) {
+	int i = inHeap(heap, item);
+
+	if (i == NOT_IN_HEAP || priority == NULL)
+		return HEAP_ERROR;
+	*priority = AT(heap, i).priority;
+	return HEAP_OK;
+}
+
+int heapSize (Heap_p heap) {
+	return (heap != NULL) ? heap->size : 0;
+}
@@ -0,0 +1,100 @@
+/*
+	d_heap.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: Header file for a priority queue of handles backed by a 4-ary heap.
+
+	A Queue hands its items out in the order they came in; a scheduler that picks by priority would have to
+	scan it for the best one. The heap keeps the best item (lowest priority, then earliest in) at the root
+	and finds the next one in O(log n): every entry is before its four children, so an insert climbs from a
+	new leaf and a removal sinks the last leaf from the root, looking at the children one group at a time.
+
+	             entries (16 bytes each, the array starts 3 entries before a cache line)
+	    line 0   |  -  |  -  |  -  | root|
+	    line 1   |  c1 |  c2 |  c3 |  c4 |          children of the root
+	    line 2   |  children of c1       |          children of entry i sit at 4i+1 .. 4i+4,
+	    line 3   |  children of c2       |          which is always one whole cache line
+	    ...
+
+	With four children a level the heap is half as deep as a binary one, and comparing four children costs
+	one cache miss instead of two.
+
+	Items are small non-negative integers (process handles), stored by value. A position table indexed by
+	the item tells where it sits in the heap, so an item can be reprioritized (decrease-key) or removed
+	without a search. Each item can be in the heap at most once.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _D_HEAP_H_
+#define _D_HEAP_H_
+
+#define HEAP_ARITY 4
+#define HEAP_LINE 64				// bytes per cache line, the entries are aligned to it
+#define HEAP_PAD (HEAP_ARITY - 1)	// entries before the root, so every group of children fills a line
+#define HEAP_MIN_CAPACITY 64		// entries in a new heap at the least
+
+#define HEAP_OK 0
+#define HEAP_ERROR -1
+#define HEAP_EMPTY -1				// returned instead of an item
+#define NOT_IN_HEAP -1				// position of an item that is not in the heap
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct heap_entry {
+	int priority;				// lower comes out first
+	int item;
+	long long seq;				// order of insertion, breaks ties first in first out
+} HeapEntry;
+
+typedef struct heap {
+	HeapEntry * entries;		// HEAP_PAD unused entries, then the heap
+	int size;					// entries in the heap
+	int capacity;				// room for entries in the heap
+	int * position;				// index in the heap of every item, NOT_IN_HEAP if it is not there
+	int items;					// items the position table covers
+	long long seq;				// seq of the next insert
+} Heap;
+
+typedef Heap * Heap_p;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+Heap_p createHeap (int capacity);
+// constructor for an empty heap with room for capacity entries;
+// it grows when more are needed. Returns NULL if not successful
+
+void destroyHeap (Heap_p heap);
+
+int heapInsert (Heap_p heap, int item, int priority);
+// puts item in with priority, behind the items of the same
+// priority already in. Returns HEAP_OK, HEAP_ERROR if item is
+// negative or already in, or the heap could not grow
+
+int heapPeek (Heap_p heap);
+// returns the first item, HEAP_EMPTY if there is none
+
+int heapPop (Heap_p heap);
+// removes the first item and returns it, HEAP_EMPTY if there is none
+
+int heapDecreaseKey (Heap_p heap, int item, int priority);
+// moves item up to priority (lower than or equal to its own),
+// keeping its place among equals. Returns HEAP_OK, HEAP_ERROR if
+// item is not in or the priority is higher
+
+int heapRemove (Heap_p heap, int item);
+// takes item out wherever it is. Returns HEAP_OK, HEAP_ERROR if
+// it is not in
+
+int heapPriority (Heap_p heap, int item, int * priority);
+// stores the priority of item in *priority. Returns HEAP_OK,
+// HEAP_ERROR if it is not in
+
+int heapSize (Heap_p heap);
+// returns the # of items in the heap
+
+#endif
@@ -0,0 +1,211 @@
+/*
+	d_heap_bench.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Benchmark of the heap (see d_heap.h) against a List scanned for the best entry, the only way a
+	priority pick could be made before.
+
+	Both hold n entries with random priorities in 0 .. BENCH_PRIORITIES - 1 and are timed in the hold
+	model: take the best entry out and put it back in with a new priority, so the size stays n. The List
+	holds (priority, seq, item) payloads, scans every node for the lowest priority (the earliest in among
+	equals), unlinks that node and appends the entry again. The heap is also timed on decrease-key of random
+	items. Times are per operation; the List does fewer of them as n grows, since each is a full scan.
+
+	Build: gcc -std=gnu11 -O2 d_heap_bench.c d_heap.c d_linkedList.c d_unrolledList.c d_skipList.c
+	    d_bloomFilter.c d_internTable.c d_listWriter.c -o d_heap_bench
+	Execute: d_heap_bench [n ...]
+	    with no arguments n = 10^3, 10^4, 10^5 and 10^6
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "d_heap.h"
+#include "d_linkedList.h"
+
+#define BENCH_PRIORITIES 1000
+#define BENCH_HEAP_OPS 1000000
+#define BENCH_LIST_VISITS 200000000L	// nodes the List scans visit per n, about
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct list_entry {		// payload of the List
+	int priority;
+	int item;
+	long long seq;
+} ListEntry;
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+static unsigned long long randomState = 88172645463325252ULL;
+
+static unsigned int nextRandom (void) {
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 7;
+	randomState ^= randomState << 17;
+	return (unsigned int) randomState;
+}
+
+static double now (void) {
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+/************************************************************************************************************
+ * listPop
+ *
+ * Synopsis: static ListEntry * listPop (List_p list)
+ *
+ * Description: Scans every node for the entry with the lowest priority, the earliest in among equals, and
+ * unlinks its node. The List has no call to remove a node it already holds, so it is unlinked here.
+ *
+ * Returns: The entry, NULL if the list is empty.
+ *
+ ************************************************************************************************************/
+static ListEntry * listPop (List_p list) {
+	Node_p node, best = list->first;
+	ListEntry * a;
+	ListEntry * b;
+
+	if (best == NULL)
+		return NULL;
+	for (node = best->next; node != NULL; node = node->next) {
+		a = (ListEntry *) node->data;
+		b = (ListEntry *) best->data;
+		if (a->priority < b->priority || (a->priority == b->priority && a->seq < b->seq))
+			best = node;
+	}
+	if (best->prev)
+		best->prev->next = best->next;
+	else
+		list->first = best->next;
+	if (best->next)
+		best->next->prev = best->prev;
+	else
+		list->last = best->prev;
+	list->count--;
+	b = (ListEntry *) best->data;
+	destroyNode(best);
+	return b;
+}
+/************************************************************************************************************
+ * holdHeap / decreaseHeap / holdList
+ *
+ * Synopsis: static double holdHeap (Heap_p heap, int ops)
+ *
+ * Description: holdHeap() pops the best item and inserts it again with a random priority, ops times.
+ * decreaseHeap() lowers the priority of random items by a random amount, in rounds of n; every item gets
+ * a new random priority before each round (not timed), or the priorities would all end up at 0 and the
+ * decrease-keys would have nothing to do. holdList() does what holdHeap() does on the List.
+ *
+ * Returns: The time per operation in nanoseconds.
+ *
+ ************************************************************************************************************/
+static long sink;				// keeps the results
+
+static double holdHeap (Heap_p heap, int ops) {
+	double t = now();
+	int i, item;
+
+	for (i = 0; i < ops; i++) {
+		item = heapPop(heap);
+		sink += item;
+		heapInsert(heap, item, (int) (nextRandom() % BENCH_PRIORITIES));
+	}
+	return (now() - t) * 1e9 / ops;
+}
+
+static double decreaseHeap (Heap_p heap, int n, int ops) {
+	double total = 0, t;
+	int done, i, item, priority;
+
+	for (done = 0; done < ops; done += n) {
+		for (item = 0; item < n; item++) {
+			heapRemove(heap, item);
+			heapInsert(heap, item, (int) (nextRandom() % BENCH_PRIORITIES));
+		}
+		t = now();
+		for (i = 0; i < n; i++) {
+			item = (int) (nextRandom() % (unsigned int) n);
+			if (heapPriority(heap, item, &priority) == HEAP_OK && priority > 0)
+				heapDecreaseKey(heap, item, priority - 1 - (int) (nextRandom() % (unsigned int) priority));
+		}
+		total += now() - t;
+	}
+	return total * 1e9 / done;
+}
+
+static double holdList (List_p list, long long * seq, int ops) {
+	double t = now();
+	ListEntry * entry;
+	int i;
+
+	for (i = 0; i < ops; i++) {
+		entry = listPop(list);
+		sink += entry->item;
+		entry->priority = (int) (nextRandom() % BENCH_PRIORITIES);
+		entry->seq = (*seq)++;
+		appendPayload(list, entry, NULL);
+	}
+	return (now() - t) * 1e9 / ops;
+}
+
+int main (int argc, char * argv[]) {
+	static const int sizes[] = { 1000, 10000, 100000, 1000000 };
+	double hold, decrease, scan;
+	ListEntry * entries;
+	long long seq;
+	Heap_p heap;
+	List_p list;
+	int a, i, n, listOps;
+
+	printf("%8s  %17s  %16s  %17s  %8s\n", "n", "heap pop+insert", "heap decrease", "List scan+append",
+		"speedup");
+	for (a = 1; a < argc || (argc == 1 && a <= 4); a++) {
+		n = (argc > 1) ? atoi(argv[a]) : sizes[a - 1];
+		if (n < 1) {
+			printf("usage: %s [n ...]\n", argv[0]);
+			return 2;
+		}
+		heap = createHeap(n);
+		list = createList("bench");
+		entries = (ListEntry *) malloc (sizeof(ListEntry) * (size_t) n);
+		if (heap == NULL || list == NULL || entries == NULL) {
+			printf("out of memory for %d entries\n", n);
+			return 1;
+		}
+		for (seq = 0, i = 0; i < n; i++) {
+			entries[i].priority = (int) (nextRandom() % BENCH_PRIORITIES);
+			entries[i].item = i;
+			entries[i].seq = seq++;
+			if (heapInsert(heap, i, entries[i].priority) != HEAP_OK ||
+					appendPayload(list, &entries[i], NULL) != NO_ERROR) {
+				printf("out of memory for %d entries\n", n);
+				return 1;
+			}
+		}
+		listOps = (int) (BENCH_LIST_VISITS / n);
+		if (listOps > BENCH_HEAP_OPS)
+			listOps = BENCH_HEAP_OPS;
+
+		hold = holdHeap(heap, BENCH_HEAP_OPS);
+		decrease = decreaseHeap(heap, n, BENCH_HEAP_OPS);
+		scan = holdList(list, &seq, listOps);
+		printf("%8d  %14.1f ns  %13.1f ns  %14.1f ns  %7.0fx\n", n, hold, decrease, scan, scan / hold);
+
+		destroyHeap(heap);
+		destroyList(list);
+		free(entries);
+	}
+	return (sink == 42) ? 1 : 0;
+}
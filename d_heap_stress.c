@@ -0,0 +1,154 @@
+/*
+	d_heap_stress.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Brute force check of the heap (see d_heap.h) against a reference that scans for the best item.
+
+	STRESS_OPS random operations on items 0 .. STRESS_ITEMS - 1: inserts (of items already in as well),
+	pops, decrease-keys (to higher priorities as well) and removes (of items not in as well). Priorities
+	come from a small range so most of them tie and the first in first out order among equals is checked
+	too. The reference keeps every item's priority and insertion order in an array and finds the best item
+	by scanning all of them; after every operation the heap must have answered what the reference says.
+
+	Build: gcc -std=gnu11 -O2 d_heap_stress.c d_heap.c -o d_heap_stress
+	   or: gcc -std=gnu11 -O1 -g -fsanitize=address,undefined d_heap_stress.c d_heap.c -o d_heap_stress
+	Execute: d_heap_stress [operations items]
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "d_heap.h"
+
+#define STRESS_OPS 400000
+#define STRESS_ITEMS 2000
+#define STRESS_PRIORITIES 50
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct reference {		// what the heap should hold for one item
+	int in;
+	int priority;
+	long long seq;
+} Reference;
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * nextRandom
+ *
+ * Synopsis: static unsigned int nextRandom (void)
+ *
+ * Description: xorshift64, so a run does the same operations on every C library.
+ *
+ * Returns: The next 32 random bits.
+ *
+ ************************************************************************************************************/
+static unsigned long long randomState = 88172645463325252ULL;
+
+static unsigned int nextRandom (void) {
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 7;
+	randomState ^= randomState << 17;
+	return (unsigned int) randomState;
+}
+/************************************************************************************************************
+ * bestItem
+ *
+ * Synopsis: static int bestItem (Reference * ref, int items)
+ *
+ * Description: Scans the reference for the item with the lowest priority, the earliest in among equals.
+ *
+ * Returns: The item, HEAP_EMPTY if none is in.
+ *
+ ************************************************************************************************************/
+static int bestItem (Reference * ref, int items) {
+	int best = HEAP_EMPTY, i;
+
+	for (i = 0; i < items; i++)
+		if (ref[i].in && (best == HEAP_EMPTY || ref[i].priority < ref[best].priority ||
+				(ref[i].priority == ref[best].priority && ref[i].seq < ref[best].seq)))
+			best = i;
+	return best;
+}
+
+int main (int argc, char * argv[]) {
+	long ops = (argc == 3) ? atol(argv[1]) : STRESS_OPS;
+	int items = (argc == 3) ? atoi(argv[2]) : STRESS_ITEMS;
+	long long seq = 0;
+	long op, counts[4] = { 0 };
+	Reference * ref;
+	Heap_p heap;
+	int item, priority, expected, got, size = 0;
+
+	if ((argc != 1 && argc != 3) || ops < 1 || items < 1) {
+		printf("usage: %s [operations items]\n", argv[0]);
+		return 2;
+	}
+	ref = (Reference *) calloc ((size_t) items, sizeof(Reference));
+	heap = createHeap(0);
+	if (ref == NULL || heap == NULL) {
+		printf("out of memory\n");
+		return 1;
+	}
+
+	for (op = 0; op < ops; op++) {
+		item = (int) (nextRandom() % (unsigned int) items);
+		priority = (int) (nextRandom() % STRESS_PRIORITIES);
+		switch (nextRandom() % 8) {
+			case 0: case 1: case 2:		// insert
+				got = heapInsert(heap, item, priority);
+				expected = ref[item].in ? HEAP_ERROR : HEAP_OK;
+				if (got == HEAP_OK && !ref[item].in) {
+					ref[item].in = 1;
+					ref[item].priority = priority;
+					ref[item].seq = seq++;
+					size++;
+				}
+				counts[0]++;
+				break;
+			case 3: case 4:				// pop
+				expected = bestItem(ref, items);
+				got = heapPop(heap);
+				if (expected != HEAP_EMPTY) {
+					ref[expected].in = 0;
+					size--;
+				}
+				counts[1]++;
+				break;
+			case 5: case 6:				// decrease-key, refused when the priority is higher
+				got = heapDecreaseKey(heap, item, priority);
+				expected = (ref[item].in && priority <= ref[item].priority) ? HEAP_OK : HEAP_ERROR;
+				if (expected == HEAP_OK)
+					ref[item].priority = priority;
+				counts[2]++;
+				break;
+			default:					// remove
+				got = heapRemove(heap, item);
+				expected = ref[item].in ? HEAP_OK : HEAP_ERROR;
+				if (ref[item].in) {
+					ref[item].in = 0;
+					size--;
+				}
+				counts[3]++;
+		}
+		if (got != expected || heapSize(heap) != size || heapPeek(heap) != bestItem(ref, items)) {
+			printf("operation %ld: heap answered %d, expected %d, %d items in (expected %d)\nFAILED\n", op, got,
+				expected, heapSize(heap), size);
+			return 1;
+		}
+	}
+	printf("%ld operations on %d items: %ld inserts, %ld pops, %ld decrease-keys, %ld removes, %d left\nPASSED\n",
+		ops, items, counts[0], counts[1], counts[2], counts[3], size);
+	destroyHeap(heap);
+	free(ref);
+	return 0;
+}
@@ -0,0 +1,242 @@
+/*
+	d_internTable.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: d_internTable.c implements a chained hash table of reference counted strings. The string is
+	stored at the end of its entry, so from the pointer a list holds the entry (and through it the table)
+	is found with offsetof() and internRelease() needs nothing else. The table doubles its buckets when
+	it holds more entries than buckets.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "d_internTable.h"
+
+/************************************************************************************************************
+ * hashString
+ *
+ * Synopsis: static unsigned int hashString (const char * data, size_t * length)
+ *
+ * Description: 32 bit FNV-1a hash of the string; also measures it.
+ *
+ * Returns: The hash, with the length of data in length.
+ *
+ ************************************************************************************************************/
+static unsigned int hashString (const char * data, size_t * length) {
+	unsigned int h = 2166136261u;
+	const char * p = data;
+
+	while (*p) {
+		h ^= (unsigned char) *p++;
+		h *= 16777619u;
+	}
+	*length = (size_t) (p - data);
+	return h;
+}
+/************************************************************************************************************
+ * entryOf
+ *
+ * Synopsis: static InternEntry * entryOf (void * data)
+ *
+ * Description: Goes from an interned string back to the entry it is stored in.
+ *
+ * Returns: The entry.
+ *
+ ************************************************************************************************************/
+static InternEntry * entryOf (void * data) {
+	return (InternEntry *) ((char *) data - offsetof(InternEntry, data));
+}
+/************************************************************************************************************
+ * createInternTable
+ *
+ * Synopsis: InternTable * createInternTable (int expected)
+ *
+ * Description: Creates an empty table with about one bucket per expected distinct string.
+ *
+ * Returns: A pointer to the table in the heap, NULL if the allocation failed.
+ *
+ ************************************************************************************************************/
+InternTable * createInternTable (int expected) {
+	InternTable * table = (InternTable *) malloc (sizeof(InternTable));
+	size_t size = INTERN_MIN_BUCKETS;
+
+	if (table == NULL)
+		return NULL;
+	while (size < (size_t) (expected > 0 ? expected : 1))
+		size <<= 1;
+	table->buckets = (InternEntry **) calloc (size, sizeof(InternEntry *));
+	if (table->buckets == NULL) {
+		free(table);
+		return NULL;
+	}
+	table->mask = size - 1;
+	table->entries = 0;
+	table->refs = 0;
+	table->bytesSaved = 0;
+	return table;
+}
+/************************************************************************************************************
+ * destroyInternTable
+ *
+ * Synopsis: void destroyInternTable (InternTable * table)
+ *
+ * Description: Frees every entry, whatever its reference count, and the table itself.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void destroyInternTable (InternTable * table) {
+	InternEntry * curr, * next;
+	size_t i;
+
+	if (table == NULL)
+		return;
+	for (i = 0; i <= table->mask; i++) {
+		for (curr = table->buckets[i]; curr != NULL; curr = next) {
+			next = curr->next;
+			free(curr);
+		}
+	}
+	free(table->buckets);
+	free(table);
+}
+/************************************************************************************************************
+ * growTable
+ *
+ * Synopsis: static void growTable (InternTable * table)
+ *
+ * Description: Doubles the # of buckets and moves every entry to its new bucket using the stored hash.
+ *
+ * Returns: Nothing (void). If the allocation fails the table keeps its old buckets.
+ *
+ ************************************************************************************************************/
+static void growTable (InternTable * table) {
+	size_t size = (table->mask + 1) * 2;
+	InternEntry ** buckets = (InternEntry **) calloc (size, sizeof(InternEntry *));
+	InternEntry * curr, * next;
+	size_t i;
+
+	if (buckets == NULL)
+		return;
+	for (i = 0; i <= table->mask; i++) {
+		for (curr = table->buckets[i]; curr != NULL; curr = next) {
+			next = curr->next;
+			curr->next = buckets[curr->hash & (size - 1)];
+			buckets[curr->hash & (size - 1)] = curr;
+		}
+	}
+	free(table->buckets);
+	table->buckets = buckets;
+	table->mask = size - 1;
+}
+/************************************************************************************************************
+ * findEntry
+ *
+ * Synopsis: static InternEntry * findEntry (InternTable * table, const char * data, unsigned int hash,
+ *                                           size_t length)
+ *
+ * Description: Searches the bucket of hash for data.
+ *
+ * Returns: The entry holding data, NULL if there is none.
+ *
+ ************************************************************************************************************/
+static InternEntry * findEntry (InternTable * table, const char * data, unsigned int hash, size_t length) {
+	InternEntry * curr;
+
+	for (curr = table->buckets[hash & table->mask]; curr != NULL; curr = curr->next)
+		if (curr->hash == hash && curr->length == length && !memcmp(curr->data, data, length))
+			return curr;
+	return NULL;
+}
+/************************************************************************************************************
+ * internString
+ *
+ * Synopsis: char * internString (InternTable * table, const char * data)
+ *
+ * Description: Returns the existing copy of data with one more reference, or adds a new entry for it.
+ *
+ * Returns: The table's copy of data, NULL if the allocation failed.
+ *
+ ************************************************************************************************************/
+char * internString (InternTable * table, const char * data) {
+	size_t length;
+	unsigned int hash = hashString(data, &length);
+	InternEntry * entry = findEntry(table, data, hash, length);
+
+	if (entry != NULL) {
+		entry->refs++;
+		table->refs++;
+		table->bytesSaved += (long) length + 1;
+		return entry->data;
+	}
+
+	entry = (InternEntry *) malloc (sizeof(InternEntry) + length + 1);
+	if (entry == NULL)
+		return NULL;
+	memcpy(entry->data, data, length + 1);
+	entry->table = table;
+	entry->hash = hash;
+	entry->length = length;
+	entry->refs = 1;
+	entry->next = table->buckets[hash & table->mask];
+	table->buckets[hash & table->mask] = entry;
+	table->entries++;
+	table->refs++;
+	if ((size_t) table->entries > table->mask + 1)
+		growTable(table);
+	return entry->data;
+}
+/************************************************************************************************************
+ * internLookup
+ *
+ * Synopsis: char * internLookup (InternTable * table, const char * data)
+ *
+ * Description: Searches the table for data without touching its reference count.
+ *
+ * Returns: The table's copy of data, NULL if it is not in the table.
+ *
+ ************************************************************************************************************/
+char * internLookup (InternTable * table, const char * data) {
+	size_t length;
+	unsigned int hash = hashString(data, &length);
+	InternEntry * entry = findEntry(table, data, hash, length);
+
+	return (entry != NULL) ? entry->data : NULL;
+}
+/************************************************************************************************************
+ * internRelease
+ *
+ * Synopsis: void internRelease (void * data)
+ *
+ * Description: Drops one reference to an interned string; the last one unlinks the entry from its bucket
+ * and frees it.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void internRelease (void * data) {
+	InternEntry * entry, ** link;
+	InternTable * table;
+
+	if (data == NULL)
+		return;
+	entry = entryOf(data);
+	table = entry->table;
+	table->refs--;
+	if (--entry->refs > 0) {
+		table->bytesSaved -= (long) entry->length + 1;
+		return;
+	}
+	for (link = &table->buckets[entry->hash & table->mask]; *link != NULL; link = &(*link)->next) {
+		if (*link == entry) {
+			*link = entry->next;
+			break;
+		}
+	}
+	table->entries--;
+	free(entry);
+}
@@ -0,0 +1,69 @@
+/*
+	d_internTable.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: Header file for d_internTable.c
+
+	d_internTable.c implements a table of interned strings: every distinct string is stored once, with a
+	count of how many list items refer to it. Lists that share a table (see setListInternTable()) store
+	the pointer handed out by the table instead of their own copy, so a file with the same host or job name
+	on a million lines keeps one copy of it, and two interned strings are equal exactly when their
+	pointers are.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _D_INTERNTABLE_H_
+#define _D_INTERNTABLE_H_
+
+#include <stddef.h>
+
+#define INTERN_MIN_BUCKETS 64
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct intern_entry {
+	struct intern_entry * next;	// next entry in the same bucket
+	struct intern_table * table;	// table the entry belongs to, so a bare string can be released
+	unsigned int hash;
+	int refs;					// # of list items using the string
+	size_t length;
+	char data[];				// the string itself
+} InternEntry;
+
+typedef struct intern_table {
+	InternEntry ** buckets;
+	size_t mask;				// # of buckets - 1, the # of buckets is a power of two
+	long entries;				// # of distinct strings
+	long refs;					// # of references handed out
+	long bytesSaved;			// bytes not allocated thanks to sharing
+} InternTable;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+InternTable * createInternTable (int expected);
+// returns an empty table sized for about expected distinct
+// strings, NULL if not successful
+
+void destroyInternTable (InternTable * table);
+// frees the table and every string in it. Destroy the lists
+// using the table first
+
+char * internString (InternTable * table, const char * data);
+// returns the table's copy of data (creating it if needed)
+// and counts one more reference to it. NULL if out of memory
+
+char * internLookup (InternTable * table, const char * data);
+// returns the table's copy of data without counting a
+// reference, NULL if data was never interned (or released)
+
+void internRelease (void * data);
+// gives back one reference to a string returned by
+// internString, freeing it with the last one.
+// Usable as the DataDestructor of a node
+
+#endif
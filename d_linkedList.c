@@ -13,6 +13,11 @@
 #include <string.h>
 
 #include "d_linkedList.h"
+#include "d_unrolledList.h"
+#include "d_skipList.h"
+#include "d_bloomFilter.h"
+#include "d_internTable.h"
+#include "d_listWriter.h"
 
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
  *	Node ADT
@@ -24,73 +29,178 @@
  * Synopsis: Node_p createNode (const char * data)
  *
  * Description: Creates a new Node object in the heap. If actual data was passed to this function (data
- * is non-NULL, then a string is allocated in the heap and the data is copied into it. Pointers to next and
- * prior are initialized to NULL.
+ * is non-NULL, then the data is copied into the node. A string shorter than NODE_INLINE_DATA is stored
+ * right behind the links in the same allocation, so reading it does not chase another pointer; longer
+ * strings get their own block in the heap. Pointers to next and prior are initialized to NULL.
  *
  * Returns: A pointer to the new node in the heap.
  *
  ************************************************************************************************************/
 Node_p createNode (const char * data) {
-	Node_p ret = (Node_p) malloc (sizeof(Node));
+	size_t length = (data != NULL) ? strlen(data) : 0;
+	Node_p ret;
 
-	if (data != NULL) {
-		ret->data = (char *) malloc(sizeof(char) * strlen(data)+1);
-		strcpy(ret->data, data);
+	if (data != NULL && length < NODE_INLINE_DATA) {
+		ret = (Node_p) malloc (sizeof(Node) + sizeof(char) * length + 1);
+		if (ret == NULL)
+			return NULL;
+		ret->data = ret->inlineData;
+		memcpy(ret->data, data, length + 1);
+		ret->destroy = NULL;	// goes away with the node
+	} else {
+		ret = (Node_p) malloc (sizeof(Node));
+		if (ret == NULL)
+			return NULL;
+		ret->data = NULL;
+		if (data != NULL) {
+			ret->data = (char *) malloc(sizeof(char) * length + 1);
+			memcpy(ret->data, data, length + 1);
+		}
+		ret->destroy = free;
 	}
 	ret->next = NULL;	// make certain new node pointers are initialized to NULL
 	ret->prev = NULL;
 	return ret;
 }
 /************************************************************************************************************
- * toStringNode
+ * createNodeAdopt
  *
- * Synopsis: char * toStringNode(Node_p myNode, char * buff)
+ * Synopsis: Node_p createNodeAdopt (char * data, DataDestructor destroy)
  *
- * Description: If node is a valid pointer the function creates a string representing the contents of the
- * node along with indicators of its prior and next pointer statuses. The string is built in the buff characters
- * array and the calling function needs to ensure the size of that buffer wherever it is allocated.
+ * Description: Creates a new Node object in the heap that points at the caller's data instead of a copy
+ * of it. The node takes over the data and releases it with destroy when it is destroyed; a NULL destroy
+ * leaves the data alone. Pointers to next and prior are initialized to NULL.
  *
- * Returns: A pointer to the string representation of the node.
+ * Returns: A pointer to the new node in the heap, NULL if the allocation failed.
  *
  ************************************************************************************************************/
-char* toStringNode (Node_p myNode, char * buff) {
-	if (myNode == NULL) return NULL;
-	if (buff == NULL) return NULL;
+Node_p createNodeAdopt (char * data, DataDestructor destroy) {
+	Node_p ret = (Node_p) malloc (sizeof(Node));
 
+	if (ret == NULL)
+		return NULL;
+	ret->data = data;
+	ret->destroy = destroy;
+	ret->next = NULL;
+	ret->prev = NULL;
+	return ret;
+}
+/************************************************************************************************************
+ * toStringItem
+ *
+ * Synopsis: static char * toStringItem (const char * data, int hasPrior, int hasNext, char * buff)
+ *
+ * Description: Builds the string representation shared by the nodes of a list and the slots of an
+ * unrolled list: the data followed by indicators of whether the item has a prior and a next item.
+ *
+ * Returns: buff.
+ *
+ ************************************************************************************************************/
+static char * toStringItem (const char * data, int hasPrior, int hasNext, char * buff) {
 	char tempBuff[MAX_CHARS_DATA+2];
 
 	sprintf (buff, "\nNODE: ");			// from string.h
-	strncpy(tempBuff, myNode->data, MAX_CHARS_DATA);
+	strncpy(tempBuff, data, MAX_CHARS_DATA);
+	tempBuff[MAX_CHARS_DATA] = '\0';
 	strcat (buff, tempBuff);
-	if (myNode->prev) 
+	if (hasPrior) 
 		strcat (buff, "\nHAS PRIOR\n");
 	else 
 		strcat(buff, "\nNO PRIOR\n");	// should be first in list
-	if (myNode->next) 
+	if (hasNext) 
 		strcat (buff, "HAS NEXT\n");
 	else 
 		strcat (buff, "NO NEXT - End of List\n");
 	return buff;
 }
+/************************************************************************************************************
+ * toStringNode
+ *
+ * Synopsis: char * toStringNode(Node_p myNode, char * buff)
+ *
+ * Description: If node is a valid pointer the function creates a string representing the contents of the
+ * node along with indicators of its prior and next pointer statuses. The string is built in the buff characters
+ * array and the calling function needs to ensure the size of that buffer wherever it is allocated.
+ *
+ * Returns: A pointer to the string representation of the node.
+ *
+ ************************************************************************************************************/
+char* toStringNode (Node_p myNode, char * buff) {
+	if (myNode == NULL) return NULL;
+	if (buff == NULL) return NULL;
+
+	return toStringItem (myNode->data, myNode->prev != NULL, myNode->next != NULL, buff);
+}
 
+/************************************************************************************************************
+ * filterRejects
+ *
+ * Synopsis: static int filterRejects (List_p myList, const char * searchData)
+ *
+ * Description: Asks the list's filter, if it has one, whether searchData can be in the list at all.
+ *
+ * Returns: 1 if searchData is certainly not in the list, 0 if the list has to be searched.
+ *
+ ************************************************************************************************************/
+static int filterRejects (List_p myList, const char * searchData) {
+	return myList->filter != NULL && !bloomMayContain(myList->filter, searchData);
+}
+/************************************************************************************************************
+ * filterChecked
+ *
+ * Synopsis: static void filterChecked (List_p myList, const void * found)
+ *
+ * Description: Called after a search the filter let through; a miss means the filter gave a false
+ * positive.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void filterChecked (List_p myList, const void * found) {
+	if (myList->filter != NULL && found == NULL)
+		myList->filter->falsePositives++;
+}
 /************************************************************************************************************
  * findNode
  *
  * Synopsis: Node_p findNode (List_p myList, const char * searchData)
  *
  * Description: If the list contains valid nodes, then it starts iterating through the list until
- * a match is found.
+ * a match is found. Ordered lists search their skip list lanes instead. Unrolled lists have no nodes. If the
+ * list has a filter that rules searchData out, no node is touched at all. A list with an intern table looks
+ * searchData up in the table once; if it is there the nodes are matched by pointer, if not it is in no list
+ * using the table.
  *
- * Returns: A pointer to the node in the list.
+ * Returns: A pointer to the node in the list, NULL if not found.
  *
  ************************************************************************************************************/
 Node_p findNode (List_p myList, const char * searchData) {
+	if (myList == NULL || searchData == NULL || myList->storage != LIST_STORAGE_NODES)
+		return NULL;
+	if (filterRejects(myList, searchData))
+		return NULL;
+	if (myList->index != NULL) {
+		Node_p found = skipFind(myList, searchData);
+		filterChecked(myList, found);
+		return found;
+	}
+
 	Node_p curr = myList->first;
+	if (myList->strings != NULL) {
+		const char * interned = internLookup(myList->strings, searchData);
+		if (interned != NULL)
+			for (; curr != NULL; curr = curr->next)
+				if (curr->data == interned)
+					return curr;
+		filterChecked(myList, NULL);
+		return NULL;
+	}
 		while (curr != NULL) {
 			if (!strcmp(searchData, curr->data)) //returns 0 if equals
 				return curr; 
 				curr = curr->next;
 		}
+	filterChecked(myList, NULL);
 	return NULL;
 }
 /************************************************************************************************************
@@ -98,8 +208,8 @@ Node_p findNode (List_p myList, const char * searchData) {
  *
  * Synopsis: int destroyNode(Node_p myNode)
  *
- * Description: If node is a valid pointer the function frees the allocated memory for the data string and
- * then frees the node itself.
+ * Description: If node is a valid pointer the function releases the data with the node's destructor (free()
+ * for strings, nothing for data the list does not own) and then frees the node itself.
  *
  * Returns: A DELETE_ERROR if node is not a valid pointer, NO_ERROR otherwise.
  *
@@ -107,11 +217,39 @@ Node_p findNode (List_p myList, const char * searchData) {
 int destroyNode(Node_p myNode) {
 	if (!myNode) 
 		return DELETE_ERROR;
-	if (myNode->data) 
-		free (myNode->data);
-		free (myNode);
+	if (myNode->data && myNode->destroy)
+		myNode->destroy (myNode->data);
+	free (myNode);
 	return NO_ERROR;
 }
+/************************************************************************************************************
+ * takeNodeData
+ *
+ * Synopsis: static char * takeNodeData (Node_p myNode)
+ *
+ * Description: Frees a node that has already been unlinked from its list and hands its data to the caller.
+ * Data stored inside the node is moved to the start of the node's own block, which becomes the string:
+ * no allocation and no second copy, and the caller frees it like any other. Data in an intern table is
+ * copied out to the heap (giving the table its reference back). Either way the caller gets a pointer it
+ * can keep (and free) after the node is gone.
+ *
+ * Returns: A pointer to the data, NULL if the node is not valid.
+ *
+ ************************************************************************************************************/
+static char * takeNodeData (Node_p myNode) {
+	if (!myNode)
+		return NULL;
+	char * data = myNode->data;
+	if (data == myNode->inlineData)
+		return (char *) memmove(myNode, data, strlen(data) + 1);
+	if (myNode->destroy == internRelease) {
+		data = (char *) malloc (sizeof(char) * strlen(myNode->data) + 1);
+		strcpy(data, myNode->data);
+		internRelease(myNode->data);
+	}
+	free(myNode);
+	return data;
+}
 /************************************************************************************************************
  * getDataFromNode
  *
@@ -184,17 +322,137 @@ Node_p getSuccessorNode (Node_p myNode) {
  *
  ************************************************************************************************************/
 List_p createList (const char* lname) {
+	return createListWithStorage(lname, LIST_STORAGE_NODES);
+}
+/************************************************************************************************************
+ * createListWithStorage
+ *
+ * Synopsis: List_p createListWithStorage (const char* lname, int storage)
+ *
+ * Description: Same as createList but also records how the items of the list are stored, one Node per
+ * item or packed in chunks (see d_unrolledList.h).
+ *
+ * Returns: A pointer to the new list in the heap, NULL if storage is not a valid code.
+ *
+ ************************************************************************************************************/
+List_p createListWithStorage (const char* lname, int storage) {
+	if (storage != LIST_STORAGE_NODES && storage != LIST_STORAGE_UNROLLED)
+		return NULL;
+
 	List_p myList = (List_p) malloc (sizeof(List));
+	myList->listName = NULL;
 	if (lname != NULL) {
 		myList->listName = (char*) malloc (sizeof(char) * strlen(lname) + 1);
 		strcpy(myList->listName, lname);
 	}
 	myList->count = 0;
 	myList->order = NO_ORDER;
+	myList->storage = storage;
 	myList->first = NULL;
 	myList->last = NULL;
+	myList->firstChunk = NULL;
+	myList->lastChunk = NULL;
+	myList->index = NULL;
+	myList->filter = NULL;
+	myList->strings = NULL;
 	return myList;
 }
+/************************************************************************************************************
+ * createOrderedList
+ *
+ * Synopsis: List_p createOrderedList (const char* lname, int mode)
+ *
+ * Description: Creates an empty list that is kept in ascending or descending order by every insert, with
+ * an empty skip list index to find positions quickly.
+ *
+ * Returns: A pointer to the new list in the heap, NULL if mode is not a sort mode.
+ *
+ ************************************************************************************************************/
+List_p createOrderedList (const char* lname, int mode) {
+	if (mode != SORT_ASCEND && mode != SORT_DESCEND)
+		return NULL;
+
+	List_p myList = createList(lname);
+	myList->order = (mode == SORT_ASCEND) ? ASCEND_ORDER : DESCEND_ORDER;
+	myList->index = skipCreate();
+	if (myList->index == NULL) {
+		free(myList->listName);
+		free(myList);
+		return NULL;
+	}
+	return myList;
+}
+/************************************************************************************************************
+ * listIterBegin
+ *
+ * Synopsis: void listIterBegin (List_p myList, ListIter * iter)
+ *
+ * Description: Positions the cursor before the first item of the list.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void listIterBegin (List_p myList, ListIter * iter) {
+	iter->node = (myList != NULL) ? myList->first : NULL;
+	iter->chunk = (myList != NULL) ? myList->firstChunk : NULL;
+	iter->slot = 0;
+}
+/************************************************************************************************************
+ * listIterNext
+ *
+ * Synopsis: char * listIterNext (ListIter * iter)
+ *
+ * Description: Returns the item under the cursor and moves the cursor to the next one, following node
+ * links or walking the slots of each chunk. The node (chunk) the cursor moves to is prefetched, so its
+ * cache miss overlaps with whatever the caller does with the current item; in a chunk the string two
+ * slots ahead is prefetched as well.
+ *
+ * Returns: The item's data, NULL once every item was visited.
+ *
+ ************************************************************************************************************/
+char * listIterNext (ListIter * iter) {
+	char * data;
+
+	if (iter->node != NULL) {
+		data = iter->node->data;
+		iter->node = iter->node->next;
+		LIST_PREFETCH(iter->node);
+		return data;
+	}
+	if (iter->chunk != NULL) {
+		data = iter->chunk->slots[iter->slot++];
+		if (iter->slot + 2 < iter->chunk->used)
+			LIST_PREFETCH(iter->chunk->slots[iter->slot + 2]);
+		if (iter->slot == iter->chunk->used) {
+			iter->chunk = iter->chunk->next;
+			iter->slot = 0;
+			LIST_PREFETCH(iter->chunk);
+		}
+		return data;
+	}
+	return NULL;
+}
+/************************************************************************************************************
+ * firstData / lastData
+ *
+ * Synopsis: static char * firstData (List_p myList)
+ *
+ * Description: Returns the data of the first (last) item of the list, whatever its storage.
+ *
+ * Returns: A pointer to the data, NULL if the list is empty.
+ *
+ ************************************************************************************************************/
+static char * firstData (List_p myList) {
+	if (myList->storage == LIST_STORAGE_UNROLLED)
+		return (myList->firstChunk != NULL) ? myList->firstChunk->slots[0] : NULL;
+	return (myList->first != NULL) ? myList->first->data : NULL;
+}
+
+static char * lastData (List_p myList) {
+	if (myList->storage == LIST_STORAGE_UNROLLED)
+		return (myList->lastChunk != NULL) ? myList->lastChunk->slots[myList->lastChunk->used - 1] : NULL;
+	return (myList->last != NULL) ? myList->last->data : NULL;
+}
 /************************************************************************************************************
  * toStringList
  *
@@ -213,7 +471,8 @@ char* toStringList (List_p myList, char* buff) {
 	char tempBuff[MAX_LIST_NAME + 2];
 
 	sprintf(buff, "\nList name: ");
-	strncpy(tempBuff, myList->listName, MAX_LIST_NAME);
+	strncpy(tempBuff, myList->listName ? myList->listName : "", MAX_LIST_NAME);
+	tempBuff[MAX_LIST_NAME] = '\0';
 	strcat(buff, tempBuff);
 
 	char str[MAX_CHARS_DATA];
@@ -221,16 +480,16 @@ char* toStringList (List_p myList, char* buff) {
 	strcat(buff, "\nItems in list: ");
 	strcat(buff, str);
 	strcat(buff, "\n");
-	if (myList->first) {
+	if (firstData(myList)) {
 		strcat(buff, "First: ");
-		strcat(buff, myList->first->data);
+		strcat(buff, firstData(myList));
 		strcat(buff, "\n");
 	}
 	else
 		strcat(buff, "NO FIRST\n");
-	if (myList->last) {
+	if (lastData(myList)) {
 		strcat(buff, "Last: ");
-		strcat(buff, myList->last->data);
+		strcat(buff, lastData(myList));
 		strcat(buff, "\n");
 	}
 	else
@@ -242,63 +501,119 @@ char* toStringList (List_p myList, char* buff) {
  *
  * Synopsis: char* findData (List_p myList, const char * searchData)
  *
- * Description: This function uses findNode to return a pointer to the data of the node.
+ * Description: This function uses findNode to return a pointer to the data of the node (or searches the
+ * chunks of an unrolled list).
  *
- * Returns: A pointer to the string contain the node's data.
+ * Returns: A pointer to the string contain the node's data, NULL if not found.
  *
  ************************************************************************************************************/
 char* findData (List_p myList, const char * searchData) {
-	return findNode (myList, searchData)->data;
+	if (myList == NULL || searchData == NULL)
+		return NULL;
+	if (myList->storage == LIST_STORAGE_UNROLLED) {
+		if (filterRejects(myList, searchData))
+			return NULL;
+		char * found = unrolledFind (myList, searchData);
+		filterChecked(myList, found);
+		return found;
+	}
+
+	Node_p found = findNode (myList, searchData);
+	return (found != NULL) ? found->data : NULL;
 }
 /************************************************************************************************************
  * printList
  *
  * Synopsis: void printList (List_p myList, FILE* output, int * error)
  *
- * Description: This function prints the list to a file and the screen as well. Changes the value of error
- * if the the output fle does not exit.
+ * Description: This function prints the list header followed by every node in the layout of toStringNode(),
+ * streamed through the list writer (d_listWriter.h) so long data is printed whole. Sets error to
+ * PRINT_ERROR if the output could not be written.
  *
  * Returns: nothing (void).
  *
  ************************************************************************************************************/
 void printList (List_p myList, FILE* output, int * error) {
-	Node_p temp = myList->first;
-	char buffer[BUFFER_SIZE];
-	//output = fopen("test_file.txt", "a");
-	if (output == NULL) {
-		fprintf(stdout, "File not found.");
-		*error = PRINT_ERROR;
-	} else {
-		fprintf(output, toStringList(myList, buffer));
-	}
-
-	printf("%s", toStringList(myList, buffer));
+	int ret = PRINT_ERROR;
 
-	while (temp != NULL) {
-		if (error == NO_ERROR)
-			fprintf(output, toStringNode(temp, buffer));
-		printf("%s\n", toStringNode (temp, buffer));
-		temp = temp->next;
+	if (myList != NULL) {
+		ret = writeListHeader(myList, output);
+		if (ret == NO_ERROR)
+			ret = writeList(myList, output, LIST_FORMAT_NODES);
 	}
-	//fclose(output);
+	if (error)
+		*error = ret;
 }
 /************************************************************************************************************
- * appendData
+ * copyString
  *
- * Synopsis: int appendData (List_p myList, const char * nodeData)
+ * Synopsis: static char * copyString (const char * data)
  *
- * Description: This function creates a node and adds it to the end of the list
- * if nodeData is valid and if the myList exits.
+ * Description: Copies data to a new string in the heap.
+ *
+ * Returns: A pointer to the copy.
+ *
+ ************************************************************************************************************/
+static char * copyString (const char * data) {
+	char * copy = (char *) malloc (sizeof(char) * strlen(data) + 1);
+	strcpy(copy, data);
+	return copy;
+}
+/************************************************************************************************************
+ * newNode
+ *
+ * Synopsis: static Node_p newNode (List_p myList, const char * data)
+ *
+ * Description: Creates the node for data being added to myList: a node with its own copy of data, or, if
+ * the list has an intern table, a node pointing at the table's copy that gives its reference back when it
+ * is destroyed.
+ *
+ * Returns: A pointer to the new node, NULL if not successful.
+ *
+ ************************************************************************************************************/
+static Node_p newNode (List_p myList, const char * data) {
+	if (myList->strings == NULL)
+		return createNode(data);
+
+	char * interned = internString(myList->strings, data);
+	if (interned == NULL)
+		return NULL;
+	Node_p ret = createNodeAdopt(interned, internRelease);
+	if (ret == NULL)
+		internRelease(interned);
+	return ret;
+}
+/************************************************************************************************************
+ * setListInternTable
+ *
+ * Synopsis: int setListInternTable (List_p myList, InternTable * table)
+ *
+ * Description: Attaches an intern table to an empty list (or detaches it with table == NULL). The list has
+ * to be empty so that every node it will hold is interned, which is what lets findNode() compare pointers.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR.
+ *
+ ************************************************************************************************************/
+int setListInternTable (List_p myList, InternTable * table) {
+	if (myList == NULL || myList->count > 0 || myList->storage != LIST_STORAGE_NODES)
+		return INSERT_ERROR;
+	myList->strings = table;
+	return NO_ERROR;
+}
+/************************************************************************************************************
+ * linkNodeAtEnd
+ *
+ * Synopsis: static int linkNodeAtEnd (List_p myList, Node_p newNode)
+ *
+ * Description: This function attaches an already created node to the end of the list.
  *
  * Returns: NO_ERROR on success, else INSERT_ERROR on failure.
  *
  ************************************************************************************************************/
-int appendData (List_p myList, const char * nodeData) {
-	if (nodeData == NULL || nodeData == NULL)
+static int linkNodeAtEnd (List_p myList, Node_p newNode) {
+	if (newNode == NULL)
 		return INSERT_ERROR;
 
-	Node_p newNode = createNode(nodeData);
-
 	if (myList->first == NULL) {
 		myList->first = newNode;
 		myList->last = newNode;
@@ -313,22 +628,19 @@ int appendData (List_p myList, const char * nodeData) {
 	return NO_ERROR;
 }
 /************************************************************************************************************
- * insertDataAtFront
+ * linkNodeAtFront
  *
- * Synopsis: int insertDataAtFront (List_p myList, const char * nodeData)
+ * Synopsis: static int linkNodeAtFront (List_p myList, Node_p newNode)
  *
- * Description: This function creates a node and adds it to the front of the list
- * if nodeData is valid and if the myList exits.
+ * Description: This function attaches an already created node to the front of the list.
  *
  * Returns: NO_ERROR on success, else INSERT_ERROR on failure.
  *
  ************************************************************************************************************/
-int insertDataAtFront (List_p myList, const char * nodeData) {
-	if (myList == NULL || nodeData == NULL)
+static int linkNodeAtFront (List_p myList, Node_p newNode) {
+	if (newNode == NULL)
 		return INSERT_ERROR;
 
-	Node_p newNode = createNode(nodeData);
-
 	if (myList->first == NULL) {
 		myList->first = newNode;
 		myList->last = newNode;
@@ -342,51 +654,425 @@ int insertDataAtFront (List_p myList, const char * nodeData) {
 	myList->count++;
 	return NO_ERROR;
 }
+/************************************************************************************************************
+ * rebuildFilter
+ *
+ * Synopsis: static void rebuildFilter (List_p myList)
+ *
+ * Description: Empties the filter, sizes it for twice the current # of items (but not below what it was
+ * sized for) and adds every item again.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void rebuildFilter (List_p myList) {
+	BloomFilter * filter = myList->filter;
+	int capacity = (myList->count * 2 > filter->capacity) ? myList->count * 2 : filter->capacity;
+	ListIter iter;
+	char * data;
+
+	bloomClear(filter, capacity);
+	listIterBegin(myList, &iter);
+	while ((data = listIterNext(&iter)) != NULL)
+		bloomAdd(filter, data);
+	filter->rebuilds++;
+}
+/************************************************************************************************************
+ * noteAdded
+ *
+ * Synopsis: static int noteAdded (List_p myList, const char * data, int result)
+ *
+ * Description: Called with the result of an insert; keeps the filter in step with the list.
+ *
+ * Returns: result.
+ *
+ ************************************************************************************************************/
+static int noteAdded (List_p myList, const char * data, int result) {
+	if (myList->filter != NULL && result == NO_ERROR) {
+		bloomAdd(myList->filter, data);
+		if (bloomNeedsRebuild(myList->filter))
+			rebuildFilter(myList);
+	}
+	return result;
+}
+/************************************************************************************************************
+ * noteRemoved
+ *
+ * Synopsis: static char * noteRemoved (List_p myList, char * data)
+ *
+ * Description: Called with the data a remove function is about to return; keeps the filter in step with
+ * the list.
+ *
+ * Returns: data.
+ *
+ ************************************************************************************************************/
+static char * noteRemoved (List_p myList, char * data) {
+	if (myList->filter != NULL && data != NULL) {
+		bloomRemove(myList->filter, data);
+		if (bloomNeedsRebuild(myList->filter))
+			rebuildFilter(myList);
+	}
+	return data;
+}
+/************************************************************************************************************
+ * enableListFilter
+ *
+ * Synopsis: int enableListFilter (List_p myList, int expected)
+ *
+ * Description: Attaches a counting Bloom filter to the list (replacing any previous one) and adds every
+ * item already in the list to it.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR.
+ *
+ ************************************************************************************************************/
+int enableListFilter (List_p myList, int expected) {
+	if (myList == NULL)
+		return INSERT_ERROR;
+	if (expected < myList->count)
+		expected = myList->count;
+
+	BloomFilter * filter = bloomCreate(expected);
+	if (filter == NULL)
+		return INSERT_ERROR;
+
+	ListIter iter;
+	char * data;
+	listIterBegin(myList, &iter);
+	while ((data = listIterNext(&iter)) != NULL)
+		bloomAdd(filter, data);
+	bloomDestroy(myList->filter);
+	myList->filter = filter;
+	return NO_ERROR;
+}
+/************************************************************************************************************
+ * disableListFilter
+ *
+ * Synopsis: void disableListFilter (List_p myList)
+ *
+ * Description: Frees the list's filter; searches walk the list again.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void disableListFilter (List_p myList) {
+	if (myList == NULL)
+		return;
+	bloomDestroy(myList->filter);
+	myList->filter = NULL;
+}
+/************************************************************************************************************
+ * getListFilterStats
+ *
+ * Synopsis: int getListFilterStats (List_p myList, FilterStats * stats)
+ *
+ * Description: Copies the filter's counters to stats. The false positive rate is taken over the searches
+ * for data that was not in the list, the only ones the filter can get wrong.
+ *
+ * Returns: NO_ERROR, or NOT_FOUND_ERROR if the list has no filter.
+ *
+ ************************************************************************************************************/
+int getListFilterStats (List_p myList, FilterStats * stats) {
+	if (myList == NULL || myList->filter == NULL || stats == NULL)
+		return NOT_FOUND_ERROR;
+
+	BloomFilter * filter = myList->filter;
+	long misses = filter->skipped + filter->falsePositives;
+	stats->queries = filter->queries;
+	stats->skipped = filter->skipped;
+	stats->falsePositives = filter->falsePositives;
+	stats->falsePositiveRate = (misses > 0) ? (double) filter->falsePositives / misses : 0.0;
+	stats->rebuilds = filter->rebuilds;
+	stats->capacity = filter->capacity;
+	return NO_ERROR;
+}
+/************************************************************************************************************
+ * noteInsert
+ *
+ * Synopsis: static void noteInsert (List_p myList, const char * data, int atFront)
+ *
+ * Description: Called before data is added at one end of a list that is not kept ordered. If the list was
+ * sorted and the new data breaks that order, the list is marked as not ordered any more, so order can be
+ * trusted by sortList().
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void noteInsert (List_p myList, const char * data, int atFront) {
+	if (myList->order == NO_ORDER || myList->count == 0)
+		return;
+
+	int cmp = atFront ? strcmp(data, firstData(myList)) : strcmp(lastData(myList), data);
+	if ((myList->order == ASCEND_ORDER && cmp > 0) || (myList->order == DESCEND_ORDER && cmp < 0))
+		myList->order = NO_ORDER;
+}
+/************************************************************************************************************
+ * insertSorted
+ *
+ * Synopsis: static int insertSorted (List_p myList, Node_p newNode)
+ *
+ * Description: Puts a new node at its sorted position in an ordered list.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR on failure.
+ *
+ ************************************************************************************************************/
+static int insertSorted (List_p myList, Node_p newNode) {
+	if (newNode == NULL)
+		return INSERT_ERROR;
+	skipInsert(myList, newNode);
+	return NO_ERROR;
+}
+/************************************************************************************************************
+ * unlinkNode
+ *
+ * Synopsis: static void unlinkNode (List_p myList, Node_p curr)
+ *
+ * Description: Takes a node out of the list (and out of the lanes of an ordered list), fixing the first and
+ * last pointers and the count. The node itself is not freed.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void unlinkNode (List_p myList, Node_p curr) {
+	if (myList->index != NULL)
+		skipRemove(myList, curr);
+	if (curr->prev != NULL)
+		curr->prev->next = curr->next;
+	else
+		myList->first = curr->next;
+	if (curr->next != NULL)
+		curr->next->prev = curr->prev;
+	else
+		myList->last = curr->prev;
+	curr->prev = NULL;
+	curr->next = NULL;
+	myList->count--;
+}
+/************************************************************************************************************
+ * appendData
+ *
+ * Synopsis: int appendData (List_p myList, const char * nodeData)
+ *
+ * Description: This function creates a node and adds it to the end of the list
+ * if nodeData is valid and if the myList exits.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR on failure.
+ *
+ ************************************************************************************************************/
+int appendData (List_p myList, const char * nodeData) {
+	if (myList == NULL || nodeData == NULL)
+		return INSERT_ERROR;
+	if (myList->index != NULL)
+		return noteAdded(myList, nodeData, insertSorted(myList, newNode(myList, nodeData)));
+	noteInsert(myList, nodeData, 0);
+	if (myList->storage == LIST_STORAGE_UNROLLED)
+		return noteAdded(myList, nodeData, unrolledAppend(myList, copyString(nodeData)));
+
+	return noteAdded(myList, nodeData, linkNodeAtEnd(myList, newNode(myList, nodeData)));
+}
+/************************************************************************************************************
+ * insertDataAtFront
+ *
+ * Synopsis: int insertDataAtFront (List_p myList, const char * nodeData)
+ *
+ * Description: This function creates a node and adds it to the front of the list
+ * if nodeData is valid and if the myList exits.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR on failure.
+ *
+ ************************************************************************************************************/
+int insertDataAtFront (List_p myList, const char * nodeData) {
+	if (myList == NULL || nodeData == NULL)
+		return INSERT_ERROR;
+	if (myList->index != NULL)
+		return noteAdded(myList, nodeData, insertSorted(myList, newNode(myList, nodeData)));
+	noteInsert(myList, nodeData, 1);
+	if (myList->storage == LIST_STORAGE_UNROLLED)
+		return noteAdded(myList, nodeData, unrolledInsertFront(myList, copyString(nodeData)));
+
+	return noteAdded(myList, nodeData, linkNodeAtFront(myList, newNode(myList, nodeData)));
+}
+/************************************************************************************************************
+ * appendDataAdopt
+ *
+ * Synopsis: int appendDataAdopt (List_p myList, char * nodeData)
+ *
+ * Description: This function adds a node to the end of the list that takes over nodeData, a string the
+ * caller allocated in the heap, instead of copying it. A list with an intern table shares the table's copy
+ * and frees nodeData.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR on failure.
+ *
+ ************************************************************************************************************/
+int appendDataAdopt (List_p myList, char * nodeData) {
+	if (myList == NULL || nodeData == NULL)
+		return INSERT_ERROR;
+	if (myList->strings != NULL) {
+		// the table keeps its own copy, nodeData is not needed any more
+		int ret = appendData(myList, nodeData);
+		free(nodeData);
+		return ret;
+	}
+	if (myList->index != NULL)
+		return noteAdded(myList, nodeData, insertSorted(myList, createNodeAdopt(nodeData, free)));
+	noteInsert(myList, nodeData, 0);
+	if (myList->storage == LIST_STORAGE_UNROLLED)
+		return noteAdded(myList, nodeData, unrolledAppend(myList, nodeData));
+
+	return noteAdded(myList, nodeData, linkNodeAtEnd(myList, createNodeAdopt(nodeData, free)));
+}
+/************************************************************************************************************
+ * insertDataAtFrontAdopt
+ *
+ * Synopsis: int insertDataAtFrontAdopt (List_p myList, char * nodeData)
+ *
+ * Description: This function adds a node to the front of the list that takes over nodeData, a string the
+ * caller allocated in the heap, instead of copying it. A list with an intern table shares the table's copy
+ * and frees nodeData.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR on failure.
+ *
+ ************************************************************************************************************/
+int insertDataAtFrontAdopt (List_p myList, char * nodeData) {
+	if (myList == NULL || nodeData == NULL)
+		return INSERT_ERROR;
+	if (myList->strings != NULL) {
+		// the table keeps its own copy, nodeData is not needed any more
+		int ret = insertDataAtFront(myList, nodeData);
+		free(nodeData);
+		return ret;
+	}
+	if (myList->index != NULL)
+		return noteAdded(myList, nodeData, insertSorted(myList, createNodeAdopt(nodeData, free)));
+	noteInsert(myList, nodeData, 1);
+	if (myList->storage == LIST_STORAGE_UNROLLED)
+		return noteAdded(myList, nodeData, unrolledInsertFront(myList, nodeData));
+
+	return noteAdded(myList, nodeData, linkNodeAtFront(myList, createNodeAdopt(nodeData, free)));
+}
+/************************************************************************************************************
+ * appendPayload
+ *
+ * Synopsis: int appendPayload (List_p myList, void * payload, DataDestructor destroy)
+ *
+ * Description: This function adds a node holding an arbitrary pointer to the end of the list. Nothing is
+ * copied; destroy (if not NULL) is called on the payload when the node is destroyed.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR on failure.
+ *
+ ************************************************************************************************************/
+int appendPayload (List_p myList, void * payload, DataDestructor destroy) {
+	if (myList == NULL || payload == NULL || myList->storage != LIST_STORAGE_NODES || myList->index != NULL ||
+			myList->filter != NULL)
+		return INSERT_ERROR;
+
+	myList->order = NO_ORDER;
+	return linkNodeAtEnd(myList, createNodeAdopt((char *) payload, destroy));
+}
+/************************************************************************************************************
+ * insertPayloadAtFront
+ *
+ * Synopsis: int insertPayloadAtFront (List_p myList, void * payload, DataDestructor destroy)
+ *
+ * Description: This function adds a node holding an arbitrary pointer to the front of the list. Nothing
+ * is copied; destroy (if not NULL) is called on the payload when the node is destroyed.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR on failure.
+ *
+ ************************************************************************************************************/
+int insertPayloadAtFront (List_p myList, void * payload, DataDestructor destroy) {
+	if (myList == NULL || payload == NULL || myList->storage != LIST_STORAGE_NODES || myList->index != NULL ||
+			myList->filter != NULL)
+		return INSERT_ERROR;
+
+	myList->order = NO_ORDER;
+	return linkNodeAtFront(myList, createNodeAdopt((char *) payload, destroy));
+}
+/************************************************************************************************************
+ * insertDataWithKey
+ *
+ * Synopsis: int insertDataWithKey (List_p myList, const char * key, const char * nodeData, int mode)
+ *
+ * Description: This function finds the first node holding key and links a new node holding nodeData just
+ * before it (mode == INSERT_BEFORE) or just after it (mode == INSERT_AFTER). In an ordered list the key is
+ * found through the lanes; if nodeData belongs at that position it is inserted at its sorted place among
+ * equal data, otherwise the list gives up its lanes and becomes an ordinary unordered list.
+ *
+ * Returns: NO_ERROR on success, NOT_FOUND_ERROR if key is not in the list, else INSERT_ERROR.
+ *
+ ************************************************************************************************************/
+int insertDataWithKey (List_p myList, const char * key, const char * nodeData, int mode) {
+	if (myList == NULL || key == NULL || nodeData == NULL || myList->storage != LIST_STORAGE_NODES)
+		return INSERT_ERROR;
+	if (mode != INSERT_BEFORE && mode != INSERT_AFTER)
+		return INSERT_ERROR;
+
+	Node_p found = findNode(myList, key);
+	if (found == NULL)
+		return NOT_FOUND_ERROR;
+
+	Node_p before = (mode == INSERT_BEFORE) ? found->prev : found;
+	Node_p after = (mode == INSERT_BEFORE) ? found : found->next;
+	int fits = 1;
+	if (myList->order != NO_ORDER) {
+		int sign = (myList->order == ASCEND_ORDER) ? 1 : -1;
+		if (before != NULL && sign * strcmp(before->data, nodeData) > 0)
+			fits = 0;
+		if (after != NULL && sign * strcmp(nodeData, after->data) > 0)
+			fits = 0;
+	}
+
+	if (myList->index != NULL) {
+		if (fits)
+			return noteAdded(myList, nodeData, insertSorted(myList, newNode(myList, nodeData)));
+		skipDestroy(myList->index);
+		myList->index = NULL;
+	}
+	if (!fits)
+		myList->order = NO_ORDER;
+
+	Node_p added = newNode(myList, nodeData);
+	if (added == NULL)
+		return INSERT_ERROR;
+	added->prev = before;
+	added->next = after;
+	if (before != NULL)
+		before->next = added;
+	else
+		myList->first = added;
+	if (after != NULL)
+		after->prev = added;
+	else
+		myList->last = added;
+	myList->count++;
+	return noteAdded(myList, nodeData, NO_ERROR);
+}
 /************************************************************************************************************
  * removeData
  *
  * Synopsis: char * removeData (List_p myList, const char * searchData)
  *
  * Description: This function searches through the list until a match is found. Once the match is found,
- * it removes the data from the node. However, the node still exists.
+ * the node is taken out of the list and freed, and its data is handed to the caller.
  *
  * Returns: The data removed from the node.
  *
  ************************************************************************************************************/
 char * removeData (List_p myList, const char * searchData) {
-	Node_p curr = myList->first;
-	if (myList->count > 0)
-		while (curr != NULL) {
-			if (!strcmp(searchData, curr->data)) { //returns 0 if equals
-					if (curr->prev != NULL && curr->next != NULL) {
-						curr->prev->next = curr->next;
-						curr->next->prev = curr->prev;
-					}
-					else if (curr->prev == NULL && curr->next != NULL) {
-						curr->next->prev = NULL;
-						myList->first = curr->next;
-					}
-					else if (curr->prev != NULL && curr->next == NULL) {
-						curr->prev->next = NULL;
-						myList->last = curr->prev;
-					}
-					else {
-						myList->count--;
-						myList->first = NULL;
-						myList->last = NULL;
-						char* temp = curr->data;
-						free(findNode(myList,curr->data));
-						return temp;
-					}
-					myList->count--;
-					char* temp = curr->data;
-					free(findNode(myList,curr->data));
-					return temp;
-			}
-				curr = curr->next;
-		}
+	if (myList == NULL || searchData == NULL)
+		return NULL;
+	if (myList->storage == LIST_STORAGE_UNROLLED) {
+		if (filterRejects(myList, searchData))
+			return NULL;
+		char * found = unrolledRemove(myList, searchData);
+		filterChecked(myList, found);
+		return noteRemoved(myList, found);
+	}
 
-	return NULL;
+	Node_p curr = findNode(myList, searchData);
+	if (curr == NULL)
+		return NULL;
+	unlinkNode(myList, curr);
+	return noteRemoved(myList, takeNodeData(curr));
 }
 /************************************************************************************************************
  * destroyList
@@ -400,8 +1086,15 @@ char * removeData (List_p myList, const char * searchData) {
  *
  ************************************************************************************************************/
 int destroyList (List_p myList) {
-	if (myList->count == 0 || myList == NULL)
+	if (myList == NULL)
 		return DELETE_ERROR;
+	if (myList->storage == LIST_STORAGE_UNROLLED) {
+		unrolledDestroy(myList);
+		bloomDestroy(myList->filter);
+		free(myList->listName);
+		free(myList);
+		return NO_ERROR;
+	}
 
 	Node_p curr = myList->first;
 	Node_p next;
@@ -411,6 +1104,9 @@ int destroyList (List_p myList) {
 		myList->count--;
 		curr = next;
 	}
+	skipDestroy(myList->index);
+	bloomDestroy(myList->filter);
+	free(myList->listName);
 	free(myList);
 	return NO_ERROR;
 }
@@ -456,25 +1152,16 @@ int getSortOrder(List_p myList) {
  *
  ************************************************************************************************************/
 char* removeDataFromHead (List_p myList) {
-	Node_p curr = myList->first;
-
-	if (curr->next != NULL) {
-		curr->next->prev = NULL;
-		myList->first = curr->next;
-		curr->next = NULL;
-		myList->count--;
-		char* temp = curr->data;
-		free(findNode(myList,curr->data));
-		return temp;
-	} else if (curr->next == NULL && curr != NULL) {
-		myList->first = NULL;
-		myList->last = NULL;
-		myList->count--;
-		char* temp = curr->data;
-		free(findNode(myList,curr->data));
-		return temp;
-	} else
+	if (myList == NULL)
+		return NULL;
+	if (myList->storage == LIST_STORAGE_UNROLLED)
+		return noteRemoved(myList, unrolledRemoveHead(myList));
+	if (myList->first == NULL)
 		return NULL;
+
+	Node_p curr = myList->first;
+	unlinkNode(myList, curr);
+	return noteRemoved(myList, takeNodeData(curr));
 }
 /************************************************************************************************************
  * removeDataFromTail
@@ -488,85 +1175,250 @@ char* removeDataFromHead (List_p myList) {
  *
  ************************************************************************************************************/
 char* removeDataFromTail(List_p myList) {
+	if (myList == NULL)
+		return NULL;
+	if (myList->storage == LIST_STORAGE_UNROLLED)
+		return noteRemoved(myList, unrolledRemoveTail(myList));
+	if (myList->last == NULL)
+		return NULL;
+
 	Node_p curr = myList->last;
+	unlinkNode(myList, curr);
+	return noteRemoved(myList, takeNodeData(curr));
+}
+/************************************************************************************************************
+ * compareNodesAscend / compareNodesDescend
+ *
+ * Synopsis: static int compareNodesAscend (const void * a, const void * b)
+ *
+ * Description: qsort() comparators for an array of node pointers, ordering by the nodes' data.
+ *
+ * Returns: <0, 0 or >0 like strcmp().
+ *
+ ************************************************************************************************************/
+static int compareNodesAscend (const void * a, const void * b) {
+	return strcmp((*(const Node_p *) a)->data, (*(const Node_p *) b)->data);
+}
 
-	if (curr->prev != NULL) { //ensure its the last item.
-		curr->prev->next = NULL;
-		myList->last = curr->prev;
-		curr->prev = NULL;
-		myList->count--;
-		char* temp = curr->data;
-		free(findNode(myList, curr->data));
-		return temp;
-	} else if (curr->prev == NULL && curr != NULL) {
-		myList->first = NULL;
-		myList->last = NULL;
-		myList->count--;
-		char* temp = curr->data;
-		free(findNode(myList, curr->data));
-		return temp;
-	} else
-		return NULL;
+static int compareNodesDescend (const void * a, const void * b) {
+	return strcmp((*(const Node_p *) b)->data, (*(const Node_p *) a)->data);
 }
 /************************************************************************************************************
  * sortList
  *
  * Synopsis: List_p sortList (List_p myList, int mode, int* error)
  *
- * Description: This function creates a new list to hold the sorted data. It creates a temp array in the
- * heap that copies all the node's data. Then it sorts that temp array according to the sort order
- * pass through the arguement. The sort is done by an implementation of an insertion sort.
+ * Description: This function creates a new list to hold the sorted data. It collects the nodes in a temp
+ * array in the heap, sorts that array according to the sort order passed through the argument and then
+ * relinks the nodes into the new list in that order. The nodes themselves (and the data stored in them)
+ * are moved, never copied.
  *
- * Returns: The new sorted list.
+ * Returns: The new sorted list, or the original list with error set to SORT_ERROR.
  *
  ************************************************************************************************************/
 List_p sortList (List_p myList, int mode, int* error) {
-	List_p sorted_list = createList(myList->listName);
-
-	while(myList->count)
-		appendData(sorted_list, removeDataFromHead(myList));
+	int order = (mode == SORT_ASCEND) ? ASCEND_ORDER : DESCEND_ORDER;	// the order code of mode
 
+	if (myList == NULL || (mode != SORT_ASCEND && mode != SORT_DESCEND)) {
+		if (error)
+			*error = SORT_ERROR;
+		return myList;
+	}
+	if (myList->order == order) {
+		// already in that order, every insert keeps order up to date (see noteInsert)
+		if (error)
+			*error = NO_ERROR;
+		return myList;
+	}
+	if (myList->storage == LIST_STORAGE_UNROLLED) {
+		// the chunks are reordered in place, the same list is returned
+		int status = unrolledSort(myList, mode);
+		if (status == NO_ERROR)
+			myList->order = order;
+		if (error)
+			*error = status;
+		return myList;
+	}
 
-	Node_p curr = sorted_list->first;
-	int i = 0, size = 0;
-	char** array = (char**) malloc (sizeof(char*));
+	int i = 0, size = myList->count;
+	Node_p* array = (Node_p*) malloc (sizeof(Node_p) * (size > 0 ? size : 1));
+	if (array == NULL) {
+		if (error)
+			*error = SORT_ERROR;
+		return myList;
+	}
+	List_p sorted_list = createList(myList->listName);
 
+	Node_p curr = myList->first;
 	while (curr != NULL) {
-		array[size] = (char*) malloc (sizeof(char) * strlen(curr->data));
-		array[size] = curr->data;
-		size++;
+		array[i++] = curr;
 		curr = curr->next;
 	}
 
-	if (mode == ASCEND_ORDER) {
+	if (mode == SORT_ASCEND) {
 		sorted_list->order = ASCEND_ORDER;
 		printf("Order: %d\n", ASCEND_ORDER);
-		array = insertion_sort_ascend(array, size);
-		curr = sorted_list->first;
-		while (curr != NULL) {
-			curr->data = array[i];
-			i++;
-			curr = curr->next;
-		}
-	} 
-	if (mode == DESCEND_ORDER) {
+		qsort(array, size, sizeof(Node_p), compareNodesAscend);
+	} else {
 		sorted_list->order = DESCEND_ORDER;
 		printf("Order: %d\n", DESCEND_ORDER);
-		array = insertion_sort_descend(array, size);
-		curr = sorted_list->first;
-		while (curr != NULL) {
-			curr->data = array[i];
-			i++;
-			curr = curr->next;
-		}
+		qsort(array, size, sizeof(Node_p), compareNodesDescend);
+	}
+	for (i = 0; i < size; i++) {
+		array[i]->prev = NULL;
+		array[i]->next = NULL;
+		linkNodeAtEnd(sorted_list, array[i]);
 	}
-	/*for(i = 0; i < size; i++) {
-		free(array[i]);
+
+	free(array);
+	sorted_list->filter = myList->filter;	// same items, the filter stays valid
+	sorted_list->strings = myList->strings;
+	if (myList->index != NULL) {
+		// an ordered list stays ordered, only its lanes have to be rebuilt for the new direction
+		sorted_list->index = myList->index;
+		skipBuild(sorted_list);
 	}
-	free(array);*/
+	free(myList->listName);
 	free(myList);
+	if (error)
+		*error = NO_ERROR;
 	return sorted_list;
 }
+/************************************************************************************************************
+ * mergeBeats
+ *
+ * Synopsis: static int mergeBeats (Node_p * heads, int a, int b, int sign)
+ *
+ * Description: Plays a match of the loser tree between the current heads of lists a and b. An exhausted
+ * list loses every match, equal data goes to the list with the lower index so the merge is stable.
+ *
+ * Returns: 1 if the head of list a goes first, 0 if the head of list b does.
+ *
+ ************************************************************************************************************/
+static int mergeBeats (Node_p * heads, int a, int b, int sign) {
+	int cmp;
+
+	if (heads[a] == NULL || heads[b] == NULL)
+		return heads[b] == NULL && (heads[a] != NULL || a < b);
+	cmp = sign * strcmp(heads[a]->data, heads[b]->data);
+	return cmp < 0 || (cmp == 0 && a < b);
+}
+/************************************************************************************************************
+ * mergeReplay
+ *
+ * Synopsis: static void mergeReplay (int * tree, int k, Node_p * heads, int s, int sign)
+ *
+ * Description: Walks from leaf s up to the root of the loser tree. At every internal node the loser of the
+ * match stays and the winner moves on; the overall winner ends in tree[0]. Leaves k .. 2k - 1 stand for the
+ * lists, so every internal node 1 .. k - 1 has two children. While the tree is being built an internal
+ * node still holding -1 keeps the first list that reaches it and the walk stops there.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void mergeReplay (int * tree, int k, Node_p * heads, int s, int sign) {
+	int t, swap;
+
+	for (t = (s + k) / 2; t > 0; t /= 2) {
+		if (tree[t] == -1) {
+			tree[t] = s;
+			return;
+		}
+		if (mergeBeats(heads, tree[t], s, sign)) {
+			swap = tree[t];
+			tree[t] = s;
+			s = swap;
+		}
+	}
+	tree[0] = s;
+}
+/************************************************************************************************************
+ * mergeLists
+ *
+ * Synopsis: List_p mergeLists (List_p * lists, int k, int mode, int * error)
+ *
+ * Description: Merges k lists that are each sorted in the order of mode. The current head of every list
+ * is a leaf of a loser tree; the winner is unlinked from its list, linked at the end of the merged list
+ * and replaced by its successor, which is replayed against the log2(k) losers on its path to the root.
+ * Nodes are relinked, never copied. The merged list takes the name of the first list; it keeps the intern
+ * table if all lists share one, gets skip list lanes if any list was an ordered one and a filter if any
+ * list had one. The list heads of the inputs are freed and their entries in lists set to NULL.
+ *
+ * Returns: The merged list with error set to NO_ERROR, or NULL with error set to SORT_ERROR if a list is
+ * not sorted in that order, is unrolled or if the merge could not be set up (no list is changed then).
+ *
+ ************************************************************************************************************/
+List_p mergeLists (List_p * lists, int k, int mode, int * error) {
+	Node_p * heads;
+	int * tree;
+	List_p merged;
+	int i, w, sign, ordered = 0, filtered = 0, sameStrings = 1;
+	int order = (mode == SORT_ASCEND) ? ASCEND_ORDER : DESCEND_ORDER;	// the order code of mode
+
+	if (error)
+		*error = SORT_ERROR;
+	if (lists == NULL || k <= 0 || (mode != SORT_ASCEND && mode != SORT_DESCEND))
+		return NULL;
+	for (i = 0; i < k; i++) {
+		if (lists[i] == NULL || lists[i]->storage != LIST_STORAGE_NODES)
+			return NULL;
+		if (lists[i]->order != order && lists[i]->count > 1)
+			return NULL;
+		ordered |= lists[i]->index != NULL;
+		filtered |= lists[i]->filter != NULL;
+		sameStrings &= lists[i]->strings == lists[0]->strings;
+	}
+
+	heads = (Node_p *) malloc (sizeof(Node_p) * k);
+	tree = (int *) malloc (sizeof(int) * k);
+	merged = createList(lists[0]->listName);
+	if (heads == NULL || tree == NULL || merged == NULL) {
+		free(heads);
+		free(tree);
+		if (merged != NULL) {
+			free(merged->listName);
+			free(merged);
+		}
+		return NULL;
+	}
+
+	sign = (mode == SORT_ASCEND) ? 1 : -1;
+	for (i = 0; i < k; i++) {
+		heads[i] = lists[i]->first;
+		tree[i] = -1;
+	}
+	for (i = k - 1; i >= 0; i--)
+		mergeReplay(tree, k, heads, i, sign);
+
+	while (heads[w = tree[0]] != NULL) {
+		Node_p winner = heads[w];
+		heads[w] = winner->next;
+		winner->prev = NULL;
+		winner->next = NULL;
+		linkNodeAtEnd(merged, winner);
+		mergeReplay(tree, k, heads, w, sign);
+	}
+	merged->order = order;
+	merged->strings = sameStrings ? lists[0]->strings : NULL;
+
+	for (i = 0; i < k; i++) {
+		skipDestroy(lists[i]->index);
+		bloomDestroy(lists[i]->filter);
+		free(lists[i]->listName);
+		free(lists[i]);
+		lists[i] = NULL;
+	}
+	free(heads);
+	free(tree);
+
+	if (ordered && (merged->index = skipCreate()) != NULL)
+		skipBuild(merged);
+	if (filtered)
+		enableListFilter(merged, merged->count);
+	if (error)
+		*error = NO_ERROR;
+	return merged;
+}
 /************************************************************************************************************
  * insertion_sort_ascend
  *
@@ -660,10 +1512,10 @@ int readList (List_p myList, FILE* input, int mode)  {
         	count++;
             printf( "count: %d   %c", count, x );
         }*/
-		while (fgets (node_data, strlen(node_data), input)) {
-			//fputs(node_data, stdout);
-			printf("%s", node_data);
-			appendData(myList, node_data);
+		while (fgets (node_data, MAX_CHARS_DATA, input)) {
+			node_data[strcspn(node_data, "\r\n")] = '\0';
+			if (appendData(myList, node_data) != NO_ERROR)
+				return INSERT_ERROR;
    		}
 		//fclose(input);
 		return NO_ERROR;
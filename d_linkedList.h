@@ -59,16 +59,34 @@
 #define ASCEND_ORDER 1
 #define DESCEND_ORDER 2
 
+// storage codes
+#define LIST_STORAGE_NODES 0		// one Node per item (default)
+#define LIST_STORAGE_UNROLLED 1		// items packed in chunks, see d_unrolledList.h
+
 #define BUFFER_SIZE 100
 #define MAX_CHARS_DATA 500	
 #define MAX_LIST_NAME 20
+#define NODE_INLINE_DATA 32	// strings shorter than this are stored inside the node itself, so a node
+							// is 64 bytes at most on 64 bit targets (a 32 byte header and the string)
+
+// hint the cache about the item a cursor visits next (no-op for compilers without the builtin)
+#if defined(__GNUC__)
+#define LIST_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define LIST_PREFETCH(addr) ((void) 0)
+#endif
 /*********************************************************************************************************
  *                                              ADTs
  ********************************************************************************************************/
+typedef void (*DataDestructor)(void *);	// called by destroyNode() to release the data
+
 typedef struct node {		// the node will hold the data and the links for the list
 	char * data;			// can be any arbitrary string, see toString() functions
 	struct node * prev;		// use tag declaration so compiler realizes that this is a pointer
 	struct node * next;		// to this class object
+	DataDestructor destroy;	// releases data, free() for strings, NULL if the list does not own it
+	char inlineData[];		// short strings live here and data points at it, the node is allocated
+							// with just enough room for them (nothing for longer strings/payloads)
 } Node;
 
 typedef Node * Node_p;		// create a pointer for readability
@@ -76,14 +94,35 @@ typedef Node * Node_p;		// create a pointer for readability
 typedef struct list {		// tag not really needed here, but there is consistency!
 	char * listName;		// optional name of the list
 	short order;			// New META_DATA to show if list is ordered
+	short storage;			// LIST_STORAGE_NODES or LIST_STORAGE_UNROLLED
 	int count;				// keep track of the number of items in the list
 	Node_p first;			// points to first item on list, NULL if list is empty
 	Node_p last;			// points to last item on list, NULL if list is empty, == first if
 							// only one item in the list
+	struct chunk * firstChunk;	// unrolled storage only, first/last chunk of items
+	struct chunk * lastChunk;	// (first and last are NULL for those lists)
+	struct skip_index * index;	// ordered lists only, express lanes over the nodes (d_skipList.h)
+	struct bloom_filter * filter;	// optional, answers most misses without a scan (d_bloomFilter.h)
+	struct intern_table * strings;	// optional, shared table the data is interned in (d_internTable.h)
 } List;
 
 typedef List * List_p;		// in case the user wants to instantiate list in the heap
 
+typedef struct filter_stats {	// see getListFilterStats()
+	long queries;			// searches that consulted the filter
+	long skipped;			// searches answered by the filter without touching a node
+	long falsePositives;	// searches the filter let through that then missed
+	double falsePositiveRate;	// falsePositives / all searches for data not in the list
+	long rebuilds;			// # of times the filter was rebuilt
+	int capacity;			// # of items the filter is currently sized for
+} FilterStats;
+
+typedef struct list_iter {	// cursor over the items of a list, whatever its storage
+	Node_p node;			// next node to visit (node storage)
+	struct chunk * chunk;	// next chunk to visit (unrolled storage)
+	int slot;				// next slot in chunk
+} ListIter;
+
 /*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 Function Prototypes
 ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
@@ -91,7 +130,15 @@ Function Prototypes
 
 Node_p createNode (const char * data);	
 // returns pointer to the node and attaches data to the node
-// via strcpy(). Returns NULL if not successful
+// via strcpy(). Strings shorter than NODE_INLINE_DATA are
+// copied into the node itself, longer ones into their own
+// block. Returns NULL if not successful
+
+Node_p createNodeAdopt (char * data, DataDestructor destroy);
+// returns pointer to the node holding data itself, nothing is
+// copied. The node owns data from now on and releases it with
+// destroy (NULL: the caller keeps ownership). Returns NULL if
+// not successful
 
 char * toStringNode (Node_p myNode, char * buff);
 // returns a string containing the representation of the
@@ -104,6 +151,56 @@ char * toStringNode (Node_p myNode, char * buff);
 List_p createList (const char* lname); // returns pointer to a list object in the heap if successful
 // NULL if not
 
+List_p createListWithStorage (const char* lname, int storage);
+// same as createList but selects how the items are stored.
+// LIST_STORAGE_UNROLLED packs the items in chunks for faster
+// scans; those lists hold strings only (no payloads) and have
+// no Nodes, so findNode() returns NULL for them. Use findData
+// and the ListIter functions instead
+
+List_p createOrderedList (const char* lname, int mode);
+// creates a list that keeps itself sorted: mode == SORT_ASCEND
+// or SORT_DESCEND. Every append/insert puts the data at its
+// sorted position, and finds, removes and keyed inserts take
+// O(log n) using skip list lanes over the nodes. Lists
+// holding payloads cannot be ordered
+
+int enableListFilter (List_p myList, int expected);
+// attaches a counting Bloom filter sized for about expected
+// items and adds every item already in the list. From then on
+// findData/findNode/removeData return NULL for most data that
+// is not in the list without walking it. The filter follows
+// every insert and remove and is rebuilt (bigger if needed)
+// when it gets inaccurate. Not for lists holding payloads.
+// Returns NO_ERROR, or INSERT_ERROR if it could not be created
+
+void disableListFilter (List_p myList);
+// drops the filter of myList, if any
+
+int getListFilterStats (List_p myList, FilterStats * stats);
+// fills stats for the filter of myList. Returns NO_ERROR, or
+// NOT_FOUND_ERROR if the list has no filter
+
+int setListInternTable (List_p myList, struct intern_table * table);
+// makes myList keep its strings in table (see d_internTable.h)
+// instead of a copy per node. Many lists can share a table, each
+// distinct string is then stored once however often it appears.
+// findData/findNode/removeData compare pointers instead of
+// strings, and the remove functions still hand back a string
+// of the caller's own. table == NULL goes back to copies.
+// Only for empty lists with node storage, returns NO_ERROR or
+// INSERT_ERROR. The table must outlive the list
+
+void listIterBegin (List_p myList, ListIter * iter);
+// positions iter before the first item of myList
+
+char * listIterNext (ListIter * iter);
+// returns the next item's data and advances, NULL at the end.
+// The list must not be changed while iterating. The cursor
+// prefetches the following node (chunk) while the caller is
+// busy with the current item. See d_listParallel.h for
+// parallel passes over a list
+
 char * toStringList (List_p myList, char * buff);
 // returns a string containing the list head information
 // including up to 20 characters of the list name
@@ -111,12 +208,12 @@ char * toStringList (List_p myList, char * buff);
 
 // CHANGED FUNCTION
 void printList (List_p myList, FILE * output, int * error);
-// First prints the list string returned by toStringList()
-// then iterates through the list calling toStringNode()
-// and prints each node's data
-// If output == NULL stdout is assumed
-// if an error is encountered the error value is set
-// to PRINT_ERROR
+// First prints the list information shown by toStringList()
+// then every node's data in the layout of toStringNode(),
+// without their length limits (see d_listWriter.h for other
+// formats). If output == NULL stdout is assumed
+// error is set to NO_ERROR, or to PRINT_ERROR if an error is
+// encountered
 
 
 //void printList (List_p myList, FILE* output);
@@ -134,6 +231,22 @@ int insertDataAtFront (List_p myList, const char * nodeData);
 // same as appendNode but puts the new node as the first item
 // in the list. Returns NO_ERROR on success.
 
+int appendDataAdopt (List_p myList, char * nodeData);
+int insertDataAtFrontAdopt (List_p myList, char * nodeData);
+// same as appendData/insertDataAtFront but nodeData must be a
+// string in the heap (malloc) and the list takes it over
+// instead of copying it. It is freed when the node is
+// destroyed, unless it is removed from the list first
+
+int appendPayload (List_p myList, void * payload, DataDestructor destroy);
+int insertPayloadAtFront (List_p myList, void * payload, DataDestructor destroy);
+// stores an arbitrary pointer (a struct, a handle...) in the
+// list without copying it. destroy is called on the payload
+// when the node is destroyed, pass NULL if the list must not
+// free it. The remove functions hand payloads back untouched.
+// Lists holding payloads must not be searched, sorted or
+// printed since those treat data as a string
+
 // NEW FUNCTION
 int insertDataWithKey (List_p mylist, const char * key, const char * nodeData, int mode);
 // Finds the node containing key, if it exists, and inserts
@@ -141,7 +254,10 @@ int insertDataWithKey (List_p mylist, const char * key, const char * nodeData, i
 // of mode. mode == INSERT_BEFORE causes the insertion to be
 // just before the found key, mode == INSERT_AFTER cause the
 // insertion just after the found key. If the key is not
-// found the function returns the NOT_FOUND_ERROR
+// found the function returns the NOT_FOUND_ERROR.
+// In an ordered list (createOrderedList) data that does not
+// belong at that position turns the list into an unordered
+// one. Unrolled lists return INSERT_ERROR
 
 
 // NEW FUNCTION
@@ -153,7 +269,21 @@ List_p sortList (List_p myList, int mode, int * error);
 // Sets error to NO_ERROR and returns the pointer to the new
 // list if successful. The original list is deleted
 // (deallocated) on success. Otherwise the error is set to
-// SORT_ERROR and the original pointer is returned
+// SORT_ERROR and the original pointer is returned.
+// A list already in the requested order is returned as is.
+// An ordered list (createOrderedList) stays ordered in the
+// new direction
+
+
+List_p mergeLists (List_p * lists, int k, int mode, int * error);
+// Merges the k lists in lists, each sorted in the order of mode
+// (SORT_ASCEND or SORT_DESCEND), into one sorted list in
+// O(n log k) by relinking their nodes (no data is copied).
+// Equal data keeps the order of the lists it came from. Sets
+// error to NO_ERROR and returns the merged list on success; the
+// input lists are deleted and their entries set to NULL.
+// Otherwise error is set to SORT_ERROR, NULL is returned and
+// the lists are left alone. Unrolled lists cannot be merged
 
 
 // NEW FUNCTION
@@ -172,7 +302,8 @@ char * removeDataFromHead (List_p myList);
 
 char * findData (List_p myList, const char * searchData);
 // finds the node containing the searchData and returns a
-// string containing the data without affecting the node
+// string containing the data without affecting the node.
+// Returns NULL if not found
 
 char * removeData (List_p myList, const char * searchData);
 // Finds and removes the node containing searchData if found
@@ -224,7 +355,9 @@ int readList (List_p myList, FILE * input, int mode);
 // Reads a file of text lines, each line a data object, and
 // fills the initialized myList. If mode == SORTED_ORDER the
 // list is ordered lexicographically (by insertion sort).
-// input contains a pointer to a file to be read.
+// input contains a pointer to a file to be read. The line
+// breaks are not stored. Give myList an intern table first
+// (setListInternTable) for files repeating the same lines
 
 char** insertion_sort_ascend(char**, int);
 //This function sorts a char array in accending order by insertion sort.
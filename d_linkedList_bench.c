@@ -0,0 +1,267 @@
+/*
+	d_linkedList_bench.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Benchmark of find and traverse over Lists of short strings, with the strings inside the
+	node (appendData, see NODE_INLINE_DATA in d_linkedList.h) against the strings in a block of their own
+	(appendDataAdopt, the layout every node had before), and of the same scans over the nodes against an
+	unrolled List (LIST_STORAGE_UNROLLED, see d_unrolledList.h), which packs the string pointers in chunks.
+
+	Each List holds n identifiers such as "proc-00001234" and is built three ways. "in order" builds it on a
+	fresh heap, so consecutive nodes and strings come out of malloc next to each other. "churned" first
+	allocates and frees blocks of both sizes in random order, as a long running program would, so the
+	nodes and their own string blocks land anywhere. Traverse reads every string through a ListIter;
+	find looks up random identifiers in the list (a hit scans half the list on average) and ones that
+	are not in it (a miss scans all of it). Times are per node visited, the best of BENCH_ROUNDS. Last,
+	drain takes every string back out with removeDataFromHead() and frees it, once (it empties the list):
+	an inline string is handed over in the node's own block, a separate one in its block. The "speedup"
+	row is separate over inline, the "unrolled" row inline over unrolled (the nodes at their best over
+	the chunks).
+
+	Build: gcc -std=gnu11 -O2 d_linkedList_bench.c d_linkedList.c d_unrolledList.c d_skipList.c d_bloomFilter.c
+	    d_internTable.c d_listWriter.c -o d_linkedList_bench
+	Execute: d_linkedList_bench [n ...]
+	    with no arguments n = 10^4, 10^5 and 10^6
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "d_linkedList.h"
+
+#define BENCH_ROUNDS 5
+#define BENCH_VISITS 20000000L	// nodes the finds of a round visit, about
+#define ID_LENGTH 14			// "proc-%08ld" and its terminator
+
+#define LAYOUT_INLINE 0
+#define LAYOUT_SEPARATE 1
+#define LAYOUT_UNROLLED 2
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+static double now (void) {
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+/************************************************************************************************************
+ * shuffle
+ *
+ * Synopsis: static void shuffle (void ** blocks, long n)
+ *
+ * Description: Puts blocks in random order (Fisher-Yates on rand()).
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void shuffle (void ** blocks, long n) {
+	void * t;
+	long i, j;
+
+	for (i = n - 1; i > 0; i--) {
+		j = ((long) rand() * RAND_MAX + rand()) % (i + 1);
+		t = blocks[i];
+		blocks[i] = blocks[j];
+		blocks[j] = t;
+	}
+}
+/************************************************************************************************************
+ * churnHeap
+ *
+ * Synopsis: static void ** churnHeap (long n)
+ *
+ * Description: Allocates 2n blocks the size of an inline node, of a node and of an identifier each, and
+ * frees half of them, picked at random, in random order. The blocks kept keep the holes apart, so malloc
+ * cannot merge them back into one region, and it hands them out again in an order of its own: what is
+ * allocated next is scattered over the whole region.
+ *
+ * Returns: The blocks kept, for freeHeap(), NULL if out of memory.
+ *
+ ************************************************************************************************************/
+static void ** churnHeap (long n) {
+	void ** blocks = (void **) malloc (sizeof(void *) * (size_t) n * 6);
+	long i;
+
+	if (blocks == NULL)
+		return NULL;
+	for (i = 0; i < 2 * n; i++) {
+		blocks[3 * i] = malloc(sizeof(Node) + ID_LENGTH);
+		blocks[3 * i + 1] = malloc(sizeof(Node));
+		blocks[3 * i + 2] = malloc(ID_LENGTH);
+	}
+	shuffle(blocks, n * 6);
+	for (i = n * 3; i < n * 6; i++)
+		free(blocks[i]);
+	return blocks;
+}
+
+static void freeHeap (void ** blocks, long n) {
+	long i;
+
+	if (blocks == NULL)
+		return;
+	for (i = 0; i < n * 3; i++)
+		free(blocks[i]);
+	free(blocks);
+}
+/************************************************************************************************************
+ * buildList
+ *
+ * Synopsis: static List_p buildList (long n, int layout)
+ *
+ * Description: Appends identifiers 0 .. n - 1 in order, copied into the nodes (LAYOUT_INLINE), handed
+ * over in blocks of their own (LAYOUT_SEPARATE) or copied into the chunks of an unrolled list
+ * (LAYOUT_UNROLLED).
+ *
+ * Returns: The list, NULL if it could not be built.
+ *
+ ************************************************************************************************************/
+static List_p buildList (long n, int layout) {
+	List_p list = createListWithStorage("bench", (layout == LAYOUT_UNROLLED) ? LIST_STORAGE_UNROLLED :
+		LIST_STORAGE_NODES);
+	char id[32];
+	long i;
+	int error = NO_ERROR;
+
+	for (i = 0; i < n && list != NULL && error == NO_ERROR; i++) {
+		snprintf(id, sizeof(id), "proc-%08ld", i);
+		if (layout == LAYOUT_SEPARATE)
+			error = appendDataAdopt(list, strdup(id));
+		else
+			error = appendData(list, id);
+	}
+	if (list != NULL && error != NO_ERROR) {
+		destroyList(list);
+		list = NULL;
+	}
+	return list;
+}
+/************************************************************************************************************
+ * traverse / find / drain
+ *
+ * Synopsis: static double traverse (List_p list, long n)
+ *
+ * Description: traverse() reads every string of the list in order; find() looks up identifiers picked
+ * at random below limit (limit > n gives misses) until about BENCH_VISITS nodes were visited. drain()
+ * removes and frees every string, once.
+ *
+ * Returns: The best time per node visited over BENCH_ROUNDS (drain: the time per node), in nanoseconds.
+ *
+ ************************************************************************************************************/
+static double traverse (List_p list, long n) {
+	ListIter iter;
+	char * data;
+	double best = 0, t;
+	long sum = 0;
+	int r;
+
+	for (r = 0; r < BENCH_ROUNDS; r++) {
+		t = now();
+		listIterBegin(list, &iter);
+		while ((data = listIterNext(&iter)) != NULL)
+			sum += data[ID_LENGTH - 2];
+		t = now() - t;
+		if (r == 0 || t < best)
+			best = t;
+	}
+	if (sum == 42)		// keeps the reads
+		printf(" ");
+	return best * 1e9 / n;
+}
+
+static double find (List_p list, long n, long limit) {
+	char id[32];
+	double best = 0, t;
+	long visits, found = 0;
+	long i;
+	int r;
+
+	for (r = 0; r < BENCH_ROUNDS; r++) {
+		srand(r + 1);
+		visits = 0;
+		t = now();
+		while (visits < BENCH_VISITS) {
+			i = ((long) rand() * RAND_MAX + rand()) % limit;
+			snprintf(id, sizeof(id), "proc-%08ld", i);
+			found += findData(list, id) != NULL;
+			visits += (i < n) ? i + 1 : n;
+		}
+		t = (now() - t) / visits;
+		if (r == 0 || t < best)
+			best = t;
+	}
+	if (found == 42)
+		printf(" ");
+	return best * 1e9;
+}
+
+static double drain (List_p list, long n) {
+	double t = now();
+	char * data;
+	long sum = 0;
+
+	while ((data = removeDataFromHead(list)) != NULL) {
+		sum += data[ID_LENGTH - 2];
+		free(data);
+	}
+	t = now() - t;
+	if (sum == 42)
+		printf(" ");
+	return t * 1e9 / n;
+}
+
+int main (int argc, char * argv[]) {
+	static const char * layouts[] = { "inline", "separate", "unrolled" };
+	static const long sizes[] = { 10000, 100000, 1000000 };
+	double ns[3][4];
+	List_p list;
+	void ** kept = NULL;
+	long n;
+	int a, churned, layout;
+
+	printf("%8s  %-8s  %-8s  %12s  %12s  %12s  %12s\n", "n", "heap", "strings", "traverse ns", "find hit ns",
+		"find miss ns", "drain ns");
+	for (a = 1; a < argc || (argc == 1 && a <= 3); a++) {
+		n = (argc > 1) ? atol(argv[a]) : sizes[a - 1];
+		if (n < 1) {
+			printf("usage: %s [n ...]\n", argv[0]);
+			return 2;
+		}
+		for (churned = 0; churned <= 1; churned++) {
+			for (layout = LAYOUT_INLINE; layout <= LAYOUT_UNROLLED; layout++) {
+				srand(1);
+				if (churned)
+					kept = churnHeap(n);
+				list = buildList(n, layout);
+				if (list == NULL) {
+					printf("out of memory for %ld items\n", n);
+					return 1;
+				}
+				ns[layout][0] = traverse(list, n);
+				ns[layout][1] = find(list, n, n);
+				ns[layout][2] = find(list, n, 2 * n);
+				ns[layout][3] = drain(list, n);
+				destroyList(list);
+				if (churned)
+					freeHeap(kept, n);
+				printf("%8ld  %-8s  %-8s  %12.2f  %12.2f  %12.2f  %12.2f\n", n, churned ? "churned" : "in order",
+					layouts[layout], ns[layout][0], ns[layout][1], ns[layout][2], ns[layout][3]);
+			}
+			printf("%8ld  %-8s  %-8s  %11.2fx  %11.2fx  %11.2fx  %11.2fx\n", n, churned ? "churned" : "in order",
+				"speedup", ns[1][0] / ns[0][0], ns[1][1] / ns[0][1], ns[1][2] / ns[0][2], ns[1][3] / ns[0][3]);
+			printf("%8ld  %-8s  %-8s  %11.2fx  %11.2fx  %11.2fx  %11.2fx\n", n, churned ? "churned" : "in order",
+				"unrolled", ns[0][0] / ns[2][0], ns[0][1] / ns[2][1], ns[0][2] / ns[2][2], ns[0][3] / ns[2][3]);
+		}
+	}
+	return 0;
+}
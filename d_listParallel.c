@@ -0,0 +1,275 @@
+/*
+	d_listParallel.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: d_listParallel.c implements listForEach, listFilter and listReduce over the segments of a
+	List. Every pass packs its arguments in a small job struct and runs one pool task per segment; a task
+	only reads the list and writes to the slot of the job that belongs to its segment, so no locking is
+	needed beyond what the pool does to hand out tasks.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "d_listParallel.h"
+
+/************************************************************************************************************
+ * createListSegments
+ *
+ * Synopsis: ListSegments_p createListSegments (List_p myList, int nsegments)
+ *
+ * Description: Walks the list once with a cursor and saves a copy of the cursor every count / nsegments
+ * items. The first count % nsegments segments get one item more than the others.
+ *
+ * Returns: A pointer to the segments in the heap, NULL if not successful.
+ *
+ ************************************************************************************************************/
+ListSegments_p createListSegments (List_p myList, int nsegments) {
+	ListSegments_p segments;
+	ListIter iter;
+	int i, j, base, extra;
+
+	if (myList == NULL)
+		return NULL;
+	if (nsegments <= 0)
+		nsegments = SEGMENTS_PER_THREAD * (int) sysconf(_SC_NPROCESSORS_ONLN);
+	if (nsegments > myList->count)
+		nsegments = myList->count;
+	if (nsegments <= 0)
+		nsegments = 1;
+
+	segments = (ListSegments_p) malloc (sizeof(ListSegments));
+	if (segments == NULL)
+		return NULL;
+	segments->starts = (ListIter *) malloc (sizeof(ListIter) * nsegments);
+	segments->lengths = (int *) malloc (sizeof(int) * nsegments);
+	if (segments->starts == NULL || segments->lengths == NULL) {
+		destroyListSegments(segments);
+		return NULL;
+	}
+	segments->list = myList;
+	segments->count = nsegments;
+
+	base = myList->count / nsegments;
+	extra = myList->count % nsegments;
+	listIterBegin(myList, &iter);
+	for (i = 0; i < nsegments; i++) {
+		segments->starts[i] = iter;
+		segments->lengths[i] = base + (i < extra ? 1 : 0);
+		for (j = 0; j < segments->lengths[i]; j++)
+			listIterNext(&iter);
+	}
+	return segments;
+}
+/************************************************************************************************************
+ * destroyListSegments
+ *
+ * Synopsis: void destroyListSegments (ListSegments_p segments)
+ *
+ * Description: Frees the segments; the list is left alone.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void destroyListSegments (ListSegments_p segments) {
+	if (segments == NULL)
+		return;
+	free(segments->starts);
+	free(segments->lengths);
+	free(segments);
+}
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ *	listForEach
+ *
+ *+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+typedef struct for_each_job {
+	ListSegments_p segments;
+	ListVisit visit;
+	void * arg;
+} ForEachJob;
+
+static void forEachTask (void * arg, int index) {
+	ForEachJob * job = (ForEachJob *) arg;
+	ListIter iter = job->segments->starts[index];
+	int n;
+
+	for (n = job->segments->lengths[index]; n > 0; n--)
+		job->visit(listIterNext(&iter), job->arg);
+}
+/************************************************************************************************************
+ * listForEach
+ *
+ * Synopsis: int listForEach (ListSegments_p segments, ThreadPool_p pool, ListVisit visit, void * arg)
+ *
+ * Description: Runs visit over every segment, one pool task per segment.
+ *
+ * Returns: The # of items visited.
+ *
+ ************************************************************************************************************/
+int listForEach (ListSegments_p segments, ThreadPool_p pool, ListVisit visit, void * arg) {
+	ForEachJob job;
+
+	if (segments == NULL || visit == NULL)
+		return 0;
+	job.segments = segments;
+	job.visit = visit;
+	job.arg = arg;
+	runPoolTasks(pool, forEachTask, &job, segments->count);
+	return segments->list->count;
+}
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ *	listFilter
+ *
+ *+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+typedef struct node_chain {	// the nodes one segment kept, linked but not yet in a list
+	Node_p first;
+	Node_p last;
+	int count;
+	int failed;
+} NodeChain;
+
+typedef struct filter_job {
+	ListSegments_p segments;
+	ListPredicate keep;
+	void * arg;
+	NodeChain * chains;		// one per segment
+} FilterJob;
+
+static void filterTask (void * arg, int index) {
+	FilterJob * job = (FilterJob *) arg;
+	NodeChain * chain = &job->chains[index];
+	ListIter iter = job->segments->starts[index];
+	char * data;
+	int n;
+
+	for (n = job->segments->lengths[index]; n > 0; n--) {
+		data = listIterNext(&iter);
+		if (!job->keep(data, job->arg))
+			continue;
+		Node_p newNode = createNode(data);
+		if (newNode == NULL) {
+			chain->failed = 1;
+			return;
+		}
+		newNode->prev = chain->last;
+		if (chain->last != NULL)
+			chain->last->next = newNode;
+		else
+			chain->first = newNode;
+		chain->last = newNode;
+		chain->count++;
+	}
+}
+/************************************************************************************************************
+ * listFilter
+ *
+ * Synopsis: List_p listFilter (ListSegments_p segments, ThreadPool_p pool, ListPredicate keep, void * arg,
+ *                              const char * lname)
+ *
+ * Description: Every segment copies the items keep() accepts into a chain of new nodes; the chains are
+ * then spliced into the new list in segment order, which keeps the original order. A subset of a sorted
+ * list is sorted in the same direction, so the order code is carried over (the skip list lanes of an
+ * ordered list are not).
+ *
+ * Returns: The new list, NULL if not successful.
+ *
+ ************************************************************************************************************/
+List_p listFilter (ListSegments_p segments, ThreadPool_p pool, ListPredicate keep, void * arg,
+		const char * lname) {
+	FilterJob job;
+	List_p filtered;
+	int i, failed = 0;
+
+	if (segments == NULL || keep == NULL)
+		return NULL;
+	job.segments = segments;
+	job.keep = keep;
+	job.arg = arg;
+	job.chains = (NodeChain *) calloc (segments->count, sizeof(NodeChain));
+	if (job.chains == NULL)
+		return NULL;
+	runPoolTasks(pool, filterTask, &job, segments->count);
+
+	filtered = createList(lname);
+	for (i = 0; i < segments->count; i++) {
+		NodeChain * chain = &job.chains[i];
+		failed |= chain->failed;
+		if (chain->first == NULL)
+			continue;
+		chain->first->prev = filtered->last;
+		if (filtered->last != NULL)
+			filtered->last->next = chain->first;
+		else
+			filtered->first = chain->first;
+		filtered->last = chain->last;
+		filtered->count += chain->count;
+	}
+	free(job.chains);
+	if (failed) {
+		if (destroyList(filtered) != NO_ERROR) {	// an empty list is not destroyed by destroyList
+			free(filtered->listName);
+			free(filtered);
+		}
+		return NULL;
+	}
+	filtered->order = segments->list->order;
+	return filtered;
+}
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ *	listReduce
+ *
+ *+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+typedef struct reduce_job {
+	ListSegments_p segments;
+	ListStep step;
+	char * parts;			// one accumulator of accSize bytes per segment
+	size_t stride;
+} ReduceJob;
+
+static void reduceTask (void * arg, int index) {
+	ReduceJob * job = (ReduceJob *) arg;
+	void * acc = job->parts + job->stride * index;
+	ListIter iter = job->segments->starts[index];
+	int n;
+
+	for (n = job->segments->lengths[index]; n > 0; n--)
+		job->step(acc, listIterNext(&iter));
+}
+/************************************************************************************************************
+ * listReduce
+ *
+ * Synopsis: int listReduce (ListSegments_p segments, ThreadPool_p pool, ListStep step, ListCombine combine,
+ *                           void * acc, size_t accSize)
+ *
+ * Description: Gives every segment its own copy of the initial accumulator, each on its own cache lines so
+ * the threads do not false share while they fold, then combines the partial results into acc.
+ *
+ * Returns: The # of items folded, -1 if the partial results could not be allocated.
+ *
+ ************************************************************************************************************/
+int listReduce (ListSegments_p segments, ThreadPool_p pool, ListStep step, ListCombine combine,
+		void * acc, size_t accSize) {
+	ReduceJob job;
+	int i;
+
+	if (segments == NULL || step == NULL || combine == NULL || acc == NULL)
+		return 0;
+	job.segments = segments;
+	job.step = step;
+	job.stride = (accSize + 63) & ~(size_t) 63;
+	if (job.stride == 0)
+		job.stride = 64;
+	job.parts = (char *) aligned_alloc (64, job.stride * segments->count);
+	if (job.parts == NULL)
+		return -1;
+	for (i = 0; i < segments->count; i++)
+		memcpy(job.parts + job.stride * i, acc, accSize);
+	runPoolTasks(pool, reduceTask, &job, segments->count);
+	for (i = 0; i < segments->count; i++)
+		combine(acc, job.parts + job.stride * i);
+	free(job.parts);
+	return segments->list->count;
+}
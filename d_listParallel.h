@@ -0,0 +1,77 @@
+/*
+	d_listParallel.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: Header file for the parallel list passes.
+
+	d_listParallel.c runs a function over every item of a List on the threads of a ThreadPool. The list is
+	cut once into segments of about the same # of items (createListSegments walks it a single time and
+	remembers a cursor at the start of each segment); every pass then hands one segment per task to the
+	pool, so a linked list of 10^7 items is walked in parallel without any thread first skipping to its
+	part. Build more segments than threads so a slow segment does not hold up the whole pass.
+
+	The list must not change while segments of it exist. The callbacks run concurrently and must not
+	change the list either.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _D_LISTPARALLEL_H_
+#define _D_LISTPARALLEL_H_
+
+#include <stddef.h>
+
+#include "d_linkedList.h"
+#include "thread_pool.h"
+
+#define SEGMENTS_PER_THREAD 4	// default # of segments per pool thread
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct list_segments {
+	List_p list;
+	int count;				// # of segments
+	ListIter * starts;		// cursor at the first item of each segment
+	int * lengths;			// # of items in each segment
+} ListSegments;
+
+typedef ListSegments * ListSegments_p;
+
+typedef void (*ListVisit)(char * data, void * arg);			// called on an item by listForEach
+typedef int (*ListPredicate)(const char * data, void * arg);	// non-zero keeps the item in listFilter
+typedef void (*ListStep)(void * acc, const char * data);		// folds an item into a partial result
+typedef void (*ListCombine)(void * acc, const void * part);	// folds a segment's result into acc
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+ListSegments_p createListSegments (List_p myList, int nsegments);
+// cuts myList into nsegments runs of consecutive items in a
+// single walk (nsegments <= 0: SEGMENTS_PER_THREAD per online
+// CPU). Returns NULL if not successful
+
+void destroyListSegments (ListSegments_p segments);
+
+int listForEach (ListSegments_p segments, ThreadPool_p pool, ListVisit visit, void * arg);
+// calls visit(data, arg) on every item, segments in parallel.
+// A NULL pool runs on the calling thread. Returns the # of
+// items visited
+
+List_p listFilter (ListSegments_p segments, ThreadPool_p pool, ListPredicate keep, void * arg,
+	const char * lname);
+// returns a new list (named lname) with a copy of every item
+// keep() accepts, in the order of the original list. A sorted
+// list gives a sorted result. NULL if not successful
+
+int listReduce (ListSegments_p segments, ThreadPool_p pool, ListStep step, ListCombine combine,
+	void * acc, size_t accSize);
+// every segment starts from a copy of the accSize bytes at acc
+// (so acc must hold the identity: 0 for a count, an empty
+// histogram...), folds its items in with step, and the partial
+// results are then folded into acc with combine, in segment
+// order. Returns the # of items, -1 if out of memory
+
+#endif
@@ -0,0 +1,281 @@
+/*
+	d_listSnapshot.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: d_listSnapshot.c writes List snapshots and reads them back through read-only memory mappings
+	(see d_listSnapshot.h for the layout). Saving walks the list twice with a cursor: once to write the
+	offset table, once to write the strings, so no copy of the list is built in memory.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "d_listSnapshot.h"
+
+#define SNAPSHOT_IO_BUFFER (1 << 20)
+
+/************************************************************************************************************
+ * saveListSnapshot
+ *
+ * Synopsis: int saveListSnapshot (List_p myList, const char * path)
+ *
+ * Description: Writes the header, then the offset of every item (the list name takes the first bytes of
+ * the heap), then the strings, to path.tmp, and renames it to path once everything was written and
+ * flushed to disk.
+ *
+ * Returns: NO_ERROR, or PRINT_ERROR.
+ *
+ ************************************************************************************************************/
+int saveListSnapshot (List_p myList, const char * path) {
+	SnapshotHeader header;
+	ListIter iter;
+	const char * name;
+	char * data;
+	char * tmpPath;
+	FILE * output;
+	uint64_t offset;
+	int error = 0;
+
+	if (myList == NULL || path == NULL)
+		return PRINT_ERROR;
+	tmpPath = (char *) malloc (strlen(path) + 5);
+	if (tmpPath == NULL)
+		return PRINT_ERROR;
+	sprintf(tmpPath, "%s.tmp", path);
+	output = fopen(tmpPath, "wb");
+	if (output == NULL) {
+		free(tmpPath);
+		return PRINT_ERROR;
+	}
+	setvbuf(output, NULL, _IOFBF, SNAPSHOT_IO_BUFFER);
+	name = (myList->listName != NULL) ? myList->listName : "";
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	header.version = SNAPSHOT_VERSION;
+	header.byteOrder = SNAPSHOT_BYTE_ORDER;
+	header.count = (uint64_t) myList->count;
+	header.offsetsPos = sizeof(SnapshotHeader);
+	header.heapPos = header.offsetsPos + header.count * sizeof(uint64_t);
+	header.order = myList->order;
+
+	// offset table, the heap size falls out of it
+	if (fseeko(output, (off_t) header.offsetsPos, SEEK_SET) != 0)
+		error = 1;
+	offset = strlen(name) + 1;
+	listIterBegin(myList, &iter);
+	while (!error && (data = listIterNext(&iter)) != NULL) {
+		if (fwrite(&offset, sizeof(offset), 1, output) != 1)
+			error = 1;
+		offset += strlen(data) + 1;
+	}
+	header.heapSize = offset;
+
+	// string heap
+	if (!error && fwrite(name, strlen(name) + 1, 1, output) != 1)
+		error = 1;
+	listIterBegin(myList, &iter);
+	while (!error && (data = listIterNext(&iter)) != NULL)
+		if (fwrite(data, strlen(data) + 1, 1, output) != 1)
+			error = 1;
+
+	// the header last, so a file cut short never looks complete
+	if (!error && (fseeko(output, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, output) != 1))
+		error = 1;
+	// on disk before the rename, or a crash could leave path naming a file whose data never got there
+	if (!error && (fflush(output) != 0 || fsync(fileno(output)) != 0))
+		error = 1;
+	if (fclose(output) != 0)
+		error = 1;
+	if (!error && rename(tmpPath, path) != 0)
+		error = 1;
+	if (error)
+		remove(tmpPath);
+	free(tmpPath);
+	return error ? PRINT_ERROR : NO_ERROR;
+}
+/************************************************************************************************************
+ * openListView
+ *
+ * Synopsis: ListView_p openListView (const char * path)
+ *
+ * Description: Maps the file and checks the header: magic, version, byte order, and that the offset table
+ * and the heap lie inside the file with the heap ending in '\0'. The items themselves are not touched, so
+ * opening takes the same time for any size of list; an offset is checked when its item is read.
+ *
+ * Returns: A pointer to the view in the heap, NULL if not successful.
+ *
+ ************************************************************************************************************/
+ListView_p openListView (const char * path) {
+	const SnapshotHeader * header;
+	ListView_p view;
+	struct stat st;
+	void * base;
+	int fd;
+
+	if (path == NULL || (fd = open(path, O_RDONLY)) < 0)
+		return NULL;
+	if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(SnapshotHeader)) {
+		close(fd);
+		return NULL;
+	}
+	base = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED)
+		return NULL;
+
+	header = (const SnapshotHeader *) base;
+	if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+			header->version != SNAPSHOT_VERSION || header->byteOrder != SNAPSHOT_BYTE_ORDER ||
+			header->count > INT32_MAX ||
+			header->offsetsPos != sizeof(SnapshotHeader) ||
+			header->heapPos != header->offsetsPos + header->count * sizeof(uint64_t) ||
+			header->heapPos > (uint64_t) st.st_size || header->heapSize == 0 ||
+			header->heapSize > (uint64_t) st.st_size - header->heapPos ||
+			((const char *) base)[header->heapPos + header->heapSize - 1] != '\0') {
+		munmap(base, (size_t) st.st_size);
+		return NULL;
+	}
+
+	view = (ListView_p) malloc (sizeof(ListView));
+	if (view == NULL) {
+		munmap(base, (size_t) st.st_size);
+		return NULL;
+	}
+	view->base = (const char *) base;
+	view->size = (size_t) st.st_size;
+	view->offsets = (const uint64_t *) (view->base + header->offsetsPos);
+	view->heap = view->base + header->heapPos;
+	view->heapSize = header->heapSize;
+	view->count = (int) header->count;
+	view->order = (short) header->order;
+	view->listName = view->heap;
+	return view;
+}
+/************************************************************************************************************
+ * closeListView
+ *
+ * Synopsis: void closeListView (ListView_p view)
+ *
+ * Description: Unmaps the file and frees the view.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void closeListView (ListView_p view) {
+	if (view == NULL)
+		return;
+	munmap((void *) view->base, view->size);
+	free(view);
+}
+/************************************************************************************************************
+ * sizeListView / getViewOrder
+ *
+ * Synopsis: int sizeListView (ListView_p view)
+ *
+ * Description: Status functions of a view.
+ *
+ * Returns: The # of items (the order code), NOT_FOUND if view is NULL.
+ *
+ ************************************************************************************************************/
+int sizeListView (ListView_p view) {
+	return (view != NULL) ? view->count : NOT_FOUND;
+}
+
+int getViewOrder (ListView_p view) {
+	return (view != NULL) ? view->order : NOT_FOUND;
+}
+/************************************************************************************************************
+ * getViewData
+ *
+ * Synopsis: const char * getViewData (ListView_p view, int i)
+ *
+ * Description: Looks item i up in the offset table. Since the heap ends in '\0', any offset inside it
+ * gives a terminated string.
+ *
+ * Returns: The item, NULL if i or its offset is out of range.
+ *
+ ************************************************************************************************************/
+const char * getViewData (ListView_p view, int i) {
+	if (view == NULL || i < 0 || i >= view->count || view->offsets[i] >= view->heapSize)
+		return NULL;
+	return view->heap + view->offsets[i];
+}
+/************************************************************************************************************
+ * findDataView
+ *
+ * Synopsis: const char * findDataView (ListView_p view, const char * searchData)
+ *
+ * Description: For a view saved in ascending (descending) order, a binary search for the first item not
+ * before searchData in that order; otherwise a scan of the items.
+ *
+ * Returns: The first item equal to searchData, NULL if not found.
+ *
+ ************************************************************************************************************/
+const char * findDataView (ListView_p view, const char * searchData) {
+	const char * data;
+	int lo, hi, mid, cmp;
+
+	if (view == NULL || searchData == NULL)
+		return NULL;
+	if (view->order == NO_ORDER) {
+		for (lo = 0; lo < view->count; lo++)
+			if ((data = getViewData(view, lo)) != NULL && !strcmp(data, searchData))
+				return data;
+		return NULL;
+	}
+
+	lo = 0;
+	hi = view->count;
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if ((data = getViewData(view, mid)) == NULL)
+			return NULL;
+		cmp = strcmp(data, searchData);
+		if (view->order == DESCEND_ORDER)
+			cmp = -cmp;
+		if (cmp < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	data = getViewData(view, lo);
+	return (data != NULL && !strcmp(data, searchData)) ? data : NULL;
+}
+/************************************************************************************************************
+ * promoteListView
+ *
+ * Synopsis: List_p promoteListView (ListView_p view)
+ *
+ * Description: Copies the view into a new List. The view is already in list order, so the items are
+ * appended as they come and the saved order code is restored at the end.
+ *
+ * Returns: The new list, NULL if not successful.
+ *
+ ************************************************************************************************************/
+List_p promoteListView (ListView_p view) {
+	List_p myList;
+	const char * data;
+	int i;
+
+	if (view == NULL)
+		return NULL;
+	myList = createList(view->listName);
+	for (i = 0; i < view->count; i++) {
+		if ((data = getViewData(view, i)) == NULL || appendData(myList, data) != NO_ERROR) {
+			if (destroyList(myList) != NO_ERROR) {	// an empty list is not destroyed by destroyList
+				free(myList->listName);
+				free(myList);
+			}
+			return NULL;
+		}
+	}
+	myList->order = view->order;
+	return myList;
+}
@@ -0,0 +1,101 @@
+/*
+	d_listSnapshot.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: Header file for List snapshots and read-only list views.
+
+	A snapshot is a binary file holding the items of a List so it can be opened again without parsing
+	text. The file is laid out so that it can be used right where it is mapped in memory:
+
+	+----------------+---------------------------+------------------------------------------+
+	| SnapshotHeader | offset table              | string heap                              |
+	| magic, count,  | count x uint64_t, offset  | list name \0 item 0 \0 item 1 \0 ...     |
+	| order, ...     | of item i in the heap     |                                          |
+	+----------------+---------------------------+------------------------------------------+
+
+	openListView() maps the file and only checks the header, so it costs the same for ten items or ten
+	million. The view answers traversal, getViewData and findDataView (a binary search when the list was
+	saved sorted); promoteListView() turns it into an ordinary List once it has to change. Numbers are in
+	the byte order of the machine that saved the file, a file from another byte order is refused.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _D_LISTSNAPSHOT_H_
+#define _D_LISTSNAPSHOT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "d_linkedList.h"
+
+#define SNAPSHOT_MAGIC "DLLSNAP"		// 7 characters and the '\0' fill the magic field
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_BYTE_ORDER 0x01020304u	// reads differently on a machine of the other byte order
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct snapshot_header {	// 64 bytes at the start of the file
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint64_t count;				// # of items
+	uint64_t offsetsPos;		// file position of the offset table
+	uint64_t heapPos;			// file position of the string heap
+	uint64_t heapSize;			// bytes in the heap, the last one is always '\0'
+	int32_t order;				// NO_ORDER, ASCEND_ORDER or DESCEND_ORDER
+	uint32_t reserved[3];
+} SnapshotHeader;
+
+typedef struct list_view {
+	const char * base;			// the mapping
+	size_t size;				// # of bytes mapped
+	const uint64_t * offsets;	// points into the mapping
+	const char * heap;			// points into the mapping
+	uint64_t heapSize;
+	int count;
+	short order;
+	const char * listName;		// first string of the heap
+} ListView;
+
+typedef ListView * ListView_p;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+int saveListSnapshot (List_p myList, const char * path);
+// writes every item of myList to a snapshot at path. The file
+// is written under a temporary name and renamed, so path holds
+// either the old or the new snapshot. Returns NO_ERROR, or
+// PRINT_ERROR if the file could not be written
+
+ListView_p openListView (const char * path);
+// maps the snapshot at path read-only. Returns NULL if the file
+// cannot be opened or is not a valid snapshot
+
+void closeListView (ListView_p view);
+// unmaps the snapshot; strings returned by the view are gone
+
+int sizeListView (ListView_p view);
+// returns the # of items, NOT_FOUND if view is NULL
+
+int getViewOrder (ListView_p view);
+// returns the order code the list had when it was saved
+
+const char * getViewData (ListView_p view, int i);
+// returns item i (0 is the first), NULL if i is out of range.
+// Iterate with i = 0 .. sizeListView(view) - 1
+
+const char * findDataView (ListView_p view, const char * searchData);
+// returns the first item equal to searchData, NULL if not found.
+// O(log n) if the list was saved sorted, else a scan
+
+List_p promoteListView (ListView_p view);
+// returns a new, mutable List with the name, items and order
+// of the view. The view stays open and unchanged. NULL if not
+// successful
+
+#endif
@@ -0,0 +1,375 @@
+/*
+	d_listWriter.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: d_listWriter.c implements the streaming list serializers. A Writer collects output in a
+	LIST_WRITE_BUFFER byte buffer and flushes it to a FILE or a file descriptor when full. Items are
+	appended with memcpy() runs: for CSV and JSON lines only the characters that need escaping break a
+	run, so most items are copied in one piece.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "d_listWriter.h"
+#include "d_unrolledList.h"
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct writer {
+	char * buffer;
+	size_t used;
+	FILE * output;			// where the buffer goes, or
+	int fd;					// (when output is NULL)
+	int error;				// set once a write failed, later output is dropped
+} Writer;
+
+/************************************************************************************************************
+ * flushWriter
+ *
+ * Synopsis: static void flushWriter (Writer * w)
+ *
+ * Description: Sends the buffered bytes out, retrying short writes on a descriptor.
+ *
+ * Returns: Nothing (void), w->error is set if the write failed.
+ *
+ ************************************************************************************************************/
+static void flushWriter (Writer * w) {
+	size_t done = 0;
+
+	if (w->used == 0 || w->error) {
+		w->used = 0;
+		return;
+	}
+	if (w->output != NULL) {
+		if (fwrite(w->buffer, 1, w->used, w->output) != w->used)
+			w->error = 1;
+	} else {
+		while (done < w->used) {
+			ssize_t n = write(w->fd, w->buffer + done, w->used - done);
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n <= 0) {
+				w->error = 1;
+				break;
+			}
+			done += (size_t) n;
+		}
+	}
+	w->used = 0;
+}
+/************************************************************************************************************
+ * put
+ *
+ * Synopsis: static void put (Writer * w, const char * data, size_t length)
+ *
+ * Description: Appends length bytes to the buffer, flushing as often as needed.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void put (Writer * w, const char * data, size_t length) {
+	while (length > 0) {
+		size_t room = LIST_WRITE_BUFFER - w->used;
+		size_t n = (length < room) ? length : room;
+
+		memcpy(w->buffer + w->used, data, n);
+		w->used += n;
+		data += n;
+		length -= n;
+		if (w->used == LIST_WRITE_BUFFER)
+			flushWriter(w);
+	}
+}
+
+static void putString (Writer * w, const char * data) {
+	put(w, data, strlen(data));
+}
+
+#define putLiteral(w, text) put(w, text, sizeof(text) - 1)
+/************************************************************************************************************
+ * putLine
+ *
+ * Synopsis: static void putLine (Writer * w, const char * data)
+ *
+ * Description: Appends data and a line break. When both fit in the buffer they are stored straight into
+ * it, with one length scan and one copy; only a line crossing the end of the buffer goes through put().
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void putLine (Writer * w, const char * data) {
+	size_t length = strlen(data);
+
+	if (length < LIST_WRITE_BUFFER - w->used) {
+		memcpy(w->buffer + w->used, data, length);
+		w->buffer[w->used + length] = '\n';
+		w->used += length + 1;
+		if (w->used == LIST_WRITE_BUFFER)
+			flushWriter(w);
+		return;
+	}
+	put(w, data, length);
+	put(w, "\n", 1);
+}
+/************************************************************************************************************
+ * putCSV
+ *
+ * Synopsis: static void putCSV (Writer * w, const char * data)
+ *
+ * Description: Writes data as a CSV field. A field holding a comma, a quote or a line break is quoted and
+ * its quotes doubled; any other field is written as is.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void putCSV (Writer * w, const char * data) {
+	size_t length = strlen(data);
+	const char * run = data;
+	const char * quote;
+
+	if (strcspn(data, ",\"\r\n") == length) {
+		put(w, data, length);
+		return;
+	}
+	put(w, "\"", 1);
+	while ((quote = strchr(run, '"')) != NULL) {
+		put(w, run, (size_t) (quote - run) + 1);
+		put(w, "\"", 1);
+		run = quote + 1;
+	}
+	putString(w, run);
+	put(w, "\"", 1);
+}
+/************************************************************************************************************
+ * putJSON
+ *
+ * Synopsis: static void putJSON (Writer * w, const char * data)
+ *
+ * Description: Writes data as a JSON string: quotes, backslashes and control characters are escaped,
+ * every other byte (UTF-8 included) is copied as is. An item is escaped straight into the buffer when
+ * even its worst case (every byte a \u00XX) fits, otherwise piece by piece through put().
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void putJSON (Writer * w, const char * data) {
+	static const char hex[] = "0123456789abcdef";
+	const unsigned char * p = (const unsigned char *) data;
+	const unsigned char * run = p;
+	size_t worst = 6 * strlen(data) + 2;
+	char escape[7];
+
+	if (worst > LIST_WRITE_BUFFER - w->used)
+		flushWriter(w);
+	if (worst <= LIST_WRITE_BUFFER - w->used) {
+		char * out = w->buffer + w->used;
+		*out++ = '"';
+		for (; *p; p++) {
+			if (*p >= 0x20 && *p != '"' && *p != '\\') {
+				*out++ = (char) *p;
+				continue;
+			}
+			*out++ = '\\';
+			switch (*p) {
+				case '"': *out++ = '"'; break;
+				case '\\': *out++ = '\\'; break;
+				case '\n': *out++ = 'n'; break;
+				case '\r': *out++ = 'r'; break;
+				case '\t': *out++ = 't'; break;
+				default:
+					memcpy(out, "u00", 3);
+					out[3] = hex[*p >> 4];
+					out[4] = hex[*p & 15];
+					out += 5;
+			}
+		}
+		*out++ = '"';
+		w->used = (size_t) (out - w->buffer);
+		return;
+	}
+
+	put(w, "\"", 1);
+	for (; *p; p++) {
+		if (*p >= 0x20 && *p != '"' && *p != '\\')
+			continue;
+		put(w, (const char *) run, (size_t) (p - run));
+		run = p + 1;
+		switch (*p) {
+			case '"': put(w, "\\\"", 2); break;
+			case '\\': put(w, "\\\\", 2); break;
+			case '\n': put(w, "\\n", 2); break;
+			case '\r': put(w, "\\r", 2); break;
+			case '\t': put(w, "\\t", 2); break;
+			default:
+				memcpy(escape, "\\u00", 4);
+				escape[4] = hex[*p >> 4];
+				escape[5] = hex[*p & 15];
+				put(w, escape, 6);
+		}
+	}
+	put(w, (const char *) run, (size_t) (p - run));
+	put(w, "\"", 1);
+}
+/************************************************************************************************************
+ * writeItems
+ *
+ * Synopsis: static int writeItems (List_p myList, Writer * w, int format)
+ *
+ * Description: Walks the list with a cursor and writes every item in format, then flushes. RAW, the
+ * format for large dumps, walks the nodes (chunks) itself instead, one putLine() per item.
+ *
+ * Returns: NO_ERROR, or PRINT_ERROR on a bad format or a failed write.
+ *
+ ************************************************************************************************************/
+static int writeItems (List_p myList, Writer * w, int format) {
+	ListIter iter;
+	Node_p node;
+	Chunk_p chunk;
+	char * data;
+	int i = 0;
+
+	if (format < LIST_FORMAT_RAW || format > LIST_FORMAT_NODES)
+		return PRINT_ERROR;
+	if (format == LIST_FORMAT_RAW) {
+		for (node = myList->first; node != NULL; node = node->next) {
+			LIST_PREFETCH(node->next);
+			putLine(w, node->data);
+		}
+		for (chunk = myList->firstChunk; chunk != NULL; chunk = chunk->next)
+			for (i = 0; i < chunk->used; i++)
+				putLine(w, chunk->slots[i]);
+		flushWriter(w);
+		return w->error ? PRINT_ERROR : NO_ERROR;
+	}
+	listIterBegin(myList, &iter);
+	while ((data = listIterNext(&iter)) != NULL) {
+		switch (format) {
+			case LIST_FORMAT_CSV:
+				putCSV(w, data);
+				put(w, "\r\n", 2);
+				break;
+			case LIST_FORMAT_JSONL:
+				putJSON(w, data);
+				put(w, "\n", 1);
+				break;
+			case LIST_FORMAT_NODES:
+				putLiteral(w, "\nNODE: ");
+				putString(w, data);
+				if (i > 0)
+					putLiteral(w, "\nHAS PRIOR\n");
+				else
+					putLiteral(w, "\nNO PRIOR\n");
+				if (i < myList->count - 1)
+					putLiteral(w, "HAS NEXT\n");
+				else
+					putLiteral(w, "NO NEXT - End of List\n");
+				break;
+		}
+		i++;
+	}
+	flushWriter(w);
+	return w->error ? PRINT_ERROR : NO_ERROR;
+}
+/************************************************************************************************************
+ * writeList
+ *
+ * Synopsis: int writeList (List_p myList, FILE * output, int format)
+ *
+ * Description: Writes every item of the list to output through a Writer. Whatever output already had
+ * buffered is flushed first so the order of the output is kept.
+ *
+ * Returns: NO_ERROR, or PRINT_ERROR.
+ *
+ ************************************************************************************************************/
+int writeList (List_p myList, FILE * output, int format) {
+	Writer w;
+	int ret;
+
+	if (myList == NULL)
+		return PRINT_ERROR;
+	if (output == NULL)
+		output = stdout;
+	w.buffer = (char *) malloc (LIST_WRITE_BUFFER);
+	if (w.buffer == NULL)
+		return PRINT_ERROR;
+	w.used = 0;
+	w.output = output;
+	w.fd = -1;
+	w.error = 0;
+	fflush(output);
+	ret = writeItems(myList, &w, format);
+	free(w.buffer);
+	return ret;
+}
+/************************************************************************************************************
+ * writeListFd
+ *
+ * Synopsis: int writeListFd (List_p myList, int fd, int format)
+ *
+ * Description: Same as writeList with write(2) on a descriptor.
+ *
+ * Returns: NO_ERROR, or PRINT_ERROR.
+ *
+ ************************************************************************************************************/
+int writeListFd (List_p myList, int fd, int format) {
+	Writer w;
+	int ret;
+
+	if (myList == NULL || fd < 0)
+		return PRINT_ERROR;
+	w.buffer = (char *) malloc (LIST_WRITE_BUFFER);
+	if (w.buffer == NULL)
+		return PRINT_ERROR;
+	w.used = 0;
+	w.output = NULL;
+	w.fd = fd;
+	w.error = 0;
+	ret = writeItems(myList, &w, format);
+	free(w.buffer);
+	return ret;
+}
+/************************************************************************************************************
+ * writeListHeader
+ *
+ * Synopsis: int writeListHeader (List_p myList, FILE * output)
+ *
+ * Description: Writes the list name, the # of items and the first and last item, in the layout of
+ * toStringList().
+ *
+ * Returns: NO_ERROR, or PRINT_ERROR.
+ *
+ ************************************************************************************************************/
+int writeListHeader (List_p myList, FILE * output) {
+	ListIter iter;
+	char * first;
+	char * last = NULL;
+
+	if (myList == NULL)
+		return PRINT_ERROR;
+	if (output == NULL)
+		output = stdout;
+	listIterBegin(myList, &iter);
+	first = listIterNext(&iter);
+	if (myList->storage == LIST_STORAGE_UNROLLED)
+		last = (myList->lastChunk != NULL) ? myList->lastChunk->slots[myList->lastChunk->used - 1] : NULL;
+	else
+		last = (myList->last != NULL) ? myList->last->data : NULL;
+
+	fprintf(output, "\nList name: %s\nItems in list: %d\n", myList->listName ? myList->listName : "",
+		myList->count);
+	if (first != NULL)
+		fprintf(output, "First: %s\n", first);
+	else
+		fputs("NO FIRST\n", output);
+	if (last != NULL)
+		fprintf(output, "Last: %s\n", last);
+	else
+		fputs("NO LAST\n", output);
+	return ferror(output) ? PRINT_ERROR : NO_ERROR;
+}
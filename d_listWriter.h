@@ -0,0 +1,48 @@
+/*
+	d_listWriter.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: Header file for the list serializers.
+
+	d_listWriter.c dumps the items of a List to a FILE or a file descriptor. Every item is copied exactly
+	once, straight into one large output buffer (escaped on the way for CSV and JSON lines), and the
+	buffer goes out with a single fwrite()/write() whenever it fills up. Nothing is truncated, however
+	long an item is. printList() is written on top of it.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _D_LISTWRITER_H_
+#define _D_LISTWRITER_H_
+
+#include <stdio.h>
+
+#include "d_linkedList.h"
+
+// output formats
+#define LIST_FORMAT_RAW 0		// the data of every item followed by a line break
+#define LIST_FORMAT_CSV 1		// one field per line, quoted (RFC 4180) when it has to be
+#define LIST_FORMAT_JSONL 2		// one JSON string per line
+#define LIST_FORMAT_NODES 3		// the NODE: / HAS PRIOR / HAS NEXT layout of toStringNode()
+
+#define LIST_WRITE_BUFFER 65536	// bytes collected before each write
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+int writeList (List_p myList, FILE * output, int format);
+// writes every item of myList to output (stdout if NULL) in
+// format. Returns NO_ERROR, or PRINT_ERROR on a bad format or
+// a failed write. Lists holding payloads cannot be written
+
+int writeListFd (List_p myList, int fd, int format);
+// same as writeList on a file descriptor, bypassing stdio
+
+int writeListHeader (List_p myList, FILE * output);
+// writes what toStringList() shows (name, count, first and
+// last item) without its length limits. Returns NO_ERROR or
+// PRINT_ERROR
+
+#endif
@@ -0,0 +1,213 @@
+/*
+	d_listWriter_bench.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Benchmark of dumping a large List, the way printList() did it before d_listWriter.c against
+	the streaming serializers.
+
+	"old printList" is the loop printList() had, copied below with toStringNode() as it was: every node is
+	sprintf()ed, strncpy()ed and strcat()ed into a buffer and written to the output, then formatted again
+	and echoed to stdout (here /dev/null, the cheapest stdout there is). The only change is a buffer large
+	enough for the longest item, where the old one overflowed. It is timed against printList() as it is
+	now (the same text, byte for byte, written once) and the RAW format through a FILE (writeList) and on
+	the descriptor (writeListFd). Every dump goes to /dev/null, which costs the formatting alone, and to a
+	regular file, which adds the copy into the page cache; the "write() floor" is that copy alone, the
+	RAW text written in one call. Times are the best of BENCH_ROUNDS.
+
+	Build: gcc -std=gnu11 -O2 d_listWriter_bench.c d_linkedList.c d_unrolledList.c d_skipList.c
+	    d_bloomFilter.c d_internTable.c d_listWriter.c -o d_listWriter_bench
+	Execute: d_listWriter_bench [lines]
+	    with no arguments lines = 10^6
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "d_linkedList.h"
+#include "d_listWriter.h"
+
+#define BENCH_LINES 1000000
+#define BENCH_ROUNDS 3
+#define OLD_BUFFER_SIZE (MAX_CHARS_DATA + 64)	// toStringNode() output of the longest item
+
+#define DUMP_OLD 0				// the old printList()
+#define DUMP_PRINT 1			// printList(), on writeList in LIST_FORMAT_NODES
+#define DUMP_NODES_FD 2			// writeListFd, LIST_FORMAT_NODES
+#define DUMP_RAW 3				// writeList, LIST_FORMAT_RAW
+#define DUMP_RAW_FD 4			// writeListFd, LIST_FORMAT_RAW
+#define DUMP_FLOOR 5			// one write() of the RAW text made beforehand
+#define DUMPS 6
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+static double now (void) {
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+/************************************************************************************************************
+ * oldToStringNode / oldPrintList
+ *
+ * Synopsis: static void oldPrintList (List_p myList, FILE * output, FILE * echo, int * error)
+ *
+ * Description: toStringNode() and printList() as they were, on a List of linked nodes, with echo for
+ * stdout. printList() compared the error pointer itself to NO_ERROR, so called without one (as its own
+ * main() did) it formatted every node twice, once for output and once for the echo. The node was passed
+ * to fprintf() as the format; here it goes through "%s", which is the same work for items without a '%'.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static char * oldToStringNode (Node_p myNode, char * buff) {
+	char tempBuff[MAX_CHARS_DATA+2];
+
+	sprintf (buff, "\nNODE: ");
+	strncpy(tempBuff, myNode->data, MAX_CHARS_DATA);
+	strcat (buff, tempBuff);
+	if (myNode->prev)
+		strcat (buff, "\nHAS PRIOR\n");
+	else
+		strcat(buff, "\nNO PRIOR\n");
+	if (myNode->next)
+		strcat (buff, "HAS NEXT\n");
+	else
+		strcat (buff, "NO NEXT - End of List\n");
+	return buff;
+}
+
+static void oldPrintList (List_p myList, FILE * output, FILE * echo, int * error) {
+	Node_p temp = myList->first;
+	char buffer[OLD_BUFFER_SIZE];
+
+	fprintf(output, "%s", toStringList(myList, buffer));
+	fprintf(echo, "%s", toStringList(myList, buffer));
+	while (temp != NULL) {
+		if (error == NO_ERROR)
+			fprintf(output, "%s", oldToStringNode(temp, buffer));
+		fprintf(echo, "%s\n", oldToStringNode (temp, buffer));
+		temp = temp->next;
+	}
+}
+/************************************************************************************************************
+ * dump
+ *
+ * Synopsis: static double dump (List_p list, FILE * sink, FILE * echo, const char * text, size_t length,
+ *                            int how)
+ *
+ * Description: Dumps list to sink (emptied first when it is a regular file) in the way how says; the old
+ * printList() echoes to echo as well. DUMP_FLOOR writes text instead, the RAW dump made beforehand: what
+ * is left once nothing is formatted.
+ *
+ * Returns: The best time over BENCH_ROUNDS in seconds, negative if a write failed.
+ *
+ ************************************************************************************************************/
+static double dump (List_p list, FILE * sink, FILE * echo, const char * text, size_t length, int how) {
+	double best = 0, t;
+	int r, error = NO_ERROR;
+
+	for (r = 0; r < BENCH_ROUNDS; r++) {
+		fflush(sink);
+		if (ftruncate(fileno(sink), 0) == 0)
+			rewind(sink);
+		t = now();
+		switch (how) {
+			case DUMP_OLD:
+				oldPrintList(list, sink, echo, NULL);
+				break;
+			case DUMP_PRINT:
+				printList(list, sink, &error);
+				break;
+			case DUMP_NODES_FD:
+				error = writeListFd(list, fileno(sink), LIST_FORMAT_NODES);
+				break;
+			case DUMP_RAW:
+				error = writeList(list, sink, LIST_FORMAT_RAW);
+				break;
+			case DUMP_RAW_FD:
+				error = writeListFd(list, fileno(sink), LIST_FORMAT_RAW);
+				break;
+			default:
+				if (write(fileno(sink), text, length) != (ssize_t) length)
+					error = PRINT_ERROR;
+		}
+		if (fflush(sink) != 0 || fflush(echo) != 0 || error != NO_ERROR)
+			return -1;
+		t = now() - t;
+		if (r == 0 || t < best)
+			best = t;
+	}
+	return best;
+}
+
+int main (int argc, char * argv[]) {
+	static const char * dumps[] = { "old printList", "printList", "writeListFd NODES", "writeList RAW",
+		"writeListFd RAW",
+		"write() floor" };
+	static const char * sinks[] = { "/dev/null", "regular file" };
+	long lines = (argc > 1) ? atol(argv[1]) : BENCH_LINES;
+	double t[DUMPS];
+	char line[64];
+	char * text = NULL;
+	size_t length = 0;
+	FILE * memory;
+	List_p list;
+	FILE * sink;
+	FILE * echo = fopen("/dev/null", "w");
+	long i;
+	int s, how;
+
+	if (lines < 1 || echo == NULL) {
+		printf("usage: %s [lines]\n", argv[0]);
+		return 2;
+	}
+	list = createList("bench");
+	for (i = 0; i < lines && list != NULL; i++) {
+		snprintf(line, sizeof(line), "proc-%08ld,ready,priority=%ld", i, i % 32);
+		if (appendData(list, line) != NO_ERROR) {
+			destroyList(list);
+			list = NULL;
+		}
+	}
+	if (list != NULL && (memory = open_memstream(&text, &length)) != NULL) {
+		if (writeList(list, memory, LIST_FORMAT_RAW) != NO_ERROR)
+			length = 0;
+		fclose(memory);
+	}
+	if (list == NULL || text == NULL || length == 0) {
+		printf("out of memory for %ld lines\n", lines);
+		return 1;
+	}
+
+	printf("%ld lines\n%-12s  %-17s  %9s  %12s\n", lines, "sink", "dump", "seconds", "vs old");
+	for (s = 0; s < 2; s++) {
+		sink = (s == 0) ? fopen(sinks[0], "w") : tmpfile();
+		if (sink == NULL) {
+			printf("cannot open the %s\n", sinks[s]);
+			return 1;
+		}
+		for (how = 0; how < DUMPS; how++) {
+			t[how] = dump(list, sink, echo, text, length, how);
+			if (t[how] < 0) {
+				printf("writing to the %s failed\n", sinks[s]);
+				return 1;
+			}
+			printf("%-12s  %-17s  %9.4f  %11.1fx\n", sinks[s], dumps[how], t[how], t[DUMP_OLD] / t[how]);
+		}
+		fclose(sink);
+	}
+	fclose(echo);
+	free(text);
+	destroyList(list);
+	return 0;
+}
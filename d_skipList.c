@@ -0,0 +1,294 @@
+/*
+	d_skipList.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: d_skipList.c implements the express lanes that let an ordered List find the position of a key
+	in O(log n) expected steps. The nodes keep their ordinary prior/next links, so everything that walks a
+	List still works on an ordered one; the lanes are only an index over them. Entries on every lane are in
+	the same order as the nodes they point at, equal keys may appear in any order among themselves.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "d_skipList.h"
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ *	Skip Index ADT
+ *
+ *+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/************************************************************************************************************
+ * skipCreate
+ *
+ * Synopsis: SkipIndex * skipCreate (void)
+ *
+ * Description: Creates an index with empty lanes. The head of each level points down at the head of the
+ * level below it, so a search can always drop from any head.
+ *
+ * Returns: A pointer to the index in the heap, NULL if the allocation failed.
+ *
+ ************************************************************************************************************/
+SkipIndex * skipCreate (void) {
+	SkipIndex * index = (SkipIndex *) malloc (sizeof(SkipIndex));
+	int i;
+
+	if (index == NULL)
+		return NULL;
+	for (i = 0; i < SKIP_MAX_LEVEL; i++) {
+		index->head[i].node = NULL;
+		index->head[i].next = NULL;
+		index->head[i].down = (i > 0) ? &index->head[i - 1] : NULL;
+	}
+	index->levels = 1;
+	index->seed = 0x9E3779B9u;
+	return index;
+}
+/************************************************************************************************************
+ * clearLanes
+ *
+ * Synopsis: static void clearLanes (SkipIndex * index)
+ *
+ * Description: Frees every lane entry and leaves the index empty.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void clearLanes (SkipIndex * index) {
+	Lane_p curr, next;
+	int i;
+
+	for (i = 0; i < SKIP_MAX_LEVEL; i++) {
+		curr = index->head[i].next;
+		while (curr != NULL) {
+			next = curr->next;
+			free(curr);
+			curr = next;
+		}
+		index->head[i].next = NULL;
+	}
+	index->levels = 1;
+}
+/************************************************************************************************************
+ * skipDestroy
+ *
+ * Synopsis: void skipDestroy (SkipIndex * index)
+ *
+ * Description: Frees every lane entry and the index. The nodes belong to the list and are left alone.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void skipDestroy (SkipIndex * index) {
+	if (index == NULL)
+		return;
+	clearLanes(index);
+	free(index);
+}
+/************************************************************************************************************
+ * skipCompare
+ *
+ * Synopsis: int skipCompare (List_p myList, const char * a, const char * b)
+ *
+ * Description: Compares two strings in the direction the list is ordered in, so the rest of this file can
+ * treat ascending and descending lists alike.
+ *
+ * Returns: <0 if a goes before b, 0 if equal, >0 if a goes after b.
+ *
+ ************************************************************************************************************/
+int skipCompare (List_p myList, const char * a, const char * b) {
+	return (myList->order == DESCEND_ORDER) ? strcmp(b, a) : strcmp(a, b);
+}
+/************************************************************************************************************
+ * randomLevel
+ *
+ * Synopsis: static int randomLevel (SkipIndex * index)
+ *
+ * Description: Flips the promotion coin (xorshift32) until it fails. Level 0 means the node gets no lane
+ * entry at all.
+ *
+ * Returns: The # of lanes the new node appears on.
+ *
+ ************************************************************************************************************/
+static int randomLevel (SkipIndex * index) {
+	int level = 0;
+
+	for (;;) {
+		unsigned int x = index->seed;
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		index->seed = x;
+		if (x % SKIP_PROMOTE_ONE_IN != 0 || level == SKIP_MAX_LEVEL)
+			return level;
+		level++;
+	}
+}
+/************************************************************************************************************
+ * skipInsert
+ *
+ * Synopsis: void skipInsert (List_p myList, Node_p newNode)
+ *
+ * Description: Runs down the lanes remembering, on every level, the last entry whose node goes at or before
+ * the new data. The node is linked after the last node with data at or before it (so equal data keeps
+ * insertion order) and then gets entries right after the remembered ones on the levels it was promoted to.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void skipInsert (List_p myList, Node_p newNode) {
+	SkipIndex * index = myList->index;
+	Lane_p update[SKIP_MAX_LEVEL];
+	Lane_p lane = &index->head[index->levels - 1];
+	Node_p prev;
+	int level, i;
+
+	for (i = index->levels - 1; i >= 0; i--) {
+		while (lane->next != NULL && skipCompare(myList, lane->next->node->data, newNode->data) <= 0)
+			lane = lane->next;
+		update[i] = lane;
+		if (i > 0)
+			lane = lane->down;
+	}
+
+	// short walk over the nodes from the closest entry
+	prev = lane->node;
+	if (prev == NULL && myList->first != NULL && skipCompare(myList, myList->first->data, newNode->data) <= 0)
+		prev = myList->first;
+	if (prev != NULL)
+		while (prev->next != NULL && skipCompare(myList, prev->next->data, newNode->data) <= 0)
+			prev = prev->next;
+
+	newNode->prev = prev;
+	newNode->next = (prev != NULL) ? prev->next : myList->first;
+	if (newNode->next != NULL)
+		newNode->next->prev = newNode;
+	else
+		myList->last = newNode;
+	if (prev != NULL)
+		prev->next = newNode;
+	else
+		myList->first = newNode;
+	myList->count++;
+
+	level = randomLevel(index);
+	for (i = index->levels; i < level; i++)
+		update[i] = &index->head[i];
+	if (level > index->levels)
+		index->levels = level;
+
+	Lane_p below = NULL;
+	for (i = 0; i < level; i++) {
+		Lane_p entry = (Lane_p) malloc (sizeof(Lane));
+		if (entry == NULL)
+			return;		// the node is linked, it just has fewer express entries
+		entry->node = newNode;
+		entry->down = below;
+		entry->next = update[i]->next;
+		update[i]->next = entry;
+		below = entry;
+	}
+}
+/************************************************************************************************************
+ * skipFind
+ *
+ * Synopsis: Node_p skipFind (List_p myList, const char * searchData)
+ *
+ * Description: Runs down the lanes stopping before any entry that is not strictly before searchData, then
+ * walks the nodes from there to the first node that is not before it.
+ *
+ * Returns: The first node holding searchData, NULL if there is none.
+ *
+ ************************************************************************************************************/
+Node_p skipFind (List_p myList, const char * searchData) {
+	SkipIndex * index = myList->index;
+	Lane_p lane = &index->head[index->levels - 1];
+	Node_p curr;
+	int i;
+
+	for (i = index->levels - 1; i >= 0; i--) {
+		while (lane->next != NULL && skipCompare(myList, lane->next->node->data, searchData) < 0)
+			lane = lane->next;
+		if (i > 0)
+			lane = lane->down;
+	}
+	curr = (lane->node != NULL) ? lane->node->next : myList->first;
+	while (curr != NULL && skipCompare(myList, curr->data, searchData) < 0)
+		curr = curr->next;
+	if (curr != NULL && !strcmp(curr->data, searchData))
+		return curr;
+	return NULL;
+}
+/************************************************************************************************************
+ * skipRemove
+ *
+ * Synopsis: void skipRemove (List_p myList, Node_p myNode)
+ *
+ * Description: On every level finds the run of entries equal to the node's data and unlinks the one that
+ * points at this node, if any. Levels left empty at the top are dropped.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void skipRemove (List_p myList, Node_p myNode) {
+	SkipIndex * index = myList->index;
+	Lane_p lane = &index->head[index->levels - 1];
+	Lane_p scan;
+	int i;
+
+	for (i = index->levels - 1; i >= 0; i--) {
+		while (lane->next != NULL && skipCompare(myList, lane->next->node->data, myNode->data) < 0)
+			lane = lane->next;
+		for (scan = lane; scan->next != NULL && !strcmp(scan->next->node->data, myNode->data); scan = scan->next) {
+			if (scan->next->node == myNode) {
+				Lane_p gone = scan->next;
+				scan->next = gone->next;
+				free(gone);
+				break;
+			}
+		}
+		if (i > 0)
+			lane = lane->down;
+	}
+	while (index->levels > 1 && index->head[index->levels - 1].next == NULL)
+		index->levels--;
+}
+/************************************************************************************************************
+ * skipBuild
+ *
+ * Synopsis: void skipBuild (List_p myList)
+ *
+ * Description: Drops the old lanes and gives every node of an already sorted list its entries, appending to
+ * the tail of each level, which takes one pass over the nodes.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void skipBuild (List_p myList) {
+	SkipIndex * index = myList->index;
+	Lane_p tail[SKIP_MAX_LEVEL];
+	Node_p curr;
+	int i, level;
+
+	clearLanes(index);
+	for (i = 0; i < SKIP_MAX_LEVEL; i++)
+		tail[i] = &index->head[i];
+	for (curr = myList->first; curr != NULL; curr = curr->next) {
+		level = randomLevel(index);
+		if (level > index->levels)
+			index->levels = level;
+		Lane_p below = NULL;
+		for (i = 0; i < level; i++) {
+			Lane_p entry = (Lane_p) malloc (sizeof(Lane));
+			if (entry == NULL)
+				break;
+			entry->node = curr;
+			entry->down = below;
+			entry->next = NULL;
+			tail[i]->next = entry;
+			tail[i] = entry;
+			below = entry;
+		}
+	}
+}
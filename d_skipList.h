@@ -0,0 +1,74 @@
+/*
+	d_skipList.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: Header file for the express lanes of ordered Lists in d_linkedList.c
+
+	A List created with createOrderedList() keeps its nodes sorted on every insert. To avoid walking the
+	whole list to find where a node goes, it keeps a skip list index on top of the ordinary doubly linked
+	nodes: each level is a singly linked lane of entries pointing at some of the nodes, every level skipping
+	more nodes than the one below it. A search runs along the top lane, drops down a level whenever the next
+	entry would pass the key, and finishes with a short walk over the nodes themselves.
+
+	level 2  head ------------------------------> e ------------------------> 0
+	level 1  head ----------> b ----------------> e ---------> g ----------> 0
+	nodes         a <-> b <-> c <-> d <-> e <-> f <-> g <-> h
+
+	These functions are only called by d_linkedList.c, users go through the List functions.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _D_SKIPLIST_H_
+#define _D_SKIPLIST_H_
+
+#include "d_linkedList.h"
+
+#define SKIP_MAX_LEVEL 16		// enough for 4^16 nodes
+#define SKIP_PROMOTE_ONE_IN 4	// a node gets an entry on the next level up with probability 1/4
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct lane {
+	Node_p node;			// node this entry stands for, NULL for the head of a level
+	struct lane * next;		// next entry on the same level
+	struct lane * down;		// entry for the same node one level lower, NULL on level 1
+} Lane;
+
+typedef Lane * Lane_p;
+
+typedef struct skip_index {
+	int levels;					// levels in use
+	unsigned int seed;			// state of the promotion coin flips
+	Lane head[SKIP_MAX_LEVEL];	// head of each level
+} SkipIndex;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+SkipIndex * skipCreate (void);
+// returns an empty index, NULL if not successful
+
+void skipDestroy (SkipIndex * index);
+// frees every lane entry and the index, the nodes are not touched
+
+int skipCompare (List_p myList, const char * a, const char * b);
+// strcmp() in the direction of the list's order
+
+void skipInsert (List_p myList, Node_p newNode);
+// links newNode into the nodes at its sorted position (after
+// any equal data) and gives it lane entries
+
+Node_p skipFind (List_p myList, const char * searchData);
+// returns the first node holding searchData, NULL if none
+
+void skipRemove (List_p myList, Node_p myNode);
+// drops the lane entries of myNode, the node stays linked
+
+void skipBuild (List_p myList);
+// rebuilds the lanes of an already sorted list from scratch
+
+#endif
@@ -0,0 +1,334 @@
+/*
+	d_unrolledList.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: d_unrolledList.c implements the unrolled (chunked) storage of a List. The items of a chunk are
+	always kept packed in slots [0, used), so inserting or removing at the front of a chunk shifts at most
+	CHUNK_SLOTS pointers. A chunk that becomes empty is freed, and a chunk that can absorb its successor
+	after a removal does so, which keeps chunks from being left mostly empty.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "d_unrolledList.h"
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ *	Chunk ADT
+ *
+ *+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/************************************************************************************************************
+ * createChunk
+ *
+ * Synopsis: static Chunk_p createChunk (void)
+ *
+ * Description: Creates an empty, cache line aligned chunk in the heap.
+ *
+ * Returns: A pointer to the new chunk, NULL if the allocation failed.
+ *
+ ************************************************************************************************************/
+static Chunk_p createChunk (void) {
+	Chunk_p ret = (Chunk_p) aligned_alloc(CHUNK_ALIGN, sizeof(Chunk));
+
+	if (ret == NULL)
+		return NULL;
+	ret->prev = NULL;
+	ret->next = NULL;
+	ret->used = 0;
+	return ret;
+}
+/************************************************************************************************************
+ * unlinkChunk
+ *
+ * Synopsis: static void unlinkChunk (List_p myList, Chunk_p chunk)
+ *
+ * Description: Takes an empty chunk out of the list and frees it.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void unlinkChunk (List_p myList, Chunk_p chunk) {
+	if (chunk->prev != NULL)
+		chunk->prev->next = chunk->next;
+	else
+		myList->firstChunk = chunk->next;
+	if (chunk->next != NULL)
+		chunk->next->prev = chunk->prev;
+	else
+		myList->lastChunk = chunk->prev;
+	free(chunk);
+}
+/************************************************************************************************************
+ * removeSlot
+ *
+ * Synopsis: static char * removeSlot (List_p myList, Chunk_p chunk, int slot)
+ *
+ * Description: Takes the item in slot out of chunk and closes the gap. The chunk is freed when it becomes
+ * empty, or its successor is moved into it when both fit in one chunk.
+ *
+ * Returns: The removed item.
+ *
+ ************************************************************************************************************/
+static char * removeSlot (List_p myList, Chunk_p chunk, int slot) {
+	char * data = chunk->slots[slot];
+	int tail = chunk->used - slot - 1;
+
+	memmove(&chunk->slots[slot], &chunk->slots[slot + 1], sizeof(char *) * tail);
+	memmove(&chunk->tags[slot], &chunk->tags[slot + 1], tail);
+	chunk->used--;
+	myList->count--;
+
+	if (chunk->used == 0) {
+		unlinkChunk(myList, chunk);
+	} else if (chunk->next != NULL && chunk->used + chunk->next->used <= CHUNK_SLOTS) {
+		Chunk_p next = chunk->next;
+		memcpy(&chunk->slots[chunk->used], next->slots, sizeof(char *) * next->used);
+		memcpy(&chunk->tags[chunk->used], next->tags, next->used);
+		chunk->used += next->used;
+		next->used = 0;
+		unlinkChunk(myList, next);
+	}
+	return data;
+}
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ *	Unrolled List storage
+ *
+ *+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/************************************************************************************************************
+ * unrolledAppend
+ *
+ * Synopsis: int unrolledAppend (List_p myList, char * data)
+ *
+ * Description: Puts data in the first free slot of the last chunk, starting a new chunk when the last one
+ * is full.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR on failure.
+ *
+ ************************************************************************************************************/
+int unrolledAppend (List_p myList, char * data) {
+	Chunk_p chunk = myList->lastChunk;
+
+	if (chunk == NULL || chunk->used == CHUNK_SLOTS) {
+		Chunk_p newChunk = createChunk();
+		if (newChunk == NULL)
+			return INSERT_ERROR;
+		newChunk->prev = chunk;
+		if (chunk != NULL)
+			chunk->next = newChunk;
+		else
+			myList->firstChunk = newChunk;
+		myList->lastChunk = newChunk;
+		chunk = newChunk;
+	}
+	chunk->slots[chunk->used] = data;
+	chunk->tags[chunk->used] = (unsigned char) data[0];
+	chunk->used++;
+	myList->count++;
+	return NO_ERROR;
+}
+/************************************************************************************************************
+ * unrolledInsertFront
+ *
+ * Synopsis: int unrolledInsertFront (List_p myList, char * data)
+ *
+ * Description: Shifts the items of the first chunk up one slot and puts data in slot 0, starting a new
+ * chunk when the first one is full.
+ *
+ * Returns: NO_ERROR on success, else INSERT_ERROR on failure.
+ *
+ ************************************************************************************************************/
+int unrolledInsertFront (List_p myList, char * data) {
+	Chunk_p chunk = myList->firstChunk;
+
+	if (chunk == NULL || chunk->used == CHUNK_SLOTS) {
+		Chunk_p newChunk = createChunk();
+		if (newChunk == NULL)
+			return INSERT_ERROR;
+		newChunk->next = chunk;
+		if (chunk != NULL)
+			chunk->prev = newChunk;
+		else
+			myList->lastChunk = newChunk;
+		myList->firstChunk = newChunk;
+		chunk = newChunk;
+	}
+	memmove(&chunk->slots[1], &chunk->slots[0], sizeof(char *) * chunk->used);
+	memmove(&chunk->tags[1], &chunk->tags[0], chunk->used);
+	chunk->slots[0] = data;
+	chunk->tags[0] = (unsigned char) data[0];
+	chunk->used++;
+	myList->count++;
+	return NO_ERROR;
+}
+/************************************************************************************************************
+ * unrolledRemoveHead
+ *
+ * Synopsis: char * unrolledRemoveHead (List_p myList)
+ *
+ * Description: Detaches the first item of the list.
+ *
+ * Returns: The item if success, else NULL.
+ *
+ ************************************************************************************************************/
+char * unrolledRemoveHead (List_p myList) {
+	if (myList->firstChunk == NULL)
+		return NULL;
+	return removeSlot(myList, myList->firstChunk, 0);
+}
+/************************************************************************************************************
+ * unrolledRemoveTail
+ *
+ * Synopsis: char * unrolledRemoveTail (List_p myList)
+ *
+ * Description: Detaches the last item of the list.
+ *
+ * Returns: The item if success, else NULL.
+ *
+ ************************************************************************************************************/
+char * unrolledRemoveTail (List_p myList) {
+	Chunk_p chunk = myList->lastChunk;
+
+	if (chunk == NULL)
+		return NULL;
+	return removeSlot(myList, chunk, chunk->used - 1);
+}
+/************************************************************************************************************
+ * findSlot
+ *
+ * Synopsis: static Chunk_p findSlot (List_p myList, const char * searchData, int * slot)
+ *
+ * Description: Walks the chunks comparing the stored first characters with the first character of
+ * searchData; only items whose tag matches are compared with strcmp().
+ *
+ * Returns: The chunk holding the match with its index in slot, NULL if there is no match.
+ *
+ ************************************************************************************************************/
+static Chunk_p findSlot (List_p myList, const char * searchData, int * slot) {
+	unsigned char tag = (unsigned char) searchData[0];
+	Chunk_p chunk;
+	int i;
+
+	for (chunk = myList->firstChunk; chunk != NULL; chunk = chunk->next) {
+		for (i = 0; i < chunk->used; i++) {
+			if (chunk->tags[i] == tag && !strcmp(searchData, chunk->slots[i])) {
+				*slot = i;
+				return chunk;
+			}
+		}
+	}
+	return NULL;
+}
+/************************************************************************************************************
+ * unrolledFind
+ *
+ * Synopsis: char * unrolledFind (List_p myList, const char * searchData)
+ *
+ * Description: Looks for the first item equal to searchData.
+ *
+ * Returns: A pointer to the stored item, NULL if not found.
+ *
+ ************************************************************************************************************/
+char * unrolledFind (List_p myList, const char * searchData) {
+	int slot;
+	Chunk_p chunk = findSlot(myList, searchData, &slot);
+
+	return (chunk != NULL) ? chunk->slots[slot] : NULL;
+}
+/************************************************************************************************************
+ * unrolledRemove
+ *
+ * Synopsis: char * unrolledRemove (List_p myList, const char * searchData)
+ *
+ * Description: Looks for the first item equal to searchData and detaches it.
+ *
+ * Returns: The item if found, else NULL.
+ *
+ ************************************************************************************************************/
+char * unrolledRemove (List_p myList, const char * searchData) {
+	int slot;
+	Chunk_p chunk = findSlot(myList, searchData, &slot);
+
+	return (chunk != NULL) ? removeSlot(myList, chunk, slot) : NULL;
+}
+/************************************************************************************************************
+ * compareItemsAscend / compareItemsDescend
+ *
+ * Synopsis: static int compareItemsAscend (const void * a, const void * b)
+ *
+ * Description: qsort() comparators for an array of strings.
+ *
+ * Returns: <0, 0 or >0 like strcmp().
+ *
+ ************************************************************************************************************/
+static int compareItemsAscend (const void * a, const void * b) {
+	return strcmp(*(char * const *) a, *(char * const *) b);
+}
+
+static int compareItemsDescend (const void * a, const void * b) {
+	return strcmp(*(char * const *) b, *(char * const *) a);
+}
+/************************************************************************************************************
+ * unrolledSort
+ *
+ * Synopsis: int unrolledSort (List_p myList, int mode)
+ *
+ * Description: Copies the item pointers to a temp array, sorts it and writes the pointers (and their tags)
+ * back into the same chunks. The strings themselves do not move.
+ *
+ * Returns: NO_ERROR, or SORT_ERROR if the temp array could not be allocated (the list is left as it was).
+ *
+ ************************************************************************************************************/
+int unrolledSort (List_p myList, int mode) {
+	char ** array;
+	Chunk_p chunk;
+	int i, n = 0;
+
+	if (myList->count < 2)
+		return NO_ERROR;
+	array = (char **) malloc (sizeof(char *) * myList->count);
+	if (array == NULL)
+		return SORT_ERROR;
+	for (chunk = myList->firstChunk; chunk != NULL; chunk = chunk->next)
+		for (i = 0; i < chunk->used; i++)
+			array[n++] = chunk->slots[i];
+
+	qsort(array, n, sizeof(char *), (mode == SORT_DESCEND) ? compareItemsDescend : compareItemsAscend);
+
+	n = 0;
+	for (chunk = myList->firstChunk; chunk != NULL; chunk = chunk->next) {
+		for (i = 0; i < chunk->used; i++) {
+			chunk->slots[i] = array[n++];
+			chunk->tags[i] = (unsigned char) chunk->slots[i][0];
+		}
+	}
+	free(array);
+	return NO_ERROR;
+}
+/************************************************************************************************************
+ * unrolledDestroy
+ *
+ * Synopsis: void unrolledDestroy (List_p myList)
+ *
+ * Description: Frees every item and every chunk of the list; the list head itself is left alone.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void unrolledDestroy (List_p myList) {
+	Chunk_p chunk = myList->firstChunk;
+	Chunk_p next;
+	int i;
+
+	while (chunk != NULL) {
+		next = chunk->next;
+		for (i = 0; i < chunk->used; i++)
+			free(chunk->slots[i]);
+		free(chunk);
+		chunk = next;
+	}
+	myList->firstChunk = NULL;
+	myList->lastChunk = NULL;
+	myList->count = 0;
+}
@@ -0,0 +1,76 @@
+/*
+	d_unrolledList.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Purpose: Header file for the unrolled storage of d_linkedList.c
+
+	A List created with LIST_STORAGE_UNROLLED does not keep one Node per item. Its items are packed into
+	cache aligned chunks of CHUNK_SLOTS string pointers, and only the chunks carry prior/next links. A scan
+	follows one link per CHUNK_SLOTS items, and the first character of every item is kept in the chunk
+	next to the pointers, so a search only dereferences the strings that can match.
+
+	               +---------------------------------------+
+	               |                                       v
+	+--------+   +-------------------+          +-------------------+
+	| List   |-->| prior* next*  used|   +----->| prior* next*  used|---0 (NULL)
+	| first  |   | tags  a b c ...   |   |      | tags  x y         |
+	| Chunk* |   | slots * * * ...   |---+      | slots * *         |
+	+--------+   +-------------------+          +-------------------+
+
+	These functions are only called by d_linkedList.c, users go through the List functions.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _D_UNROLLEDLIST_H_
+#define _D_UNROLLEDLIST_H_
+
+#include "d_linkedList.h"
+
+#define CHUNK_ALIGN 64
+#define CHUNK_SLOTS 12		// 2 links + count + tags + 12 pointers fill two cache lines
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct chunk {
+	struct chunk * prev;
+	struct chunk * next;
+	unsigned char used;					// slots [0, used) hold items
+	unsigned char tags[CHUNK_SLOTS];	// first character of each item
+	char * slots[CHUNK_SLOTS];			// the items, strings owned by the list
+} Chunk;
+
+typedef Chunk * Chunk_p;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+int unrolledAppend (List_p myList, char * data);
+// attaches data (already owned by the list) after the last
+// item. Returns NO_ERROR or INSERT_ERROR
+
+int unrolledInsertFront (List_p myList, char * data);
+// attaches data (already owned by the list) before the first
+// item. Returns NO_ERROR or INSERT_ERROR
+
+char * unrolledRemoveHead (List_p myList);
+char * unrolledRemoveTail (List_p myList);
+// detach and return the first/last item, NULL if empty
+
+char * unrolledFind (List_p myList, const char * searchData);
+// returns the stored string equal to searchData, NULL if none
+
+char * unrolledRemove (List_p myList, const char * searchData);
+// detaches and returns the first item equal to searchData
+
+int unrolledSort (List_p myList, int mode);
+// sorts the items in place, mode is SORT_ASCEND/SORT_DESCEND;
+// SORT_ERROR (the list untouched) if out of memory
+
+void unrolledDestroy (List_p myList);
+// frees every item and every chunk
+
+#endif
@@ -0,0 +1,171 @@
+/*
+	fork_pool.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Implementation of batches of tasks in forked worker processes (see fork_pool.h).
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "fork_pool.h"
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * startWorker
+ *
+ * Synopsis: static int startWorker (ForkTask task, void * arg, int index, size_t resultSize, pid_t * pid,
+ *                                   int * fd)
+ *
+ * Description: Forks a process that runs task # index, writes its result into a pipe in one write()
+ * (at most PIPE_BUF bytes, so it goes through whole) and exits, 0 if the result went out. The parent
+ * keeps the read end of the pipe.
+ *
+ * Returns: 0, or -1 if the pipe or the process could not be created.
+ *
+ ************************************************************************************************************/
+static int startWorker (ForkTask task, void * arg, int index, size_t resultSize, pid_t * pid, int * fd) {
+	char buffer[PIPE_BUF];
+	int ends[2];
+
+	if (pipe(ends) != 0)
+		return -1;
+	*pid = fork();
+	if (*pid < 0) {
+		close(ends[0]);
+		close(ends[1]);
+		return -1;
+	}
+	if (*pid == 0) {
+		close(ends[0]);
+		memset(buffer, 0, resultSize);
+		task(arg, index, buffer);
+		fflush(stdout);
+		_exit(write(ends[1], buffer, resultSize) == (ssize_t) resultSize ? 0 : 1);
+	}
+	close(ends[1]);
+	*fd = ends[0];
+	return 0;
+}
+/************************************************************************************************************
+ * runForkedTasks
+ *
+ * Synopsis: int runForkedTasks (ForkTask task, void * arg, int ntasks, int jobs, void * results,
+ *                               size_t resultSize)
+ *
+ * Description: Keeps up to jobs workers going: starts one per free slot, waits for any to exit and
+ * reads its result, and starts the next task in its slot. Buffered output is flushed before the first
+ * fork, so no worker prints it a second time. A worker that crashes or exits without its whole result
+ * counts as failed.
+ *
+ * Returns: The # of tasks that failed, -1 if resultSize is over PIPE_BUF or out of memory.
+ *
+ ************************************************************************************************************/
+int runForkedTasks (ForkTask task, void * arg, int ntasks, int jobs, void * results, size_t resultSize) {
+	pid_t * pids;
+	int * fds;
+	int * indices;
+	int next = 0;
+	int running = 0;
+	int failed = 0;
+	int slot;
+	int status;
+	pid_t pid;
+	ssize_t n;
+	char * result;
+
+	if (resultSize > PIPE_BUF)
+		return -1;
+	if (jobs < 1)
+		jobs = 1;
+	if (jobs > ntasks)
+		jobs = (ntasks > 0) ? ntasks : 1;
+	pids = (pid_t *) calloc ((size_t) jobs, sizeof(pid_t));
+	fds = (int *) calloc ((size_t) jobs, sizeof(int));
+	indices = (int *) calloc ((size_t) jobs, sizeof(int));
+	if (pids == NULL || fds == NULL || indices == NULL) {
+		free(pids);
+		free(fds);
+		free(indices);
+		return -1;
+	}
+	memset(results, 0, (size_t) ntasks * resultSize);
+	fflush(NULL);
+
+	while (next < ntasks || running > 0) {
+		for (slot = 0; slot < jobs && next < ntasks; slot++) {
+			if (pids[slot] != 0)
+				continue;
+			if (startWorker(task, arg, next, resultSize, &pids[slot], &fds[slot]) != 0) {
+				pids[slot] = 0;
+				failed++;
+			} else {
+				indices[slot] = next;
+				running++;
+			}
+			next++;
+		}
+		if (running == 0)
+			continue;
+
+		do
+			pid = waitpid(-1, &status, 0);
+		while (pid < 0 && errno == EINTR);
+		if (pid < 0)
+			break;
+		for (slot = 0; slot < jobs && pids[slot] != pid; slot++)
+			;
+		if (slot == jobs)
+			continue;			// not one of ours
+
+		result = (char *) results + (size_t) indices[slot] * resultSize;
+		do
+			n = read(fds[slot], result, resultSize);
+		while (n < 0 && errno == EINTR);
+		if (n != (ssize_t) resultSize || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+			memset(result, 0, resultSize);
+			failed++;
+		}
+		close(fds[slot]);
+		pids[slot] = 0;
+		running--;
+	}
+	for (slot = 0; slot < jobs; slot++)
+		if (pids[slot] != 0) {		// waitpid() gave up on it
+			close(fds[slot]);
+			failed++;
+		}
+	free(pids);
+	free(fds);
+	free(indices);
+	return failed;
+}
+/************************************************************************************************************
+ * defaultJobs
+ *
+ * Synopsis: int defaultJobs ()
+ *
+ * Description: The number of workers to use when the user did not say.
+ *
+ * Returns: The # of processors online, at least 1.
+ *
+ ************************************************************************************************************/
+int defaultJobs () {
+	long online = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return (online > 0) ? (int) online : 1;
+}
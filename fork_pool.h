@@ -0,0 +1,42 @@
+/*
+	fork_pool.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Header file for running a batch of tasks in forked worker processes.
+
+	The simulator keeps its state in globals, so two runs cannot share an address space; the thread pool
+	is no help there. runForkedTasks() gives every task a process of its own instead: at most `jobs` of
+	them at a time, each forked from the caller (so it starts with the caller's state), running one task
+	and sending a fixed-size result back through a pipe. A result has to fit in PIPE_BUF bytes, so the
+	worker's write never waits for the parent to read.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _FORK_POOL_H_
+#define _FORK_POOL_H_
+
+#include <stddef.h>
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef void (*ForkTask)(void * arg, int index, void * result);	// runs task # index, fills result in
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+int runForkedTasks (ForkTask task, void * arg, int ntasks, int jobs, void * results, size_t resultSize);
+// runs tasks 0 .. ntasks-1, at most jobs at a time, in forked
+// processes, and stores the result of task i at results +
+// i * resultSize. Returns the # of tasks that failed (their
+// results are zeroed), -1 if resultSize is over PIPE_BUF
+
+int defaultJobs ();
+// returns the # of processors online, at least 1
+
+#endif
@@ -0,0 +1,285 @@
+/*
+	lf_queue.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: lf_queue.c is the implementation of a bounded lock-free queue that several producer and
+	consumer threads can share. Every cell carries a sequence number: a cell at position pos is free for
+	the producer of that lap when sequence == pos, and holds an item for the consumer when
+	sequence == pos + 1. After a consumer is done it hands the cell to the next lap by setting
+	sequence = pos + capacity.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lf_queue.h"
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ *	Lock-free Queue ADT
+ *
+ *+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+/************************************************************************************************************
+ * createLFQueue
+ *
+ * Synopsis: LFQueue_p createLFQueue(const char * title, int limit)
+ *
+ * Description: This function allocates a cache line aligned queue head and a ring of cells in the heap.
+ * The limit is rounded up to a power of two so positions can be mapped to cells with a mask. Each cell
+ * starts out free for the first lap.
+ *
+ * Returns: A pointer to the queue in the heap, NULL if the limit is invalid or memory ran out.
+ *
+ ************************************************************************************************************/
+LFQueue_p createLFQueue(const char * title, int limit) {
+	size_t capacity = LF_MIN_CAPACITY;
+	size_t i;
+
+	if (limit <= 0)
+		return NULL;
+	while (capacity < (size_t) limit)
+		capacity <<= 1;
+
+	LFQueue_p my_queue = (LFQueue_p) aligned_alloc(CACHE_LINE_SIZE, sizeof(LFQueue));
+	if (my_queue == NULL)
+		return NULL;
+	my_queue->buffer = (LFCell *) aligned_alloc(CACHE_LINE_SIZE, sizeof(LFCell) * capacity);
+	if (my_queue->buffer == NULL) {
+		free(my_queue);
+		return NULL;
+	}
+	for (i = 0; i < capacity; i++) {
+		atomic_init(&my_queue->buffer[i].sequence, i);
+		my_queue->buffer[i].data = NULL;
+	}
+	my_queue->mask = capacity - 1;
+	my_queue->limit = (int) capacity;
+	my_queue->title = NULL;
+	if (title != NULL) {
+		my_queue->title = (char *) malloc (sizeof(char) * strlen(title) + 1);
+		strcpy(my_queue->title, title);
+	}
+	atomic_init(&my_queue->enqueue_pos, 0);
+	atomic_init(&my_queue->dequeue_pos, 0);
+	return my_queue;
+}
+/************************************************************************************************************
+ * destroyLFQueue
+ *
+ * Synopsis: void destroyLFQueue(LFQueue_p queue)
+ *
+ * Description: This function frees the ring and the queue head. It must only be called once every
+ * producer and consumer thread is done with the queue.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void destroyLFQueue(LFQueue_p queue) {
+	if (queue != NULL) {
+		free(queue->buffer);
+		free(queue->title);
+		free(queue);
+	} else
+		printf("Queue is NULL\n");
+}
+/************************************************************************************************************
+ * isEmptyLF
+ *
+ * Synopsis: int isEmptyLF (LFQueue_p queue)
+ *
+ * Description: This function compares the producer and consumer positions to get the # of items in the
+ * queue. While other threads are running the answer may already be stale when it is returned.
+ *
+ * Returns: # of items in the queue, if 0, then queue is empty.
+ *
+ ************************************************************************************************************/
+int isEmptyLF (LFQueue_p queue) {
+	if (queue == NULL)
+		return FALSE;
+
+	size_t head = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+	size_t tail = atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);
+	if (tail <= head)
+		return 0;
+	if (tail - head > (size_t) queue->limit)
+		return queue->limit;
+	return (int) (tail - head);
+}
+/************************************************************************************************************
+ * isFullLF
+ *
+ * Synopsis: int isFullLF (LFQueue_p queue)
+ *
+ * Description: This function checks to see if the queue is full by comparing the # of items in the
+ * queue with the queue limit.
+ *
+ * Returns: TRUE if full(1), FALSE is not(0).
+ *
+ ************************************************************************************************************/
+int isFullLF (LFQueue_p queue) {
+	if (queue == NULL)
+		return FALSE;
+
+	if (isEmptyLF(queue) == queue->limit)
+		return TRUE;
+	else
+		return FALSE;
+}
+/************************************************************************************************************
+ * enqueueLF
+ *
+ * Synopsis: int enqueueLF (LFQueue_p queue, void * data)
+ *
+ * Description: This function claims the next producer position with a compare-and-swap once the cell at
+ * that position is free for this lap, stores the item and then publishes it by bumping the sequence.
+ * If the cell still belongs to the previous lap the ring is full.
+ *
+ * Returns: TRUE if successful, QUEUE_FULL_ERROR if the queue is full, PUSH_ERROR on bad arguments.
+ *
+ ************************************************************************************************************/
+int enqueueLF (LFQueue_p queue, void * data) {
+	if (queue == NULL || data == NULL)
+		return PUSH_ERROR;
+
+	LFCell * cell;
+	size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+	for (;;) {
+		cell = &queue->buffer[pos & queue->mask];
+		size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+		intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1,
+					memory_order_relaxed, memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			return QUEUE_FULL_ERROR;
+		} else {
+			pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+		}
+	}
+	cell->data = data;
+	atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+	return TRUE;
+}
+/************************************************************************************************************
+ * dequeueLF
+ *
+ * Synopsis: void * dequeueLF (LFQueue_p queue)
+ *
+ * Description: This function claims the next consumer position once the cell at that position has been
+ * published by a producer, takes the item and hands the cell over to the next lap.
+ *
+ * Returns: The oldest item in the queue, NULL if the queue is empty.
+ *
+ ************************************************************************************************************/
+void * dequeueLF (LFQueue_p queue) {
+	if (queue == NULL)
+		return NULL;
+
+	LFCell * cell;
+	size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+	for (;;) {
+		cell = &queue->buffer[pos & queue->mask];
+		size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+		intptr_t diff = (intptr_t) seq - (intptr_t) (pos + 1);
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + 1,
+					memory_order_relaxed, memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			return NULL;
+		} else {
+			pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+		}
+	}
+	void * data = cell->data;
+	atomic_store_explicit(&cell->sequence, pos + queue->mask + 1, memory_order_release);
+	return data;
+}
+/************************************************************************************************************
+ * enqueueBatchLF
+ *
+ * Synopsis: int enqueueBatchLF (LFQueue_p queue, void ** items, int n)
+ *
+ * Description: This function claims a whole run of producer positions with one compare-and-swap, so a
+ * batch costs one contended operation instead of n. The run is trimmed to the free space seen from the
+ * consumer position. A consumer may have claimed one of those cells but not released it yet, so each
+ * cell is waited on before it is written; the wait is bounded by that consumer finishing its copy.
+ *
+ * Returns: The # of items enqueued, 0 if the queue is full or the arguments are bad.
+ *
+ ************************************************************************************************************/
+int enqueueBatchLF (LFQueue_p queue, void ** items, int n) {
+	if (queue == NULL || items == NULL || n <= 0)
+		return 0;
+
+	size_t capacity = queue->mask + 1;
+	size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+	size_t count;
+	size_t i;
+	for (;;) {
+		size_t head = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+		size_t used = pos - head;
+		if ((intptr_t) used < 0)
+			used = 0;
+		if (used >= capacity)
+			return 0;
+		count = capacity - used;
+		if (count > (size_t) n)
+			count = (size_t) n;
+		if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + count,
+				memory_order_relaxed, memory_order_relaxed))
+			break;
+	}
+	for (i = 0; i < count; i++) {
+		LFCell * cell = &queue->buffer[(pos + i) & queue->mask];
+		while (atomic_load_explicit(&cell->sequence, memory_order_acquire) != pos + i)
+			;	// a consumer that already claimed this cell is still copying out of it
+		cell->data = items[i];
+		atomic_store_explicit(&cell->sequence, pos + i + 1, memory_order_release);
+	}
+	return (int) count;
+}
+/************************************************************************************************************
+ * dequeueBatchLF
+ *
+ * Synopsis: int dequeueBatchLF (LFQueue_p queue, void ** items, int n)
+ *
+ * Description: This function claims a whole run of consumer positions with one compare-and-swap. The run
+ * is trimmed to the items already claimed by producers. A producer may still be writing one of those
+ * cells, so each cell is waited on before it is read; the wait is bounded by that producer finishing
+ * its store.
+ *
+ * Returns: The # of items copied into items, 0 if the queue is empty or the arguments are bad.
+ *
+ ************************************************************************************************************/
+int dequeueBatchLF (LFQueue_p queue, void ** items, int n) {
+	if (queue == NULL || items == NULL || n <= 0)
+		return 0;
+
+	size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+	size_t count;
+	size_t i;
+	for (;;) {
+		size_t tail = atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);
+		if ((intptr_t) (tail - pos) <= 0)
+			return 0;
+		count = tail - pos;
+		if (count > (size_t) n)
+			count = (size_t) n;
+		if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + count,
+				memory_order_relaxed, memory_order_relaxed))
+			break;
+	}
+	for (i = 0; i < count; i++) {
+		LFCell * cell = &queue->buffer[(pos + i) & queue->mask];
+		while (atomic_load_explicit(&cell->sequence, memory_order_acquire) != pos + i + 1)
+			;	// the producer that claimed this cell has not published it yet
+		items[i] = cell->data;
+		atomic_store_explicit(&cell->sequence, pos + i + queue->mask + 1, memory_order_release);
+	}
+	return (int) count;
+}
@@ -0,0 +1,85 @@
+/*
+	lf_queue.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Header file for the bounded lock-free queue ADT.
+
+	lf_queue.c implements a multi-producer/multi-consumer queue on top of a ring of sequence-numbered
+	cells (D. Vyukov's bounded MPMC design). Producers and consumers never take a lock: each side claims
+	a position with a compare-and-swap and then uses the cell's sequence number to know when the slot
+	is ready. It offers the same operations as the List backed Queue in queue.h, but it is safe to
+	share between threads. Items are stored by pointer, nothing is copied.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _LF_QUEUE_H_
+#define _LF_QUEUE_H_
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+#include "queue.h"			// shares PUSH_ERROR, QUEUE_FULL_ERROR, TRUE and FALSE
+
+#define CACHE_LINE_SIZE 64
+#define LF_MIN_CAPACITY 2
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct lf_cell {	// one slot of the ring
+	atomic_size_t sequence;	// tells producers/consumers which lap the slot belongs to
+	void * data;			// the item, stored by pointer
+} LFCell;
+
+typedef struct lf_queue {
+	// read-only after creation, kept on its own line so the indices below do not false share with it
+	_Alignas(CACHE_LINE_SIZE) LFCell * buffer;
+	size_t mask;			// capacity - 1, capacity is always a power of two
+	int limit;				// capacity of the ring
+	char * title;			// optional name of the queue
+
+	_Alignas(CACHE_LINE_SIZE) atomic_size_t enqueue_pos;	// next position a producer claims
+	_Alignas(CACHE_LINE_SIZE) atomic_size_t dequeue_pos;	// next position a consumer claims
+} LFQueue;
+
+typedef LFQueue * LFQueue_p;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+LFQueue_p createLFQueue(const char * title, int limit);
+// constructor for a lock-free queue, limit is rounded up to
+// the next power of two. Returns NULL if not successful
+
+void destroyLFQueue(LFQueue_p queue);
+// destructor for an instantiated lock-free queue, the items
+// still in the queue are not freed
+
+int isEmptyLF (LFQueue_p queue);
+// returns the # of items in the queue, 0 if empty. The value
+// is a snapshot when other threads are active
+
+int isFullLF (LFQueue_p queue);
+// returns TRUE if the queue holds limit items
+
+int enqueueLF (LFQueue_p queue, void * data);
+// returns TRUE if successful, QUEUE_FULL_ERROR if the ring is
+// full or PUSH_ERROR on bad arguments
+
+void * dequeueLF (LFQueue_p queue);
+// returns the oldest item, NULL if the queue is empty
+
+int enqueueBatchLF (LFQueue_p queue, void ** items, int n);
+// enqueues up to n items with a single claim on the ring and
+// returns how many were enqueued (0 if the queue is full)
+
+int dequeueBatchLF (LFQueue_p queue, void ** items, int n);
+// dequeues up to n items with a single claim on the ring into
+// items and returns how many were dequeued
+
+#endif
@@ -0,0 +1,209 @@
+/*
+	lf_queue_bench.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Contention benchmark of the lock-free queue (see lf_queue.h).
+
+	N producers and N consumers pass items through one queue of BENCH_CAPACITY, for N = 1, 2, 4 ... up to
+	the # given. Each N is timed three ways: the lock-free queue one item per operation, the lock-free
+	queue BENCH_BATCH items per claim, and the List backed Queue of queue.h behind a pthread mutex, which
+	is what sharing it between threads would take. The table gives the items through per second, and the
+	speedup of each lock-free column over the mutex. A thread that finds the queue full (empty) yields the
+	processor, so on fewer cores than threads the numbers include scheduling as well as contention.
+
+	Build: gcc -std=gnu11 -O2 -pthread lf_queue_bench.c lf_queue.c queue.c d_linkedList.c d_unrolledList.c
+	    d_skipList.c d_bloomFilter.c d_internTable.c d_listWriter.c -o lf_queue_bench
+	Execute: lf_queue_bench [max_pairs items_per_producer]
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "lf_queue.h"
+#include "queue.h"
+
+#define BENCH_PAIRS 8			// producer/consumer pairs at most unless the arguments say
+#define BENCH_ITEMS 500000		// items per producer unless the arguments say
+#define BENCH_CAPACITY 1024
+#define BENCH_BATCH 16
+#define MAX_PAIRS 64
+
+#define MODE_SINGLE 0			// enqueueLF / dequeueLF
+#define MODE_BATCH 1			// enqueueBatchLF / dequeueBatchLF
+#define MODE_MUTEX 2			// enqueuePayload / dequeue under a mutex
+#define MODES 3
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct bench {
+	int mode;
+	long items;					// per producer
+	long total;					// items of all producers
+	LFQueue_p lf;
+	Queue_p locked;
+	pthread_mutex_t lock;		// of locked
+	atomic_long consumed;
+} Bench;
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * put / take
+ *
+ * Synopsis: static int put (Bench * b, void ** items, int n)
+ *
+ * Description: Puts up to n items in the queue of the mode, or takes up to n out into items. The single
+ * and mutex modes move one item per call.
+ *
+ * Returns: The # of items moved, 0 if the queue was full (empty).
+ *
+ ************************************************************************************************************/
+static int put (Bench * b, void ** items, int n) {
+	int ok;
+
+	switch (b->mode) {
+		case MODE_SINGLE:
+			return enqueueLF(b->lf, items[0]) == TRUE;
+		case MODE_BATCH:
+			return enqueueBatchLF(b->lf, items, n);
+		default:
+			pthread_mutex_lock(&b->lock);
+			ok = enqueuePayload(b->locked, items[0]) == NO_ERROR;
+			pthread_mutex_unlock(&b->lock);
+			return ok;
+	}
+}
+
+static int take (Bench * b, void ** items, int n) {
+	switch (b->mode) {
+		case MODE_SINGLE:
+			items[0] = dequeueLF(b->lf);
+			return items[0] != NULL;
+		case MODE_BATCH:
+			return dequeueBatchLF(b->lf, items, n);
+		default:
+			pthread_mutex_lock(&b->lock);
+			items[0] = dequeue(b->locked);
+			pthread_mutex_unlock(&b->lock);
+			return items[0] != NULL;
+	}
+}
+/************************************************************************************************************
+ * produce / consume
+ *
+ * Synopsis: static void * produce (void * arg)
+ *
+ * Description: A producer puts its items in, a consumer takes items out until all of them are through.
+ * Either yields the processor when the queue is full (empty).
+ *
+ * Returns: NULL.
+ *
+ ************************************************************************************************************/
+static void * produce (void * arg) {
+	Bench * b = (Bench *) arg;
+	void * items[BENCH_BATCH];
+	long left = b->items;
+	int n, k;
+
+	for (k = 0; k < BENCH_BATCH; k++)
+		items[k] = (void *) (uintptr_t) (k + 1);
+	while (left > 0) {
+		n = put(b, items, (left < BENCH_BATCH) ? (int) left : BENCH_BATCH);
+		if (n == 0)
+			sched_yield();
+		left -= n;
+	}
+	return NULL;
+}
+
+static void * consume (void * arg) {
+	Bench * b = (Bench *) arg;
+	void * items[BENCH_BATCH];
+	int n;
+
+	while (atomic_load_explicit(&b->consumed, memory_order_relaxed) < b->total) {
+		n = take(b, items, BENCH_BATCH);
+		if (n == 0)
+			sched_yield();
+		else
+			atomic_fetch_add_explicit(&b->consumed, n, memory_order_relaxed);
+	}
+	return NULL;
+}
+/************************************************************************************************************
+ * runBench
+ *
+ * Synopsis: static double runBench (int mode, int pairs, long items)
+ *
+ * Description: Times pairs producers and pairs consumers moving items each through a fresh queue.
+ *
+ * Returns: Items through per second, 0 if the queue could not be made.
+ *
+ ************************************************************************************************************/
+static double runBench (int mode, int pairs, long items) {
+	pthread_t threads[2 * MAX_PAIRS];
+	struct timespec start, end;
+	Bench b;
+	int t;
+
+	b.mode = mode;
+	b.items = items;
+	b.total = items * pairs;
+	b.lf = NULL;
+	b.locked = NULL;
+	if (mode == MODE_MUTEX) {
+		b.locked = createQueue("bench", BENCH_CAPACITY);
+		pthread_mutex_init(&b.lock, NULL);
+	} else
+		b.lf = createLFQueue("bench", BENCH_CAPACITY);
+	if (b.lf == NULL && b.locked == NULL)
+		return 0;
+	atomic_init(&b.consumed, 0);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (t = 0; t < 2 * pairs; t++)
+		pthread_create(&threads[t], NULL, (t < pairs) ? produce : consume, &b);
+	for (t = 0; t < 2 * pairs; t++)
+		pthread_join(threads[t], NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	if (mode == MODE_MUTEX) {
+		destroyQueue(b.locked);
+		pthread_mutex_destroy(&b.lock);
+	} else
+		destroyLFQueue(b.lf);
+	return b.total / ((double) (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+}
+
+int main (int argc, char * argv[]) {
+	int max_pairs = (argc > 1) ? atoi(argv[1]) : BENCH_PAIRS;
+	long items = (argc > 2) ? atol(argv[2]) : BENCH_ITEMS;
+	double rate[MODES];
+	int pairs, m;
+
+	if (max_pairs < 1 || max_pairs > MAX_PAIRS || items < 1) {
+		printf("usage: %s [max_pairs (1 .. %d) items_per_producer]\n", argv[0], MAX_PAIRS);
+		return 2;
+	}
+	printf("pairs  lock-free Mitems/s  batch of %d Mitems/s  mutex Queue Mitems/s  lock-free/mutex  batch/mutex\n",
+		BENCH_BATCH);
+	for (pairs = 1; pairs <= max_pairs; pairs *= 2) {
+		for (m = 0; m < MODES; m++)
+			rate[m] = runBench(m, pairs, items) / 1e6;
+		printf("%5d  %18.2f  %19.2f  %20.2f  %14.2fx  %10.2fx\n", pairs, rate[MODE_SINGLE], rate[MODE_BATCH],
+			rate[MODE_MUTEX], rate[MODE_SINGLE] / rate[MODE_MUTEX], rate[MODE_BATCH] / rate[MODE_MUTEX]);
+	}
+	return 0;
+}
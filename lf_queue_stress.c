@@ -0,0 +1,249 @@
+/*
+	lf_queue_stress.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Stress test of the lock-free queue (see lf_queue.h).
+
+	Producers and consumers hammer a small ring, so it wraps and fills over and over. Every item names
+	its producer and its place in that producer's sequence. The test fails if an item is lost, comes out
+	twice, or reaches a consumer ahead of an earlier item of the same producer (the queue is FIFO, so
+	what one producer put in comes out in order to whoever takes it). Producers and consumers switch
+	between the single and the batch operations every few items, so the two claims race each other too.
+
+	Build: gcc -std=gnu11 -O2 -pthread lf_queue_stress.c lf_queue.c -o lf_queue_stress
+	Execute: lf_queue_stress [producers consumers items capacity]
+	    with no arguments it runs a set of shapes (1x1 .. 8x2) with 200000 items per producer
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "lf_queue.h"
+
+#define STRESS_ITEMS 200000		// items per producer unless the arguments say
+#define STRESS_CAPACITY 16		// a small ring wraps and fills often
+#define STRESS_BATCH 8			// items per batch operation at most
+#define STRESS_SWITCH 64		// items between switches of single and batch operations
+#define MAX_THREADS 64
+
+// an item is never NULL: producer p, sequence i
+#define ITEM(p, i) ((void *) (uintptr_t) ((((uintptr_t) (p) << 40) | (uintptr_t) (i)) + 1))
+#define ITEM_PRODUCER(x) ((int) (((uintptr_t) (x) - 1) >> 40))
+#define ITEM_SEQ(x) ((long) (((uintptr_t) (x) - 1) & (((uintptr_t) 1 << 40) - 1)))
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct stress {
+	LFQueue_p queue;
+	int producers;
+	long items;						// per producer
+	atomic_uchar * seen;			// times item i of producer p came out, at p * items + i
+	atomic_long consumed;
+	atomic_long out_of_order;
+	atomic_long strays;				// items no producer put in
+} Stress;
+
+typedef struct stress_thread {
+	pthread_t thread;
+	Stress * stress;
+	int index;
+} StressThread;
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * produce
+ *
+ * Synopsis: static void * produce (void * arg)
+ *
+ * Description: Puts items 0 .. items - 1 of its producer in, in order, STRESS_SWITCH at a time with
+ * enqueueLF() and then with enqueueBatchLF(). A full queue yields the processor to the consumers.
+ *
+ * Returns: NULL.
+ *
+ ************************************************************************************************************/
+static void * produce (void * arg) {
+	StressThread * self = (StressThread *) arg;
+	Stress * s = self->stress;
+	void * batch[STRESS_BATCH];
+	long i = 0;
+	int n, k;
+
+	while (i < s->items) {
+		if ((i / STRESS_SWITCH) % 2 == 0) {
+			if (enqueueLF(s->queue, ITEM(self->index, i)) == TRUE)
+				i++;
+			else
+				sched_yield();
+			continue;
+		}
+		n = (s->items - i < STRESS_BATCH) ? (int) (s->items - i) : STRESS_BATCH;
+		for (k = 0; k < n; k++)
+			batch[k] = ITEM(self->index, i + k);
+		n = enqueueBatchLF(s->queue, batch, n);
+		if (n == 0)
+			sched_yield();
+		i += n;
+	}
+	return NULL;
+}
+/************************************************************************************************************
+ * check
+ *
+ * Synopsis: static void check (Stress * s, void * item, long * last)
+ *
+ * Description: Counts item as seen, and as out of order if its producer already handed this consumer a
+ * later one (last[p] is the last sequence of producer p the consumer took).
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void check (Stress * s, void * item, long * last) {
+	int p = ITEM_PRODUCER(item);
+	long i = ITEM_SEQ(item);
+
+	if (p >= s->producers || i >= s->items) {
+		atomic_fetch_add(&s->strays, 1);
+		return;
+	}
+	if (i <= last[p])
+		atomic_fetch_add(&s->out_of_order, 1);
+	last[p] = i;
+	atomic_fetch_add_explicit(&s->seen[p * s->items + i], 1, memory_order_relaxed);
+}
+/************************************************************************************************************
+ * consume
+ *
+ * Synopsis: static void * consume (void * arg)
+ *
+ * Description: Takes items out, with dequeueLF() and dequeueBatchLF() in turn, and checks each until
+ * every item of every producer has come out. An empty queue yields the processor to the producers.
+ *
+ * Returns: NULL.
+ *
+ ************************************************************************************************************/
+static void * consume (void * arg) {
+	StressThread * self = (StressThread *) arg;
+	Stress * s = self->stress;
+	long total = s->items * s->producers;
+	long last[MAX_THREADS];
+	void * batch[STRESS_BATCH];
+	void * item;
+	long taken = 0;
+	int n, k;
+
+	for (k = 0; k < s->producers; k++)
+		last[k] = -1;
+	while (atomic_load(&s->consumed) < total) {
+		if ((taken / STRESS_SWITCH) % 2 == 0) {
+			item = dequeueLF(s->queue);
+			n = (item != NULL);
+			if (n)
+				check(s, item, last);
+		} else {
+			n = dequeueBatchLF(s->queue, batch, STRESS_BATCH);
+			for (k = 0; k < n; k++)
+				check(s, batch[k], last);
+		}
+		if (n == 0) {
+			sched_yield();
+			continue;
+		}
+		taken += n;
+		atomic_fetch_add(&s->consumed, n);
+	}
+	return NULL;
+}
+/************************************************************************************************************
+ * runStress
+ *
+ * Synopsis: static int runStress (int producers, int consumers, long items, int capacity)
+ *
+ * Description: Runs producers and consumers on a queue of capacity until every item is through, then
+ * looks for items that came out other than once.
+ *
+ * Returns: TRUE (1) if the queue passed, FALSE (0) if not.
+ *
+ ************************************************************************************************************/
+static int runStress (int producers, int consumers, long items, int capacity) {
+	StressThread threads[2 * MAX_THREADS];
+	struct timespec start, end;
+	Stress s;
+	long lost = 0, duplicated = 0;
+	long i;
+	int t;
+
+	s.queue = createLFQueue("stress", capacity);
+	s.producers = producers;
+	s.items = items;
+	s.seen = (atomic_uchar *) calloc ((size_t) (items * producers), sizeof(atomic_uchar));
+	if (s.queue == NULL || s.seen == NULL) {
+		printf("out of memory\n");
+		return FALSE;
+	}
+	atomic_init(&s.consumed, 0);
+	atomic_init(&s.out_of_order, 0);
+	atomic_init(&s.strays, 0);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (t = 0; t < producers + consumers; t++) {
+		threads[t].stress = &s;
+		threads[t].index = (t < producers) ? t : t - producers;
+		pthread_create(&threads[t].thread, NULL, (t < producers) ? produce : consume, &threads[t]);
+	}
+	for (t = 0; t < producers + consumers; t++)
+		pthread_join(threads[t].thread, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	for (i = 0; i < items * producers; i++) {
+		if (s.seen[i] == 0)
+			lost++;
+		else if (s.seen[i] > 1)
+			duplicated++;
+	}
+	printf("%2d producers %2d consumers capacity %4d: %ld items in %.3f s, lost %ld duplicated %ld "
+		"out of order %ld strays %ld%s\n", producers, consumers, s.queue->limit, items * producers,
+		(double) (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9, lost, duplicated,
+		(long) s.out_of_order, (long) s.strays, isEmptyLF(s.queue) ? ", queue not empty" : "");
+	t = lost == 0 && duplicated == 0 && s.out_of_order == 0 && s.strays == 0 && !isEmptyLF(s.queue);
+	free(s.seen);
+	destroyLFQueue(s.queue);
+	return t;
+}
+
+int main (int argc, char * argv[]) {
+	static const int shapes[][2] = { { 1, 1 }, { 2, 2 }, { 4, 4 }, { 8, 2 }, { 2, 8 }, { 8, 8 } };
+	int passed = TRUE;
+	size_t i;
+
+	if (argc == 5) {
+		int producers = atoi(argv[1]), consumers = atoi(argv[2]);
+
+		if (producers < 1 || consumers < 1 || producers > MAX_THREADS || consumers > MAX_THREADS ||
+				atol(argv[3]) < 1 || atoi(argv[4]) < 1) {
+			printf("1 .. %d producers and consumers, at least 1 item and a capacity of 1 or more\n", MAX_THREADS);
+			return 2;
+		}
+		passed = runStress(producers, consumers, atol(argv[3]), atoi(argv[4]));
+	} else if (argc == 1) {
+		for (i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++)
+			passed &= runStress(shapes[i][0], shapes[i][1], STRESS_ITEMS, STRESS_CAPACITY);
+	} else {
+		printf("usage: %s [producers consumers items capacity]\n", argv[0]);
+		return 2;
+	}
+	printf("%s\n", passed ? "PASSED" : "FAILED");
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,327 @@
+/*
+	process_table.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Implementation of the structure of arrays process table (see process_table.h).
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "process_table.h"
+#include "queue.h"			// TRUE and FALSE
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * growColumn
+ *
+ * Synopsis: static int growColumn (void ** column, size_t size, int from, int to)
+ *
+ * Description: Resizes a column of size byte elements from `from` to `to` slots, the new slots zeroed.
+ *
+ * Returns: 0, or -1 if out of memory (the column is left as it was).
+ *
+ ************************************************************************************************************/
+static int growColumn (void ** column, size_t size, int from, int to) {
+	char * grown = (char *) realloc (*column, size * (size_t) to);
+
+	if (grown == NULL)
+		return -1;
+	memset(grown + size * (size_t) from, 0, size * (size_t) (to - from));
+	*column = grown;
+	return 0;
+}
+/************************************************************************************************************
+ * growTable
+ *
+ * Synopsis: static int growTable (ProcessTable_p table, int capacity)
+ *
+ * Description: Grows every column and the bitmap to capacity slots (a multiple of 64) and marks the new
+ * slots free.
+ *
+ * Returns: 0, or -1 if out of memory.
+ *
+ ************************************************************************************************************/
+static int growTable (ProcessTable_p table, int capacity) {
+	int from = table->capacity;
+
+	if (growColumn((void **) &table->freeMap, sizeof(uint64_t), from / 64, capacity / 64) != 0 ||
+			growColumn((void **) &table->dirtyMap, sizeof(uint64_t), from / 64, capacity / 64) != 0 ||
+			growColumn((void **) &table->id, sizeof(Tick), from, capacity) != 0 ||
+			growColumn((void **) &table->arrival, sizeof(Tick), from, capacity) != 0 ||
+			growColumn((void **) &table->run_count, sizeof(Tick), from, capacity) != 0 ||
+			growColumn((void **) &table->last_ran, sizeof(Tick), from, capacity) != 0 ||
+			growColumn((void **) &table->burst_left, sizeof(Tick), from, capacity) != 0 ||
+			growColumn((void **) &table->io_ticks, sizeof(Tick), from, capacity) != 0 ||
+			growColumn((void **) &table->blocked_at, sizeof(Tick), from, capacity) != 0 ||
+			growColumn((void **) &table->rand_state, sizeof(unsigned long long), from, capacity) != 0)
+		return -1;
+	memset(table->freeMap + from / 64, 0xff, sizeof(uint64_t) * (size_t) ((capacity - from) / 64));
+	table->hint = from / 64;
+	table->capacity = capacity;
+	return 0;
+}
+/************************************************************************************************************
+ * createProcessTable
+ *
+ * Synopsis: ProcessTable_p createProcessTable (int capacity)
+ *
+ * Description: Allocates an empty table of at least PROC_TABLE_MIN slots, rounded up to a multiple of 64.
+ *
+ * Returns: A pointer to the table in the heap, NULL if not successful.
+ *
+ ************************************************************************************************************/
+ProcessTable_p createProcessTable (int capacity) {
+	ProcessTable_p table = (ProcessTable_p) calloc (1, sizeof(ProcessTable));
+
+	if (table == NULL)
+		return NULL;
+	if (capacity < PROC_TABLE_MIN)
+		capacity = PROC_TABLE_MIN;
+	if (growTable(table, (capacity + 63) & ~63) != 0) {
+		destroyProcessTable(table);
+		return NULL;
+	}
+	return table;
+}
+/************************************************************************************************************
+ * destroyProcessTable
+ *
+ * Synopsis: void destroyProcessTable (ProcessTable_p table)
+ *
+ * Description: Frees the columns, the bitmap and the table.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void destroyProcessTable (ProcessTable_p table) {
+	if (table == NULL)
+		return;
+	free(table->freeMap);
+	free(table->dirtyMap);
+	free(table->id);
+	free(table->arrival);
+	free(table->run_count);
+	free(table->last_ran);
+	free(table->burst_left);
+	free(table->io_ticks);
+	free(table->blocked_at);
+	free(table->rand_state);
+	free(table);
+}
+/************************************************************************************************************
+ * allocProcess
+ *
+ * Synopsis: ProcHandle allocProcess (ProcessTable_p table, Tick id, Tick arrival)
+ *
+ * Description: Finds the first bitmap word with a free slot, starting at the hint (every word before it
+ * is full), takes its lowest free bit and fills the slot in. A full table doubles.
+ *
+ * Returns: The handle of the new process, NO_PROCESS if not successful.
+ *
+ ************************************************************************************************************/
+ProcHandle allocProcess (ProcessTable_p table, Tick id, Tick arrival) {
+	int words;
+	int w;
+	ProcHandle h;
+
+	if (table == NULL)
+		return NO_PROCESS;
+	words = table->capacity / 64;
+	for (w = table->hint; w < words && table->freeMap[w] == 0; w++)
+		;
+	if (w == words) {
+		if (growTable(table, table->capacity * 2) != 0)
+			return NO_PROCESS;
+		w = words;
+	}
+	h = w * 64 + __builtin_ctzll(table->freeMap[w]);
+	table->freeMap[w] &= table->freeMap[w] - 1;
+	table->hint = w;
+	table->live++;
+	markProcessDirty(table, h);
+
+	table->id[h] = id;
+	table->arrival[h] = arrival;
+	table->run_count[h] = 0;
+	table->last_ran[h] = 0;
+	table->burst_left[h] = 0;
+	table->io_ticks[h] = 0;
+	table->blocked_at[h] = 0;
+	table->rand_state[h] = 0;
+	return h;
+}
+/************************************************************************************************************
+ * freeProcess
+ *
+ * Synopsis: void freeProcess (ProcessTable_p table, ProcHandle h)
+ *
+ * Description: Zeroes the columns of slot h, so the sums can keep running over every slot, and marks it
+ * free. The hint moves back if the slot lies before it.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void freeProcess (ProcessTable_p table, ProcHandle h) {
+	if (!isLiveProcess(table, h))
+		return;
+	table->id[h] = 0;
+	table->arrival[h] = 0;
+	table->run_count[h] = 0;
+	table->last_ran[h] = 0;
+	table->burst_left[h] = 0;
+	table->io_ticks[h] = 0;
+	table->blocked_at[h] = 0;
+	table->rand_state[h] = 0;
+	table->freeMap[h / 64] |= (uint64_t) 1 << (h % 64);
+	if (h / 64 < table->hint)
+		table->hint = h / 64;
+	table->live--;
+	markProcessDirty(table, h);
+}
+/************************************************************************************************************
+ * restoreProcess
+ *
+ * Synopsis: ProcHandle restoreProcess (ProcessTable_p table, ProcHandle h, Tick id, Tick arrival,
+ *                                      Tick run_count)
+ *
+ * Description: Puts a saved process back in its own slot, so the handles held by queues stay valid and
+ * later allocations pick the same slots they did in the saved run. Columns other than the three given
+ * are left to the caller. The hint goes back to the start,
+ * which keeps "every word before the hint is full" true whatever was restored.
+ *
+ * Returns: h, NO_PROCESS if h is negative or the table could not grow.
+ *
+ ************************************************************************************************************/
+ProcHandle restoreProcess (ProcessTable_p table, ProcHandle h, Tick id, Tick arrival, Tick run_count) {
+	int capacity;
+
+	if (table == NULL || h < 0)
+		return NO_PROCESS;
+	for (capacity = table->capacity; capacity <= h; capacity *= 2)
+		;
+	if (capacity != table->capacity && growTable(table, capacity) != 0)
+		return NO_PROCESS;
+	if (!isLiveProcess(table, h)) {
+		table->freeMap[h / 64] &= ~((uint64_t) 1 << (h % 64));
+		table->live++;
+	}
+	table->id[h] = id;
+	table->arrival[h] = arrival;
+	table->run_count[h] = run_count;
+	table->hint = 0;
+	markProcessDirty(table, h);
+	return h;
+}
+/************************************************************************************************************
+ * markProcessDirty / clearDirty
+ *
+ * Synopsis: void markProcessDirty (ProcessTable_p table, ProcHandle h)
+ *
+ * Description: Sets (clears every) bit of the dirty bitmap.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void markProcessDirty (ProcessTable_p table, ProcHandle h) {
+	if (table != NULL && h >= 0 && h < table->capacity)
+		table->dirtyMap[h / 64] |= (uint64_t) 1 << (h % 64);
+}
+
+void clearDirty (ProcessTable_p table) {
+	if (table != NULL)
+		memset(table->dirtyMap, 0, sizeof(uint64_t) * (size_t) (table->capacity / 64));
+}
+/************************************************************************************************************
+ * isLiveProcess / liveProcesses
+ *
+ * Synopsis: int isLiveProcess (ProcessTable_p table, ProcHandle h)
+ *
+ * Description: Status functions of the table.
+ *
+ * Returns: TRUE if slot h is in use (the # of processes in use).
+ *
+ ************************************************************************************************************/
+int isLiveProcess (ProcessTable_p table, ProcHandle h) {
+	if (table == NULL || h < 0 || h >= table->capacity)
+		return FALSE;
+	return !(table->freeMap[h / 64] >> (h % 64) & 1);
+}
+
+int liveProcesses (ProcessTable_p table) {
+	return (table != NULL) ? table->live : 0;
+}
+/************************************************************************************************************
+ * sumRunCount
+ *
+ * Synopsis: Tick sumRunCount (ProcessTable_p table)
+ *
+ * Description: Adds up the run counts over every slot. Free slots hold 0, so no slot has to be skipped and
+ * the loop vectorizes. Only one process runs per tick, so the sum never exceeds the clock.
+ *
+ * Returns: The sum, 0 if table is NULL.
+ *
+ ************************************************************************************************************/
+Tick sumRunCount (ProcessTable_p table) {
+	Tick sum = 0;
+	int i;
+
+	if (table == NULL)
+		return 0;
+	for (i = 0; i < table->capacity; i++)
+		sum += table->run_count[i];
+	return sum;
+}
+
+/************************************************************************************************************
+ * waitOf
+ *
+ * Synopsis: static Tick waitOf (ProcessTable_p table, ProcHandle h, Tick now)
+ *
+ * Description: The ticks process h spent in the system neither running nor blocked on I/O: since it
+ * arrived, less its run count, the I/O it completed and the I/O it is blocked on now.
+ *
+ * Returns: The wait of h.
+ *
+ ************************************************************************************************************/
+static Tick waitOf (ProcessTable_p table, ProcHandle h, Tick now) {
+	Tick wait = now - table->arrival[h] - table->run_count[h] - table->io_ticks[h];
+
+	if (table->blocked_at[h] > 0)
+		wait -= now - table->blocked_at[h];
+	return wait;
+}
+/************************************************************************************************************
+ * addWaits
+ *
+ * Synopsis: void addWaits (ProcessTable_p table, Tick now, KahanSum * waits)
+ *
+ * Description: For every live slot adds its wait (see waitOf()) to a compensated sum. A sum of the
+ * arrival column could overflow for a large table late in a long run; the waits are added one by one
+ * as doubles instead, one word of the bitmap at a time.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void addWaits (ProcessTable_p table, Tick now, KahanSum * waits) {
+	uint64_t used;
+	int w;
+	ProcHandle h;
+
+	if (table == NULL || waits == NULL)
+		return;
+	for (w = 0; w < table->capacity / 64; w++) {
+		for (used = ~table->freeMap[w]; used != 0; used &= used - 1) {
+			h = w * 64 + __builtin_ctzll(used);
+			kahanAdd(waits, (double) waitOf(table, h, now));
+		}
+	}
+}
@@ -0,0 +1,111 @@
+/*
+	process_table.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Header file for the process table.
+
+	process_table.c keeps every process of the simulator in one table laid out as a structure of arrays:
+	one array per field, indexed by a dense process handle. Touching one field of one process (the run
+	count of the running process, every tick) loads nothing else, and end of run statistics are plain
+	loops over contiguous arrays that the compiler vectorizes. A bitmap of free slots (one bit per slot,
+	set when the slot is free) finds a slot for a new process with one count-trailing-zeros per 64 slots.
+
+	            handle:   0     1     2     3     4   ...
+	    id            [  0  |  7  |  -  |  9  | 12  | ... ]
+	    arrival       [  0  | 310 |  0  | 377 | 402 | ... ]     free slots hold 0 in every column,
+	    run_count     [ 88  |  20 |  0  |  5  |  0  | ... ]     so sums need no mask
+	    last_ran      [ 340 | 371 |  0  | 398 |  0  | ... ]
+	    burst_left    [  0  |  14 |  0  |  3  | 40  | ... ]
+	    io_ticks      [  0  |  52 |  0  |  0  |  0  | ... ]
+	    blocked_at    [  0  |  0  |  0  | 401 |  0  | ... ]
+    rand_state    [  0  | 5e3 |  0  | 9a1 | 27c | ... ]
+	    free bitmap    0     0     1     0     0
+
+	Queues hold handles, not pointers: PROC_PAYLOAD(h) turns a handle into a non-NULL payload for the
+	Queue ADT and PROC_HANDLE(p) turns it back.
+
+	Slots that are allocated or freed are marked dirty, and so are slots the caller marks after changing
+	them, so a checkpoint can write only what changed since the previous one.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _PROCESS_TABLE_H_
+#define _PROCESS_TABLE_H_
+
+#include <stdint.h>
+
+#include "sim_stats.h"
+
+#define NO_PROCESS -1
+#define PROC_TABLE_MIN 64		// slots in a new table at the least (one bitmap word)
+
+#define PROC_PAYLOAD(h) ((void *) (intptr_t) ((h) + 1))
+#define PROC_HANDLE(p) ((ProcHandle) ((intptr_t) (p) - 1))
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef int ProcHandle;
+
+typedef struct process_table {
+	int capacity;			// # of slots, a multiple of 64
+	int live;				// # of slots in use
+	int hint;				// bitmap word to start the next search at
+	uint64_t * freeMap;		// bit h % 64 of word h / 64 is set when slot h is free
+	uint64_t * dirtyMap;	// same layout, set when slot h changed since the last clearDirty()
+	Tick * id;
+	Tick * arrival;			// tick the process arrived at
+	Tick * run_count;		// ticks the process has run
+	Tick * last_ran;		// tick the process was last switched off the CPU (if it has run)
+	Tick * burst_left;		// ticks to run before its next I/O (0: it does no I/O)
+	Tick * io_ticks;		// ticks spent blocked on I/O that completed
+	Tick * blocked_at;		// tick it blocked at while it waits for I/O, 0 otherwise
+	unsigned long long * rand_state;	// of its own random number stream (see rand_stream.h), 0 if it has none
+} ProcessTable;
+
+typedef ProcessTable * ProcessTable_p;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+ProcessTable_p createProcessTable (int capacity);
+// constructor for a table with room for capacity processes; it
+// grows when more are needed. Returns NULL if not successful
+
+void destroyProcessTable (ProcessTable_p table);
+
+ProcHandle allocProcess (ProcessTable_p table, Tick id, Tick arrival);
+// takes the lowest free slot and fills it in. Returns its handle,
+// NO_PROCESS if the table could not grow
+
+void freeProcess (ProcessTable_p table, ProcHandle h);
+// returns the slot to the table and clears its columns
+
+ProcHandle restoreProcess (ProcessTable_p table, ProcHandle h, Tick id, Tick arrival, Tick run_count);
+// fills slot h (growing the table if needed) as it was saved.
+// Returns h, NO_PROCESS if not successful
+
+void markProcessDirty (ProcessTable_p table, ProcHandle h);
+// notes that a column of slot h was changed by the caller
+
+void clearDirty (ProcessTable_p table);
+
+int isLiveProcess (ProcessTable_p table, ProcHandle h);
+// returns TRUE if h is a slot in use
+
+int liveProcesses (ProcessTable_p table);
+// returns the # of processes in the table
+
+Tick sumRunCount (ProcessTable_p table);
+// returns the run counts of all live processes added up
+
+void addWaits (ProcessTable_p table, Tick now, KahanSum * waits);
+// adds the ticks every live process has waited since it arrived
+// (neither running nor blocked on I/O) to waits
+
+#endif
@@ -34,6 +34,9 @@ Queue_p createQueue(char * title, int limit) {
 	Queue_p my_queue = (Queue_p) malloc (sizeof(Queue));
 	my_queue->queue = createList(title);
 	my_queue->limit = limit;
+	my_queue->policy = QUEUE_REJECT;
+	my_queue->drop = NULL;
+	memset(&my_queue->stats, 0, sizeof(QueueStats));
 	return my_queue;
 }
 /************************************************************************************************************
@@ -77,28 +80,132 @@ int isEmpty (Queue_p queue) {
  * Synopsis: int isFull (Queue_p queue)
  *
  * Description: This function checks to see if the queue is full by comparing the # of items
- * in the queue with the queue limit.
+ * in the queue with the queue limit. A queue with NO_LIMIT is never full.
  *
  * Returns: TRUE if full(1), FALSE is not(0).
  *
  ************************************************************************************************************/
 int isFull (Queue_p queue) {
-	if (queue == NULL || queue->queue == NULL)
+	if (queue == NULL || queue->queue == NULL || queue->limit == NO_LIMIT)
 		return FALSE;
 
-	if (sizeList(queue->queue) == queue->limit)
+	if (sizeList(queue->queue) >= queue->limit)
 		return TRUE;
 	else 
 		return FALSE;
 }
+/************************************************************************************************************
+ * setQueuePolicy
+ *
+ * Synopsis: int setQueuePolicy (Queue_p queue, int policy, DataDestructor drop)
+ *
+ * Description: This function sets the admission policy of the queue, and the function that releases
+ * the items QUEUE_DROP_OLDEST drops (free() if drop is NULL).
+ *
+ * Returns: TRUE if successful, PUSH_ERROR if not.
+ *
+ ************************************************************************************************************/
+int setQueuePolicy (Queue_p queue, int policy, DataDestructor drop) {
+	if (queue == NULL || policy < QUEUE_REJECT || policy > QUEUE_BLOCK)
+		return PUSH_ERROR;
+	queue->policy = policy;
+	queue->drop = drop;
+	return TRUE;
+}
+/************************************************************************************************************
+ * getQueueStats
+ *
+ * Synopsis: void getQueueStats (Queue_p queue, QueueStats * stats)
+ *
+ * Description: This function copies the admission counters of the queue to stats.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void getQueueStats (Queue_p queue, QueueStats * stats) {
+	if (queue == NULL || stats == NULL)
+		return;
+	*stats = queue->stats;
+}
+/************************************************************************************************************
+ * admit
+ *
+ * Synopsis: static int admit (Queue_p queue)
+ *
+ * Description: This function decides whether a new item may join the queue. Below the limit it always
+ * may; at the limit QUEUE_DROP_OLDEST removes the item at the head of the list (the one added first) to
+ * make room, or refuses the item if the queue is empty (a limit of 0), the other policies refuse it. A
+ * queue has no thread to wait on, so under QUEUE_BLOCK the caller keeps the item and stops producing
+ * until isFull() is FALSE again.
+ *
+ * Returns: TRUE if the item may be added, QUEUE_FULL_ERROR if not.
+ *
+ ************************************************************************************************************/
+static int admit (Queue_p queue) {
+	char * oldest;
+
+	if (!isFull(queue)) {
+		queue->stats.admitted++;
+		return TRUE;
+	}
+	switch (queue->policy) {
+		case QUEUE_DROP_OLDEST:
+			oldest = removeDataFromHead(queue->queue);
+			if (oldest == NULL) {
+				queue->stats.rejected++;
+				return QUEUE_FULL_ERROR;
+			}
+			if (queue->drop != NULL)
+				queue->drop(oldest);
+			else
+				free(oldest);
+			queue->stats.dropped++;
+			queue->stats.admitted++;
+			return TRUE;
+		case QUEUE_BLOCK:
+			queue->stats.blocked++;
+			return QUEUE_FULL_ERROR;
+		default:
+			queue->stats.rejected++;
+			return QUEUE_FULL_ERROR;
+	}
+}
+/************************************************************************************************************
+ * pop
+ *
+ * Synopsis: char * pop (Queue_p queue)
+ *
+ * Description: Same as dequeue.
+ *
+ * Returns: A pointer to the data in the heap if successful, NULL otherwise.
+ *
+ ************************************************************************************************************/
+char * pop (Queue_p queue) {
+	return dequeue(queue);
+}
+/************************************************************************************************************
+ * push
+ *
+ * Synopsis: int push (Queue_p queue, char * data)
+ *
+ * Description: Same as enqueue.
+ *
+ * Returns: TRUE if successful, error code if not.
+ *
+ ************************************************************************************************************/
+int push (Queue_p queue, char * data) {
+	int ret = enqueue(queue, data);
+
+	return (ret == NO_ERROR) ? TRUE : ret;
+}
 /************************************************************************************************************
  * dequeue
  *
  * Synopsis: char * dequeue (Queue_p queue)
  *
- * Description: This function pops the last item added to the queue. In other words, it removes from end
- * of the list. It helps to think about it as if your stacking plates on top of each other. So a pop
- * is simply removing the very bottom plate added(the last item added to the queue).
+ * Description: This function removes the item that has waited longest, first in first out. enqueue adds
+ * at the end of the list and dequeue takes from its head, so an item that is put back (requeuePayload)
+ * goes behind everything already waiting.
  *
  * Returns: A pointer to the data in the heap if successful, NULL otherwise.
  *
@@ -107,7 +214,7 @@ char * dequeue (Queue_p queue) {
 	if (queue == NULL || queue->queue == NULL)
 		return NULL;
 	else 
-		return removeDataFromTail(queue->queue);
+		return removeDataFromHead(queue->queue);
 }			
 /************************************************************************************************************
  * enqueue
@@ -115,7 +222,8 @@ char * dequeue (Queue_p queue) {
  * Synopsis: int enqueue (Queue_p queue, char * data)
  *
  * Description: This function pushes the items to the end of the queue. In other words, it's adding
- * to end of the list. Think about as if your stacking plates on underneath of each other.
+ * to end of the list. Think about as if your stacking plates on underneath of each other. A full queue
+ * applies its admission policy first.
  *
  * Returns: TRUE if successful, error code if not.
  *
@@ -123,9 +231,48 @@ char * dequeue (Queue_p queue) {
 int enqueue (Queue_p queue, char * data) {
 	if (queue == NULL || queue->queue == NULL || data == NULL)
 		return PUSH_ERROR;
+	else if (admit(queue) != TRUE)
+		return QUEUE_FULL_ERROR;
 	else
 		return appendData(queue->queue, data);
 }		
+/************************************************************************************************************
+ * enqueuePayload
+ *
+ * Synopsis: int enqueuePayload (Queue_p queue, void * data)
+ *
+ * Description: This function adds the pointer itself to the end of the queue, nothing is copied. The
+ * queue never frees the payload, the caller gets it back from dequeue (or through the drop function of
+ * setQueuePolicy when it is dropped).
+ *
+ * Returns: TRUE if successful, error code if not.
+ *
+ ************************************************************************************************************/
+int enqueuePayload (Queue_p queue, void * data) {
+	if (queue == NULL || queue->queue == NULL || data == NULL)
+		return PUSH_ERROR;
+	else if (admit(queue) != TRUE)
+		return QUEUE_FULL_ERROR;
+	else
+		return appendPayload(queue->queue, data, NULL);
+}
+/************************************************************************************************************
+ * requeuePayload
+ *
+ * Synopsis: int requeuePayload (Queue_p queue, void * data)
+ *
+ * Description: This function puts back a payload that was admitted before, without applying the limit,
+ * so a process that is preempted never loses its place in the system.
+ *
+ * Returns: TRUE if successful, error code if not.
+ *
+ ************************************************************************************************************/
+int requeuePayload (Queue_p queue, void * data) {
+	if (queue == NULL || queue->queue == NULL || data == NULL)
+		return PUSH_ERROR;
+	else
+		return appendPayload(queue->queue, data, NULL);
+}
 
 
 /*int main() {
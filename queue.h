@@ -11,6 +11,9 @@
 /*********************************************************************************************************
  *                                        Preprocessor Directives
  ********************************************************************************************************/
+#ifndef _QUEUE_H_
+#define _QUEUE_H_
+
 #include "d_linkedList.h"
 
 #define PUSH_ERROR -1
@@ -18,6 +21,11 @@
 
 #define NO_LIMIT -1
 
+// what happens to an item that arrives at a full queue
+#define QUEUE_REJECT 0			// the item is refused (default)
+#define QUEUE_DROP_OLDEST 1		// the item waiting longest is dropped to make room
+#define QUEUE_BLOCK 2			// the item is refused and the caller holds it until isFull() clears
+
 #define TRUE 1
 #define FALSE 0
 
@@ -25,9 +33,19 @@
  *                                              ADTs
  ********************************************************************************************************/
 
+typedef struct queue_stats {
+	long long admitted;	// items taken in by enqueue, enqueuePayload and push
+	long long rejected;	// items refused by QUEUE_REJECT
+	long long dropped;	// items dropped by QUEUE_DROP_OLDEST
+	long long blocked;	// items refused by QUEUE_BLOCK
+} QueueStats;
+
 typedef struct queue {
 	List_p queue;		// implement the queue using a doubly linked list
 	int limit;			// used to enforce a limited queue object
+	int policy;			// QUEUE_REJECT, QUEUE_DROP_OLDEST or QUEUE_BLOCK
+	DataDestructor drop;// releases a dropped item
+	QueueStats stats;
 } Queue;
 
 typedef Queue * Queue_p;
@@ -45,7 +63,14 @@ int isEmpty (Queue_p queue);
 // returns TRUE or FALSE
 
 int isFull (Queue_p queue);						
-// returns TRUE if queue->count == limit
+// returns TRUE if queue->count has reached limit
+
+int setQueuePolicy (Queue_p queue, int policy, DataDestructor drop);
+// chooses what enqueue does at a full queue. drop releases the
+// items dropped by QUEUE_DROP_OLDEST (NULL: free()). Returns
+// TRUE, or PUSH_ERROR on a bad policy
+
+void getQueueStats (Queue_p queue, QueueStats * stats);
 
 char * pop (Queue_p queue);						
 // returns a pointer to data in the heap if successful,
@@ -53,3 +78,23 @@ char * pop (Queue_p queue);
 
 int push (Queue_p queue, char * data);			
 // returns TRUE if successful, error code if not
+
+char * dequeue (Queue_p queue);
+// removes the item that waited longest (first in first out) and
+// returns a pointer to its data if successful, NULL otherwise
+
+int enqueue (Queue_p queue, char * data);
+// returns TRUE if successful, error code if not.
+// QUEUE_FULL_ERROR if the queue is full and its policy refuses
+// the item
+
+int enqueuePayload (Queue_p queue, void * data);
+// same as enqueue but stores the pointer itself (a struct,
+// a process...) instead of a copy of a string. The queue
+// does not free it (unless it is dropped)
+
+int requeuePayload (Queue_p queue, void * data);
+// same as enqueuePayload for an item that was admitted before
+// (a preempted process...), the limit does not apply
+
+#endif
@@ -0,0 +1,126 @@
+/*
+	rand_stream.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Implementation of the random number substreams of the simulator (see rand_stream.h).
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include "rand_stream.h"
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * jumpAhead
+ *
+ * Synopsis: unsigned long long jumpAhead (unsigned long long state, unsigned long long draws)
+ *
+ * Description: One step is the affine map x -> x * a + c mod 2^64; the map composed with itself is again
+ * affine, x -> x * a^2 + (a + 1) * c, so squaring and multiplying maps as powers are squared and
+ * multiplied gives the map of draws steps in log2(draws) rounds (F. Brown, "Random Number Generation with
+ * Arbitrary Stride", 1994). Unsigned arithmetic wraps mod 2^64, which is the modulus.
+ *
+ * Returns: The state draws steps on.
+ *
+ ************************************************************************************************************/
+unsigned long long jumpAhead (unsigned long long state, unsigned long long draws) {
+	unsigned long long multiply = 1, add = 0;					// the map of the draws so far
+	unsigned long long power = RAND_MULTIPLIER, shift = RAND_INCREMENT;	// the map of 2^i steps
+
+	for (; draws > 0; draws >>= 1) {
+		if (draws & 1) {
+			multiply *= power;
+			add = add * power + shift;
+		}
+		shift *= power + 1;
+		power *= power;
+	}
+	return state * multiply + add;
+}
+/************************************************************************************************************
+ * streamSpacing
+ *
+ * Synopsis: long long streamSpacing (int replications)
+ *
+ * Description: Splits the cycle of the LCG evenly between the substreams of every replication.
+ *
+ * Returns: The # of draws between the starts of neighbouring substreams.
+ *
+ ************************************************************************************************************/
+long long streamSpacing (int replications) {
+	if (replications < 1)
+		replications = 1;
+	// (2^64 - 1) / n, as 2^64 itself does not fit in 64 bits
+	return (long long) (~0ULL / ((unsigned long long) RAND_STREAMS * (unsigned long long) replications));
+}
+/************************************************************************************************************
+ * seedStreams
+ *
+ * Synopsis: void seedStreams (RandStream * streams, long seed, int replication, int replications,
+ *                             int antithetic)
+ *
+ * Description: Substream s of replication r starts (r * RAND_STREAMS + s) spacings after the seed, so
+ * the same seed, replication and # of replications give the same samples in every run.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void seedStreams (RandStream * streams, long seed, int replication, int replications, int antithetic) {
+	unsigned long long spacing = (unsigned long long) streamSpacing(replications);
+	unsigned long long start = (seed > 0) ? (unsigned long long) seed : 1;
+	int s;
+
+	for (s = 0; s < RAND_STREAMS; s++) {
+		streams[s].state = jumpAhead(start, ((unsigned long long) replication * RAND_STREAMS + s) * spacing);
+		streams[s].antithetic = antithetic;
+	}
+}
+/************************************************************************************************************
+ * splitStream
+ *
+ * Synopsis: unsigned long long splitStream (RandStream_p stream)
+ *
+ * Description: Steps stream once and starts the new stream x steps after state 0 of the cycle, x being
+ * the 64 bit state stream stepped to. Starting at x itself would make the new stream the continuation of
+ * stream: its first sample would be the one stream draws next.
+ *
+ * Returns: The state of the new stream.
+ *
+ ************************************************************************************************************/
+unsigned long long splitStream (RandStream_p stream) {
+	RandStream plain = { stream->state, 0 };
+
+	rand_val(&plain);
+	stream->state = plain.state;
+	return jumpAhead(0, plain.state);
+}
+/************************************************************************************************************
+ * rand_val
+ *
+ * Synopsis: double rand_val (RandStream_p stream)
+ *
+ * Description: Steps the LCG and permutes the state it stepped from into 32 bits r (PCG32's XSH RR
+ * output: the state's high bits xorshifted down, rotated by its top 5 bits). The sample is (r + 0.5) /
+ * 2^32, never 0 or 1; the antithetic one is 1 minus it, the sample of 2^32 - 1 - r.
+ *
+ * Returns: A uniform (0, 1) sample.
+ *
+ ************************************************************************************************************/
+double rand_val (RandStream_p stream) {
+	unsigned long long x = stream->state;
+	unsigned int xorshifted, rotation, r;
+
+	stream->state = x * RAND_MULTIPLIER + RAND_INCREMENT;
+	xorshifted = (unsigned int) (((x >> 18) ^ x) >> 27);
+	rotation = (unsigned int) (x >> 59);
+	r = (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+	if (stream->antithetic)
+		r = 0xffffffffu - r;
+	return (r + 0.5) / 4294967296.0;
+}
@@ -0,0 +1,88 @@
+/*
+	rand_stream.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Header file for the random number substreams of the simulator.
+
+	Every stochastic element of the simulator draws from its own substream of the generator of
+	rand_val(): arrivals from one, terminations from another, per-process samples from a third. Two runs
+	with the same seed and replication then see the same arrivals and terminations whatever else differs
+	between them (the time slice, say, or how often the scheduler draws for its processes), and a
+	comparison of the two measures the difference of the configurations rather than of the samples. These
+	are common random numbers.
+
+	The generator is PCG32 (M. E. O'Neill, "PCG: A Family of Simple Fast Space-Efficient Statistically
+	Good Algorithms for Random Number Generation", 2014): a 64 bit LCG, x * a + c mod 2^64, with one
+	cycle of 2^64 states, whose state is permuted (xorshift, then a rotation by its top bits) into 32
+	output bits. The substreams are disjoint stretches of the cycle, found by jumping ahead (composing
+	the step with itself, log2 k squarings for k draws) rather than by drawing:
+
+	    cycle  |arrivals r0|terminations r0|service r0|arrivals r1|terminations r1| ...
+	            <-spacing->
+
+	The spacing is the cycle over the # of substreams in use, so a single run gets about 6 * 10^18 draws
+	per substream and 1000 replications about 6 * 10^15, far more than a run of max_ticks can draw (one
+	arrival and one termination draw a tick). The simulator refuses a run longer than the spacing rather
+	than let it wrap into the next substream.
+
+	The samples of a process (its bursts, the device it picks, how long the device takes) come from a
+	stream of its own, split off the service substream when it arrives. Arrivals are common to both runs,
+	so a process gets the same stream in each, and its k-th burst is the same however the time slice
+	interleaves it with the others. Drawn from one shared stream, the samples would go to whichever
+	process happened to ask next, and the two runs would part after the first difference.
+
+	An antithetic stream returns 1 - u for every u the plain one would: a replication run with both sees
+	negatively correlated samples, and the mean of the pair varies less than either run.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _RAND_STREAM_H_
+#define _RAND_STREAM_H_
+
+#define RAND_MULTIPLIER 6364136223846793005ULL
+#define RAND_INCREMENT 1442695040888963407ULL		// odd, so the cycle is all of 2^64
+
+// substreams of a replication
+#define STREAM_ARRIVALS 0		// whether a process arrives, once per tick
+#define STREAM_TERMINATIONS 1	// whether the running process terminates, once per tick
+#define STREAM_SERVICE 2		// the streams of the processes are split off it
+#define RAND_STREAMS 3
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct rand_stream {
+	unsigned long long state;	// last value of the LCG, any 64 bits
+	int antithetic;			// TRUE to return 1 - u instead of u
+} RandStream;
+
+typedef RandStream * RandStream_p;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+void seedStreams (RandStream * streams, long seed, int replication, int replications, int antithetic);
+// sets streams[0 .. RAND_STREAMS - 1] to the substreams of
+// replication (0 .. replications - 1) of seed (a seed of 0 or
+// less means 1)
+
+long long streamSpacing (int replications);
+// returns the # of draws each substream has before it runs into
+// the next one
+
+unsigned long long jumpAhead (unsigned long long state, unsigned long long draws);
+// returns the state of the LCG draws steps after state
+
+unsigned long long splitStream (RandStream_p stream);
+// returns the state a new stream starts at, picked by the next
+// draw of stream (the same whether stream is antithetic or not)
+
+double rand_val (RandStream_p stream);
+// returns the next uniform (0, 1) sample of stream
+
+#endif
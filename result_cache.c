@@ -0,0 +1,392 @@
+/*
+	result_cache.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Implementation of the on-disk result cache (see result_cache.h). A record goes out with a
+	single write at the end of the data file, and only then its index entry.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+#include "result_cache.h"
+
+#define FNV64_OFFSET 0xcbf29ce484222325ull
+#define FNV64_PRIME 0x100000001b3ull
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct record_header {		// followed by the key and the result
+	uint32_t magic;
+	uint32_t keyLength;
+	uint64_t hash;					// of the key
+	uint64_t resultLength;
+	uint64_t checksum;				// of the key and the result
+} RecordHeader;
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * hashBytes
+ *
+ * Synopsis: static uint64_t hashBytes (uint64_t hash, const void * data, size_t length)
+ *
+ * Description: Goes on with FNV-1a from hash over length bytes, so a hash can cover several blocks.
+ *
+ * Returns: The 64 bit hash.
+ *
+ ************************************************************************************************************/
+static uint64_t hashBytes (uint64_t hash, const void * data, size_t length) {
+	const unsigned char * bytes = (const unsigned char *) data;
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		hash ^= bytes[i];
+		hash *= FNV64_PRIME;
+	}
+	return hash;
+}
+/************************************************************************************************************
+ * writeAll / readAll
+ *
+ * Synopsis: static int writeAll (int fd, const char * data, size_t length, off_t pos)
+ *
+ * Description: pwrite() (pread()) of length bytes at pos, retrying short and interrupted calls.
+ *
+ * Returns: 0, or -1 if the call failed or the file ended first.
+ *
+ ************************************************************************************************************/
+static int writeAll (int fd, const char * data, size_t length, off_t pos) {
+	while (length > 0) {
+		ssize_t n = pwrite(fd, data, length, pos);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return -1;
+		data += n;
+		length -= (size_t) n;
+		pos += n;
+	}
+	return 0;
+}
+
+static int readAll (int fd, char * data, size_t length, off_t pos) {
+	while (length > 0) {
+		ssize_t n = pread(fd, data, length, pos);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return -1;
+		data += n;
+		length -= (size_t) n;
+		pos += n;
+	}
+	return 0;
+}
+/************************************************************************************************************
+ * lockCache
+ *
+ * Synopsis: static int lockCache (ResultCache_p cache, int operation)
+ *
+ * Description: flock() on the data file (LOCK_SH, LOCK_EX or LOCK_UN), waiting out signals.
+ *
+ * Returns: 0, or -1 if the lock could not be taken.
+ *
+ ************************************************************************************************************/
+static int lockCache (ResultCache_p cache, int operation) {
+	int status;
+
+	do
+		status = flock(cache->data, operation);
+	while (status != 0 && errno == EINTR);
+	return status;
+}
+/************************************************************************************************************
+ * openResultCache
+ *
+ * Synopsis: ResultCache_p openResultCache (const char * path)
+ *
+ * Description: Opens (creates) the data file and the index.
+ *
+ * Returns: A pointer to the cache in the heap, NULL if not successful.
+ *
+ ************************************************************************************************************/
+ResultCache_p openResultCache (const char * path) {
+	ResultCache_p cache = (ResultCache_p) calloc (1, sizeof(ResultCache));
+
+	if (cache == NULL || path == NULL) {
+		free(cache);
+		return NULL;
+	}
+	cache->data = -1;
+	cache->index = -1;
+	cache->path = strdup(path);
+	cache->indexPath = (char *) malloc (strlen(path) + sizeof(".index"));
+	if (cache->path == NULL || cache->indexPath == NULL) {
+		closeResultCache(cache);
+		return NULL;
+	}
+	sprintf(cache->indexPath, "%s.index", path);
+	cache->slots = (long long *) malloc (sizeof(long long) * CACHE_MIN_SLOTS);
+	if (cache->slots == NULL) {
+		closeResultCache(cache);
+		return NULL;
+	}
+	cache->nslots = CACHE_MIN_SLOTS;
+	memset(cache->slots, 0xff, sizeof(long long) * CACHE_MIN_SLOTS);	// all -1
+	cache->data = open(cache->path, O_RDWR | O_CREAT, 0644);
+	cache->index = open(cache->indexPath, O_RDWR | O_CREAT, 0644);
+	if (cache->data < 0 || cache->index < 0) {
+		closeResultCache(cache);
+		return NULL;
+	}
+	return cache;
+}
+/************************************************************************************************************
+ * closeResultCache
+ *
+ * Synopsis: void closeResultCache (ResultCache_p cache)
+ *
+ * Description: Closes the files and frees the cache.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void closeResultCache (ResultCache_p cache) {
+	if (cache == NULL)
+		return;
+	if (cache->data >= 0)
+		close(cache->data);
+	if (cache->index >= 0)
+		close(cache->index);
+	free(cache->path);
+	free(cache->indexPath);
+	free(cache->entries);
+	free(cache->older);
+	free(cache->slots);
+	free(cache);
+}
+/************************************************************************************************************
+ * findSlot
+ *
+ * Synopsis: static long long findSlot (const long long * slots, long long nslots, const IndexEntry * entries,
+ *                                      uint64_t hash)
+ *
+ * Description: Linear probing from the low bits of hash (an FNV-1a hash, so they are well mixed) for the
+ * slot of hash, or the empty slot where it goes.
+ *
+ * Returns: The slot.
+ *
+ ************************************************************************************************************/
+static long long findSlot (const long long * slots, long long nslots, const IndexEntry * entries,
+		uint64_t hash) {
+	long long i = (long long) (hash & (uint64_t) (nslots - 1));
+
+	while (slots[i] >= 0 && entries[slots[i]].hash != hash)
+		i = (i + 1) & (nslots - 1);
+	return i;
+}
+/************************************************************************************************************
+ * readIndex
+ *
+ * Synopsis: static int readIndex (ResultCache_p cache, long long count)
+ *
+ * Description: Brings the table up to the first count entries of the index file: reads the entries
+ * after those already read and makes each the newest of its hash. The arrays grow by doubling, the
+ * slots are rehashed when the table would be more than half full. An index shorter than what was read
+ * (the file was replaced) is read again from the start.
+ *
+ * Returns: 0, or -1 if the index could not be read or there is no memory for it (the table is then left
+ * as it was, less any entries it was reading).
+ *
+ ************************************************************************************************************/
+static int readIndex (ResultCache_p cache, long long count) {
+	long long capacity, nslots, i, s;
+	IndexEntry * entries;
+	long long * older;
+	long long * slots;
+
+	if (count < cache->count) {
+		cache->count = 0;
+		memset(cache->slots, 0xff, sizeof(long long) * (size_t) cache->nslots);
+	}
+	if (count == cache->count)
+		return 0;
+	if (count > cache->capacity) {
+		for (capacity = (cache->capacity > 0) ? cache->capacity : CACHE_MIN_SLOTS / 2; capacity < count; )
+			capacity *= 2;
+		entries = (IndexEntry *) realloc (cache->entries, sizeof(IndexEntry) * (size_t) capacity);
+		if (entries != NULL)
+			cache->entries = entries;
+		older = (long long *) realloc (cache->older, sizeof(long long) * (size_t) capacity);
+		if (older != NULL)
+			cache->older = older;
+		if (entries == NULL || older == NULL)
+			return -1;
+		cache->capacity = capacity;
+	}
+	if (count * 2 > cache->nslots) {
+		for (nslots = cache->nslots; count * 2 > nslots; )
+			nslots *= 2;
+		slots = (long long *) malloc (sizeof(long long) * (size_t) nslots);
+		if (slots == NULL)
+			return -1;
+		memset(slots, 0xff, sizeof(long long) * (size_t) nslots);
+		for (i = 0; i < cache->nslots; i++)
+			if (cache->slots[i] >= 0)
+				slots[findSlot(slots, nslots, cache->entries, cache->entries[cache->slots[i]].hash)] =
+					cache->slots[i];
+		free(cache->slots);
+		cache->slots = slots;
+		cache->nslots = nslots;
+	}
+	if (readAll(cache->index, (char *) (cache->entries + cache->count),
+			sizeof(IndexEntry) * (size_t) (count - cache->count),
+			(off_t) (sizeof(IndexEntry) * cache->count)) != 0)
+		return -1;
+	for (i = cache->count; i < count; i++) {
+		s = findSlot(cache->slots, cache->nslots, cache->entries, cache->entries[i].hash);
+		cache->older[i] = cache->slots[s];
+		cache->slots[s] = i;
+	}
+	cache->count = count;
+	return 0;
+}
+/************************************************************************************************************
+ * readRecord
+ *
+ * Synopsis: static int readRecord (ResultCache_p cache, uint64_t offset, off_t end, uint64_t hash,
+ *                                  const void * key, size_t keyLength, char ** result, size_t * length)
+ *
+ * Description: Reads the record at offset and checks that it is whole (magic, lengths within the file,
+ * checksum) and that it is stored under key.
+ *
+ * Returns: CACHE_HIT with the result in *result and *length, CACHE_MISS if the record is another key's
+ * or damaged.
+ *
+ ************************************************************************************************************/
+static int readRecord (ResultCache_p cache, uint64_t offset, off_t end, uint64_t hash, const void * key,
+		size_t keyLength, char ** result, size_t * length) {
+	RecordHeader header;
+	char * body;
+	size_t size;
+
+	if (offset + sizeof(header) > (uint64_t) end ||
+			readAll(cache->data, (char *) &header, sizeof(header), (off_t) offset) != 0)
+		return CACHE_MISS;
+	if (header.magic != CACHE_RECORD_MAGIC || header.hash != hash || header.keyLength != keyLength ||
+			keyLength > (uint64_t) end - offset - sizeof(header) ||
+			header.resultLength > (uint64_t) end - offset - sizeof(header) - keyLength)
+		return CACHE_MISS;
+	size = keyLength + (size_t) header.resultLength;
+	body = (char *) malloc (size + 1);
+	if (body == NULL)
+		return CACHE_MISS;
+	if (readAll(cache->data, body, size, (off_t) (offset + sizeof(header))) != 0 ||
+			hashBytes(FNV64_OFFSET, body, size) != header.checksum || memcmp(body, key, keyLength) != 0) {
+		free(body);
+		return CACHE_MISS;
+	}
+	memmove(body, body + keyLength, (size_t) header.resultLength);
+	body[header.resultLength] = '\0';
+	*result = body;
+	*length = (size_t) header.resultLength;
+	return CACHE_HIT;
+}
+/************************************************************************************************************
+ * lookupResult
+ *
+ * Synopsis: int lookupResult (ResultCache_p cache, const void * key, size_t keyLength, char ** result,
+ *                             size_t * length)
+ *
+ * Description: Under a shared lock, reads the entries appended to the index since the last lookup and
+ * tries the records whose hash is that of key, newest first, until one holds key. A partial entry at
+ * the end of the index (a store that was cut short) is left out.
+ *
+ * Returns: CACHE_HIT, CACHE_MISS or CACHE_ERROR.
+ *
+ ************************************************************************************************************/
+int lookupResult (ResultCache_p cache, const void * key, size_t keyLength, char ** result, size_t * length) {
+	uint64_t hash = hashBytes(FNV64_OFFSET, key, keyLength);
+	struct stat index;
+	struct stat data;
+	long long i;
+	int found = CACHE_MISS;
+
+	if (cache == NULL || lockCache(cache, LOCK_SH) != 0)
+		return CACHE_ERROR;
+	if (fstat(cache->index, &index) != 0 || fstat(cache->data, &data) != 0 ||
+			readIndex(cache, (long long) index.st_size / (long long) sizeof(IndexEntry)) != 0)
+		found = CACHE_ERROR;
+	i = (found == CACHE_MISS) ?
+		cache->slots[findSlot(cache->slots, cache->nslots, cache->entries, hash)] : -1;
+	for ( ; i >= 0 && found == CACHE_MISS; i = cache->older[i])
+		found = readRecord(cache, cache->entries[i].offset, data.st_size, hash, key, keyLength, result,
+			length);
+	lockCache(cache, LOCK_UN);
+	return found;
+}
+/************************************************************************************************************
+ * storeResult
+ *
+ * Synopsis: int storeResult (ResultCache_p cache, const void * key, size_t keyLength, const char * result,
+ *                            size_t length)
+ *
+ * Description: Under an exclusive lock, writes the record at the end of the data file and then its
+ * entry at the end of the index (over a partial entry, if a store was cut short there). A crash between
+ * the two leaves a record no entry points at, which is only wasted space.
+ *
+ * Returns: CACHE_OK, or CACHE_ERROR if the cache could not be written.
+ *
+ ************************************************************************************************************/
+int storeResult (ResultCache_p cache, const void * key, size_t keyLength, const char * result, size_t length) {
+	RecordHeader header;
+	IndexEntry entry;
+	struct stat st;
+	char * record;
+	int status = CACHE_ERROR;
+
+	if (cache == NULL || keyLength > UINT32_MAX)
+		return CACHE_ERROR;
+	record = (char *) malloc (sizeof(header) + keyLength + length);
+	if (record == NULL)
+		return CACHE_ERROR;
+	memset(&header, 0, sizeof(header));
+	header.magic = CACHE_RECORD_MAGIC;
+	header.keyLength = (uint32_t) keyLength;
+	header.hash = hashBytes(FNV64_OFFSET, key, keyLength);
+	header.resultLength = length;
+	header.checksum = hashBytes(hashBytes(FNV64_OFFSET, key, keyLength), result, length);
+	memcpy(record, &header, sizeof(header));
+	memcpy(record + sizeof(header), key, keyLength);
+	memcpy(record + sizeof(header) + keyLength, result, length);
+
+	if (lockCache(cache, LOCK_EX) == 0) {
+		entry.hash = header.hash;
+		if (fstat(cache->data, &st) == 0) {
+			entry.offset = (uint64_t) st.st_size;
+			if (writeAll(cache->data, record, sizeof(header) + keyLength + length, st.st_size) == 0 &&
+					fstat(cache->index, &st) == 0 &&
+					writeAll(cache->index, (const char *) &entry, sizeof(entry),
+						st.st_size - st.st_size % (off_t) sizeof(entry)) == 0)
+				status = CACHE_OK;
+		}
+		lockCache(cache, LOCK_UN);
+	}
+	free(record);
+	return status;
+}
@@ -0,0 +1,87 @@
+/*
+	result_cache.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Header file for the on-disk cache of simulation results.
+
+	A result is stored under a key, a block of bytes that is the same for every request that has to give
+	the same result (for the simulator: its arguments and build, see RunKey). The cache is two files that
+	are only ever appended to:
+
+	  PATH          record | record | ...     each: RecordHeader | key | result
+	  PATH.index    entry | entry | ...       each: 64 bit FNV-1a hash of the key | offset of its record
+
+	The index, 16 bytes per result, is kept in memory in a hash table on the key hashes, each slot holding
+	the newest entry of its hash and every entry the one before it with the same hash. A lookup first
+	reads the entries other processes (or this one) appended since the last lookup, then only reads the
+	records of its hash, newest first; the key itself is compared before a record counts as a hit, so a
+	hash collision costs a read, never a wrong result. Every record carries a checksum, so one that a
+	crash left half written is skipped.
+
+	Any number of processes can use the same cache at once: lookups hold a shared flock() on PATH, stores
+	an exclusive one while they append. Two workers that miss on the same key both store it, and a later
+	lookup takes the newest.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _RESULT_CACHE_H_
+#define _RESULT_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CACHE_RECORD_MAGIC 0x544c5352u		// "RSLT"
+#define CACHE_MIN_SLOTS 1024				// of the hash table, a power of 2
+
+#define CACHE_HIT 1
+#define CACHE_MISS 0
+#define CACHE_OK 0
+#define CACHE_ERROR -1
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct index_entry {	// of PATH.index
+	uint64_t hash;
+	uint64_t offset;			// of the RecordHeader in the data file
+} IndexEntry;
+
+typedef struct result_cache {
+	char * path;
+	char * indexPath;
+	int data;				// descriptors of the two files, the data file also carries the lock
+	int index;
+	IndexEntry * entries;	// of the index read so far, in file order
+	long long * older;		// per entry: the entry before with the same hash, -1 if none
+	long long count;		// # of entries read
+	long long capacity;		// of entries and older
+	long long * slots;		// newest entry of a hash by open addressing, -1 if empty
+	long long nslots;		// a power of 2, at least twice count
+} ResultCache;
+
+typedef ResultCache * ResultCache_p;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+ResultCache_p openResultCache (const char * path);
+// opens the cache at path (and path.index), creating it if there
+// is none. NULL if not successful
+
+void closeResultCache (ResultCache_p cache);
+
+int lookupResult (ResultCache_p cache, const void * key, size_t keyLength, char ** result, size_t * length);
+// returns CACHE_HIT with the newest result stored under key in
+// *result (in the heap, the caller frees it) and its size in
+// *length, CACHE_MISS if there is none, CACHE_ERROR if the cache
+// could not be read
+
+int storeResult (ResultCache_p cache, const void * key, size_t keyLength, const char * result, size_t length);
+// appends result under key. Returns CACHE_OK or CACHE_ERROR
+
+#endif
@@ -0,0 +1,211 @@
+/*
+	sim_stats.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Implementation of the counters and accumulators of the simulator (see sim_stats.h).
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "sim_stats.h"
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * addSaturated
+ *
+ * Synopsis: Tick addSaturated (Tick a, Tick b)
+ *
+ * Description: Adds two counters, clamping the result to the range of a Tick.
+ *
+ * Returns: a + b, or the bound it crossed.
+ *
+ ************************************************************************************************************/
+Tick addSaturated (Tick a, Tick b) {
+	Tick sum;
+
+	if (__builtin_add_overflow(a, b, &sum))
+		return (b > 0) ? TICK_MAX : -TICK_MAX - 1;
+	return sum;
+}
+/************************************************************************************************************
+ * parseTicks
+ *
+ * Synopsis: Tick parseTicks (const char * text)
+ *
+ * Description: Reads a tick count given on the command line. Plain digits are read exactly, anything else
+ * (1e11, 2.5e9) is read as a double and has to be a whole number that fits a Tick.
+ *
+ * Returns: The count, 0 if text is not one.
+ *
+ ************************************************************************************************************/
+Tick parseTicks (const char * text) {
+	char * end;
+	long long whole;
+	double value;
+
+	if (text == NULL)
+		return 0;
+	whole = strtoll(text, &end, 10);
+	if (*end == '\0')
+		return whole;
+	value = strtod(text, &end);
+	if (*end != '\0' || value != floor(value) || value < 0 || value >= 9.2e18)
+		return 0;
+	return (Tick) value;
+}
+/************************************************************************************************************
+ * kahanInit / kahanAdd
+ *
+ * Synopsis: void kahanAdd (KahanSum * k, double x)
+ *
+ * Description: Adds x to the running sum and keeps the rounding error of the addition in c: whichever of
+ * sum and x is smaller in magnitude is the one that lost bits.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void kahanInit (KahanSum * k) {
+	k->sum = 0.0;
+	k->c = 0.0;
+	k->n = 0;
+}
+
+void kahanAdd (KahanSum * k, double x) {
+	double t = k->sum + x;
+
+	if (fabs(k->sum) >= fabs(x))
+		k->c += (k->sum - t) + x;
+	else
+		k->c += (x - t) + k->sum;
+	k->sum = t;
+	k->n++;
+}
+/************************************************************************************************************
+ * kahanValue / kahanMean
+ *
+ * Synopsis: double kahanValue (const KahanSum * k)
+ *
+ * Description: Result functions of a compensated sum.
+ *
+ * Returns: The sum (the mean of the terms, 0 if there were none).
+ *
+ ************************************************************************************************************/
+double kahanValue (const KahanSum * k) {
+	return k->sum + k->c;
+}
+
+double kahanMean (const KahanSum * k) {
+	return (k->n > 0) ? kahanValue(k) / (double) k->n : 0.0;
+}
+/************************************************************************************************************
+ * sampleVariance
+ *
+ * Synopsis: double sampleVariance (const double * x, int n, double * mean)
+ *
+ * Description: Two passes over x, the mean first and then the squared deviations from it, so no large
+ * sums of squares cancel.
+ *
+ * Returns: The sample variance (over n - 1), 0 if n < 2.
+ *
+ ************************************************************************************************************/
+double sampleVariance (const double * x, int n, double * mean) {
+	double sum = 0.0;
+	double squares = 0.0;
+	int i;
+
+	for (i = 0; i < n; i++)
+		sum += x[i];
+	*mean = (n > 0) ? sum / n : 0.0;
+	for (i = 0; i < n; i++)
+		squares += (x[i] - *mean) * (x[i] - *mean);
+	return (n > 1) ? squares / (n - 1) : 0.0;
+}
+/************************************************************************************************************
+ * histInit / histAdd / histPercentile
+ *
+ * Synopsis: void histAdd (TickHistogram * h, Tick x)
+ *
+ * Description: Values below 2^HIST_SUB_BITS have a bucket each. Above, every power of 2 is cut into
+ * 2^HIST_SUB_BITS buckets by the bits after the leading one, so a bucket is never wider than a 32nd of
+ * the values in it and a percentile read from the middle of one is within 1.6% of the exact one, in a
+ * fixed size whatever the # of values or their range.
+ *
+ * Returns: Nothing (void); histPercentile returns the p quantile, 0 if no value was counted.
+ *
+ ************************************************************************************************************/
+void histInit (TickHistogram * h) {
+	memset(h, 0, sizeof(TickHistogram));
+}
+
+void histAdd (TickHistogram * h, Tick x) {
+	int e, b;
+
+	if (x < 0)
+		x = 0;
+	if (x < (1 << HIST_SUB_BITS))
+		b = (int) x;
+	else {
+		e = 63 - __builtin_clzll((unsigned long long) x);
+		b = ((e - HIST_SUB_BITS + 1) << HIST_SUB_BITS) +
+			(int) ((x >> (e - HIST_SUB_BITS)) & ((1 << HIST_SUB_BITS) - 1));
+	}
+	h->count[b]++;
+	h->n++;
+}
+
+double histPercentile (const TickHistogram * h, double p) {
+	Tick rank = (Tick) ceil(p * (double) h->n);
+	Tick seen = 0;
+	double low, width;
+	int b, e;
+
+	if (h->n == 0)
+		return 0.0;
+	if (rank < 1)
+		rank = 1;
+	for (b = 0; b < HIST_BUCKETS - 1 && seen + h->count[b] < rank; b++)
+		seen += h->count[b];
+	if (b < (1 << HIST_SUB_BITS))
+		return (double) b;
+	e = (b >> HIST_SUB_BITS) + HIST_SUB_BITS - 1;
+	width = ldexp(1.0, e - HIST_SUB_BITS);
+	low = ((1 << HIST_SUB_BITS) + (b & ((1 << HIST_SUB_BITS) - 1))) * width;
+	return low + (width - 1) / 2.0;
+}
+/************************************************************************************************************
+ * tQuantile
+ *
+ * Synopsis: double tQuantile (int df)
+ *
+ * Description: The 97.5% quantile of the Student t distribution with df degrees of freedom. Up to 30
+ * degrees it comes from a table, above that from the Cornish-Fisher expansion around the normal
+ * quantile, which is good to 4 digits there.
+ *
+ * Returns: The quantile, that of 1 degree of freedom if df is less.
+ *
+ ************************************************************************************************************/
+double tQuantile (int df) {
+	static const double table[30] = {
+		12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+		2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+		2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+	const double z = 1.959963985;
+	double z3 = z * z * z;
+	double z5 = z3 * z * z;
+
+	if (df < 1)
+		df = 1;
+	if (df <= 30)
+		return table[df - 1];
+	return z + (z3 + z) / (4.0 * df) + (5.0 * z5 + 16.0 * z3 + 3.0 * z) / (96.0 * df * df);
+}
@@ -0,0 +1,82 @@
+/*
+	sim_stats.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Header file for the counters and accumulators of the simulator.
+
+	Simulated time is counted in Ticks, 64 bit integers, so a run of 10^11 ticks or more neither wraps
+	the clock nor the counters derived from it. Integer totals are added with addSaturated(), which sticks
+	at TICK_MAX instead of wrapping. Floating point metrics are added up with KahanSum, a compensated sum
+	(Neumaier's variant) whose error does not grow with the number of terms, so a mean over 10^11 samples
+	is as good as one over a thousand.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _SIM_STATS_H_
+#define _SIM_STATS_H_
+
+#include <limits.h>
+
+#define TICK_MAX LLONG_MAX
+#define HIST_SUB_BITS 5			// a histogram bucket is at most 1 / 2^HIST_SUB_BITS of its values wide
+#define HIST_BUCKETS ((64 - HIST_SUB_BITS) << HIST_SUB_BITS)
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef long long Tick;		// simulated time and the counters derived from it
+
+typedef struct kahan_sum {
+	double sum;
+	double c;				// low order bits lost from sum so far
+	Tick n;					// # of terms
+} KahanSum;
+
+typedef struct tick_histogram {	// counts of tick values in log-linear buckets, see histAdd()
+	Tick n;					// # of values
+	Tick count[HIST_BUCKETS];
+} TickHistogram;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+Tick addSaturated (Tick a, Tick b);
+// returns a + b, TICK_MAX (-TICK_MAX - 1) if it would overflow
+
+Tick parseTicks (const char * text);
+// returns the tick count written in text (digits, or a number in
+// e notation such as 1e11), 0 if it is not a count
+
+void kahanInit (KahanSum * k);
+
+void kahanAdd (KahanSum * k, double x);
+
+double kahanValue (const KahanSum * k);
+// returns the compensated sum
+
+double kahanMean (const KahanSum * k);
+// returns the compensated sum over the # of terms, 0 if none
+
+double sampleVariance (const double * x, int n, double * mean);
+// sets mean to the mean of x[0 .. n-1] and returns their sample
+// variance, 0 if n < 2
+
+void histInit (TickHistogram * h);
+
+void histAdd (TickHistogram * h, Tick x);
+// counts x (0 or more) in its bucket
+
+double histPercentile (const TickHistogram * h, double p);
+// returns the p quantile (0 < p <= 1) of the values counted, the
+// middle of the bucket of rank ceil(p * n), 0 if none
+
+double tQuantile (int df);
+// returns the 97.5% quantile of the Student t distribution with df
+// degrees of freedom, the factor of a 95% confidence interval
+
+#endif
@@ -21,6 +21,13 @@
 
 #include "simulator.h"
 #include "queue.h"
+#include "arrivals.h"
+#include "spill_queue.h"
+#include "process_table.h"
+#include "checkpoint.h"
+#include "batch_means.h"
+#include "result_cache.h"
+#include "fork_pool.h"
 
 /*********************************************************************************************************
  *                                        Global Variables
@@ -34,19 +41,121 @@ int max_proc;
 int avg_proc;
 // Maximum time ticks to run the simulation (a default minimum might be 50,000 cycles
 // and allow the user to specify at top end number).
-int max_ticks;
+Tick max_ticks;
 // Mean time between starts (this is the mean of an exponential random distribution
-// - the actual starts will be determined at runtime).
+// - the actual starts will be determined at runtime). Also the mean CPU time a process
+// needs before it terminates.
 int mean_times;
 // Specific time slice value (a number between 200 microseconds and 1 milisecond that
 // designates how much running time each process is allotted per time slice).
 int time_slice;
-int counter;
-int total_run_count;
-int id;
+Tick counter;
+Tick total_run_count;
+Tick id;
 Queue_p ready_queue;
-Process_p curr_proc;
-Process_p idle_proc;
+// Every process lives in the process table; queues and the variables below hold handles into it.
+ProcessTable_p procs;
+ProcHandle curr_proc;
+ProcHandle idle_proc;
+// Run options given after the five required arguments.
+// --pipelined generates the arrivals on a producer thread, --seed=N seeds the random number generator.
+// --spill[=DIR] keeps the ready queue in a spilling queue (scratch file in DIR, /tmp by default), so a
+// backlog that outgrows memory goes to disk; it is not limited, so it takes no --admit policy.
+// --admit=reject|drop|block chooses what happens to an arrival when max_proc processes are ready:
+// it is turned away, the process waiting longest is dropped, or the arrival source stops until a
+// process leaves.
+// --checkpoint=PATH saves the state of the run to PATH (and PATH.journal) every --checkpoint-every=N
+// ticks and at the end, --resume continues the run saved there (max_ticks may be raised).
+// --precision=R stops the run as soon as the 95% confidence intervals of the mean # of processes in
+// the system and of the utilization are within R of their values (relative), max_ticks at the latest.
+// --replications=N makes N runs on their own substreams and reports the mean of each metric over
+// them. --antithetic pairs every run with one on antithetic substreams, --compare=T repeats every run
+// with a time slice of T on the same substreams (common random numbers) and reports the differences.
+// Both report the variance reduction they achieved.
+// --cache=PATH looks the arguments up in the result cache at PATH first and prints the stored result if
+// this build ran them before; otherwise it runs and stores what it prints.
+// --optimize=LO:HI searches LO .. HI for the time slice with the lowest --objective=p99|wait|lost among
+// those that keep the utilization at --floor=U or above: the 99th percentile of the response times of
+// the processes that terminated, the mean wait of those still in the system at the end, or the arrivals
+// turned away. It runs --jobs=N evaluations at a time (one per processor by default), on up to
+// --replications of them per time slice (OPT_REPLICATIONS unless given), and keeps every evaluation it
+// made for the rest of the search and, with --cache, for later.
+// --switch-cost=D makes every dispatch of another process cost D ticks of overhead, --refill=C adds up
+// to C ticks for refilling the cache the process left, which stays warm for a while after it stops:
+// the refill costs C * (1 - exp(-t / TAU)) ticks t ticks later, --warmth=TAU (0, the default, means
+// the cache is always cold). The overhead comes out of the time slice of the process dispatched, which
+// starts when it is dispatched.
+// --burst=B makes every process alternate CPU bursts (B ticks long on average) with I/O on one of the
+// devices of --io=S[,S...], picked at random. Each device serves its queue first come first served,
+// taking S ticks per request on average, and the process goes back to the ready queue when it is done.
+// Bursts and service times are exponential, drawn from the service substream.
+int pipelined;
+long seed = 1;
+int spill;
+char * spill_dir;
+SpillQueue_p spill_queue;
+int admit_policy = QUEUE_REJECT;
+// Arrival held back by a full ready queue under --admit=block (the source makes no new ones meanwhile).
+ProcHandle held_proc;
+// Ticks during which the ready queue was full, and during which the arrival source was blocked.
+Tick full_ticks;
+Tick blocked_ticks;
+// Run ticks of the processes --admit=drop dropped: CPU time spent on work that was thrown away.
+Tick dropped_ticks;
+char * checkpoint_path;
+Tick checkpoint_every = CHECKPOINT_EVERY;
+int resume;
+Checkpoint_p checkpoint;
+double precision;
+// Batch means of the # of processes in the system and of the utilization, one observation per tick.
+BatchMeans_p in_system;
+BatchMeans_p busy;
+int replications = 1;
+int antithetic;
+int compare_slice;
+// Set while replicate() runs, so the runs do not print their own reports.
+int quiet;
+// Metrics of the last run, set when it ends.
+RunMetrics last_run;
+// Response times (arrival to termination) of the processes that terminated in this run.
+KahanSum responses;
+TickHistogram response_times;
+static const char * metricNames[RUN_METRICS] = { "utilization", "mean wait", "lost", "p99 response",
+	"overhead" };
+int opt_lo;
+int opt_hi;
+int objective = METRIC_P99;
+double utilization_floor;
+int jobs;
+// Every (time slice, replication) the optimizer evaluated so far.
+Evaluation * evaluations;
+int nevaluations;
+char * cache_path;
+ResultCache_p cache;
+// Where the results of a run are printed: stdout, or a buffer that goes to the cache as well.
+FILE * results;
+// Set when a run fell back on something other than what was asked for, so its results are not cached.
+int degraded;
+// Substreams of the random number generator for the current run (see rand_stream.h).
+RandStream streams[RAND_STREAMS];
+int switch_cost;
+int refill;
+double warmth;
+// Overhead ticks left of the dispatch under way, spent on overhead so far, and dispatches that cost.
+Tick overhead_left;
+Tick overhead_ticks;
+Tick switches;
+// Tick the time slice of the running process ends at.
+Tick slice_end;
+double burst;
+double io_service[IO_DEVICES];
+int ndevices;
+IODevice devices[IO_DEVICES];
+// TRUE while the run models I/O (--burst, with the device queues set up).
+int io;
+// Processes blocked on I/O now, and that # added up over the ticks.
+int nblocked;
+Tick io_blocked_ticks;
 
 /*********************************************************************************************************
  *                                           Functions
@@ -57,75 +166,1261 @@ Process_p idle_proc;
 	Output: 
 */
 int main (int argc, char *argv[]) {
+	int i;
+	int admit = FALSE;			// an --admit policy was asked for
 
-	if ( argc != 6 ) { /* argc should be 2 for correct execution */
+	results = stdout;
+	if ( argc < 6 ) { /* argc should be at least 6 for correct execution */
         /* We print argv[0] assuming it is the program name */
-        printf( "usage: %s max_proc, avg_proc, max_ticks, mean_times, time_slice\n", argv[0] );
+        printf( "usage: %s max_proc, avg_proc, max_ticks, mean_times, time_slice [--pipelined] [--seed=N] [--spill[=DIR]] [--admit=reject|drop|block] [--checkpoint=PATH [--checkpoint-every=N] [--resume]] [--precision=R] [--replications=N] [--antithetic] [--compare=T] [--cache=PATH] [--optimize=LO:HI [--objective=p99|wait|lost] [--floor=U] [--jobs=N]] [--switch-cost=D] [--refill=C [--warmth=TAU]] [--burst=B --io=S[,S...]]\n", argv[0] );
     }
     else {
     	max_proc = atoi(argv[1]);
     	avg_proc = atoi(argv[2]);
-    	max_ticks = atoi(argv[3]);
+    	max_ticks = parseTicks(argv[3]);
     	mean_times = atoi(argv[4]); 
     	time_slice = atoi(argv[5]);
 
+    	for (i = 6; i < argc; i++) {
+    		if (!strcmp(argv[i], "--pipelined"))
+    			pipelined = TRUE;
+    		else if (!strncmp(argv[i], "--seed=", 7))
+    			seed = atol(argv[i] + 7);
+    		else if (!strcmp(argv[i], "--spill"))
+    			spill = TRUE;
+    		else if (!strncmp(argv[i], "--spill=", 8)) {
+    			spill = TRUE;
+    			spill_dir = argv[i] + 8;
+    		}
+    		else if (!strcmp(argv[i], "--admit=reject")) {
+    			admit_policy = QUEUE_REJECT;
+    			admit = TRUE;
+    		}
+    		else if (!strcmp(argv[i], "--admit=drop")) {
+    			admit_policy = QUEUE_DROP_OLDEST;
+    			admit = TRUE;
+    		}
+    		else if (!strcmp(argv[i], "--admit=block")) {
+    			admit_policy = QUEUE_BLOCK;
+    			admit = TRUE;
+    		}
+    		else if (!strncmp(argv[i], "--checkpoint=", 13))
+    			checkpoint_path = argv[i] + 13;
+    		else if (!strncmp(argv[i], "--checkpoint-every=", 19))
+    			checkpoint_every = parseTicks(argv[i] + 19);
+    		else if (!strcmp(argv[i], "--resume"))
+    			resume = TRUE;
+    		else if (!strncmp(argv[i], "--precision=", 12)) {
+    			precision = atof(argv[i] + 12);
+    			if (precision <= 0) {
+    				printf("--precision needs a positive relative half width, such as 0.01\n");
+    				return 1;
+    			}
+    		}
+    		else if (!strncmp(argv[i], "--replications=", 15))
+    			replications = atoi(argv[i] + 15);
+    		else if (!strcmp(argv[i], "--antithetic"))
+    			antithetic = TRUE;
+    		else if (!strncmp(argv[i], "--compare=", 10))
+    			compare_slice = atoi(argv[i] + 10);
+    		else if (!strncmp(argv[i], "--cache=", 8))
+    			cache_path = argv[i] + 8;
+    		else if (!strncmp(argv[i], "--optimize=", 11)) {
+    			if (sscanf(argv[i] + 11, "%d:%d", &opt_lo, &opt_hi) != 2 || opt_lo < 1 || opt_hi < opt_lo) {
+    				printf("--optimize needs a range of time slices, such as 1:1000\n");
+    				return 1;
+    			}
+    		}
+    		else if (!strcmp(argv[i], "--objective=p99"))
+    			objective = METRIC_P99;
+    		else if (!strcmp(argv[i], "--objective=wait"))
+    			objective = METRIC_WAIT;
+    		else if (!strcmp(argv[i], "--objective=lost"))
+    			objective = METRIC_LOST;
+    		else if (!strncmp(argv[i], "--floor=", 8))
+    			utilization_floor = atof(argv[i] + 8);
+    		else if (!strncmp(argv[i], "--jobs=", 7))
+    			jobs = atoi(argv[i] + 7);
+    		else if (!strncmp(argv[i], "--switch-cost=", 14))
+    			switch_cost = atoi(argv[i] + 14);
+    		else if (!strncmp(argv[i], "--refill=", 9))
+    			refill = atoi(argv[i] + 9);
+    		else if (!strncmp(argv[i], "--warmth=", 9))
+    			warmth = atof(argv[i] + 9);
+    		else if (!strncmp(argv[i], "--burst=", 8))
+    			burst = atof(argv[i] + 8);
+    		else if (!strncmp(argv[i], "--io=", 5)) {
+    			char * next = argv[i] + 4;		// every service time follows the '=' or a ','
+    			ndevices = 0;
+    			while (*next != '\0' && ndevices < IO_DEVICES &&
+    					(io_service[ndevices] = strtod(next + 1, &next)) > 0 && (*next == ',' || *next == '\0'))
+    				ndevices++;
+    			if (ndevices == 0 || *next != '\0') {
+    				printf("--io needs up to %d mean service times, such as 20,50\n", IO_DEVICES);
+    				return 1;
+    			}
+    		}
+    		else {
+    			printf("unknown option: %s\n", argv[i]);
+    			return 1;
+    		}
+    	}
+
+    	if ((resume && checkpoint_path == NULL) || checkpoint_every <= 0) {
+    		printf("--resume needs --checkpoint=PATH, --checkpoint-every needs a positive count\n");
+    		return 1;
+    	}
+    	if (spill && admit) {
+    		// the spilling queue takes every arrival, there is no limit for a policy to apply at
+    		printf("--spill cannot be combined with --admit\n");
+    		return 1;
+    	}
+    	if (checkpoint_path != NULL && (pipelined || spill)) {
+    		// the producer thread draws ahead of the loop and the spilled queue lives in its own file
+    		printf("--checkpoint cannot be combined with --pipelined or --spill\n");
+    		return 1;
+    	}
+    	if (replications < 1 || compare_slice < 0) {
+    		printf("--replications needs a positive count, --compare a time slice\n");
+    		return 1;
+    	}
+    	if (checkpoint_path != NULL && (replications > 1 || antithetic || compare_slice > 0)) {
+    		printf("--checkpoint saves a single run, it cannot be combined with --replications, --antithetic or --compare\n");
+    		return 1;
+    	}
+    	if (opt_hi > 0 && (checkpoint_path != NULL || antithetic || compare_slice > 0)) {
+    		printf("--optimize cannot be combined with --checkpoint, --antithetic or --compare\n");
+    		return 1;
+    	}
+    	if (switch_cost < 0 || refill < 0 || warmth < 0) {
+    		printf("--switch-cost, --refill and --warmth need counts of ticks, 0 or more\n");
+    		return 1;
+    	}
+    	if ((burst > 0) != (ndevices > 0) || burst < 0) {
+    		printf("--burst needs a positive mean and goes with --io\n");
+    		return 1;
+    	}
+    	if (opt_hi > 0 && replications == 1)
+    		replications = OPT_REPLICATIONS;
+    	if (jobs < 1)
+    		jobs = defaultJobs();
+    	if (checkpoint_path != NULL && cache_path != NULL) {
+    		printf("--checkpoint cannot be combined with --cache\n");
+    		return 1;
+    	}
+    	if (max_ticks > streamSpacing(replications)) {
+    		// each tick draws once from the arrival and the termination substreams
+    		printf("max_ticks cannot be more than %lld, the draws of a random number substream\n",
+    			streamSpacing(replications));
+    		return 1;
+    	}
+
     	//printf("%d | %d | %d | %d | %d\n", max_proc, avg_proc, max_ticks, mean_times, time_slice);
+    	if (cache_path != NULL) {
+    		cache = openResultCache(cache_path);
+    		if (cache == NULL)
+    			printf("could not open the result cache %s, running without\n", cache_path);
+    	}
+    	if (opt_hi > 0)
+    		optimize();
+    	else if (cache != NULL)
+    		runCached();
+    	else
+    		run();
+    	closeResultCache(cache);
     }
 	return 0;
 }
 
+/*	Function: run
+	Input: none
+	Output: none. Makes the run (the replications) the arguments ask for and prints the results
+*/
+void run() {
+	if (replications > 1 || antithetic || compare_slice > 0)
+		replicate();
+	else {
+		seedStreams(streams, seed, 0, 1, FALSE);
+		start_loop();
+	}
+}
+
+/*	Function: runCached
+	Input: none
+	Output: none. Prints the results stored in the cache under the arguments and this build, or runs,
+	prints the results and stores them
+*/
+void runCached() {
+	RunKey key;
+	char * text = NULL;
+	size_t length = 0;
+	FILE * memory;
+
+	makeRunKey(&key);
+	switch (lookupResult(cache, &key, sizeof(key), &text, &length)) {
+		case CACHE_HIT:
+			fwrite(text, 1, length, stdout);
+			free(text);
+			return;
+		case CACHE_ERROR:
+			printf("could not read the result cache %s\n", cache_path);
+			break;
+	}
+	memory = open_memstream(&text, &length);
+	if (memory == NULL) {
+		run();
+		return;
+	}
+	results = memory;
+	run();
+	fclose(memory);
+	results = stdout;
+	fwrite(text, 1, length, stdout);
+	if (!degraded && storeResult(cache, &key, sizeof(key), text, length) != CACHE_OK)
+		printf("could not write the result cache %s\n", cache_path);
+	free(text);
+}
+
+/*	Function: makeRunKey
+	Input: the key to fill in
+	Output: none. The key holds every argument that changes what a run prints, in a fixed layout with
+	no stray bytes, and the build, so the same request always gives the same key
+*/
+void makeRunKey(RunKey * key) {
+	memset(key, 0, sizeof(RunKey));
+	strncpy(key->build, SIM_BUILD, sizeof(key->build) - 1);
+	key->max_proc = max_proc;
+	key->avg_proc = avg_proc;
+	key->mean_times = mean_times;
+	key->time_slice = time_slice;
+	key->spill = spill;
+	key->admit_policy = admit_policy;
+	key->replications = replications;
+	key->antithetic = antithetic;
+	key->compare_slice = compare_slice;
+	key->max_ticks = max_ticks;
+	key->seed = seed;
+	key->precision = precision;
+	key->switch_cost = switch_cost;
+	key->refill = refill;
+	key->warmth = warmth;
+	key->burst = burst;
+	key->devices = ndevices;
+	memcpy(key->io_service, io_service, sizeof(io_service));
+}
+
 void start_loop () {
-	int randnum = 0;
+	ArrivalGen_p arrival_gen = NULL;
+	SimConfig config;
+	int i;
 	counter = 0;
 	total_run_count = 0;
 	id = 0;
+	full_ticks = 0;
+	blocked_ticks = 0;
+	dropped_ticks = 0;
+	overhead_left = 0;
+	overhead_ticks = 0;
+	switches = 0;
+	slice_end = time_slice;
+	nblocked = 0;
+	io_blocked_ticks = 0;
+	kahanInit(&responses);
+	histInit(&response_times);
+	held_proc = NO_PROCESS;
+	procs = createProcessTable(max_proc + 1);
 	ready_queue = createQueue("Ready Queue", max_proc);
-	idle_proc = createProcess();
-	curr_proc = idle_proc;
-	for (;;) {
-		counter++;
-		curr_proc->run_count++;
+	setQueuePolicy(ready_queue, admit_policy, dropProcess);
+	if (spill) {
+		spill_queue = createSpillQueue("Ready Queue", sizeof(ProcHandle), SPILL_BATCH, spill_dir);
+		if (spill_queue == NULL) {
+			printf("could not create the spilling queue, keeping the ready queue in memory\n");
+			degraded = TRUE;
+		}
+	}
+	io = ndevices > 0;
+	for (i = 0; i < ndevices; i++) {
+		memset(&devices[i], 0, sizeof(IODevice));
+		devices[i].serving = NO_PROCESS;
+		devices[i].queue = createList("Device Queue");
+		if (devices[i].queue == NULL && io) {
+			printf("could not create the device queues, running without I/O\n");
+			degraded = TRUE;
+			io = FALSE;
+		}
+	}
+	if (precision > 0) {
+		in_system = createBatchMeans(BATCH_MEANS_LIMIT, BATCH_TICKS);
+		busy = createBatchMeans(BATCH_MEANS_LIMIT, BATCH_TICKS);
+		if (in_system == NULL || busy == NULL) {
+			printf("could not set up the batch means, running to max_ticks\n");
+			degraded = TRUE;
+			destroyBatchMeans(in_system);
+			destroyBatchMeans(busy);
+			in_system = busy = NULL;
+		}
+	}
+	if (checkpoint_path != NULL) {
+		memset(&config, 0, sizeof(config));
+		config.max_proc = max_proc;
+		config.avg_proc = avg_proc;
+		config.mean_times = mean_times;
+		config.time_slice = time_slice;
+		config.admit_policy = admit_policy;
+		config.switch_cost = switch_cost;
+		config.refill = refill;
+		config.devices = io ? ndevices : 0;
+		config.seed = seed;
+		config.warmth = warmth;
+		config.burst = burst;
+		for (i = 0; i < ndevices; i++)
+			config.io_service[i] = io_service[i];
+		config.precision = (in_system != NULL) ? precision : 0;
+		checkpoint = openCheckpoint(checkpoint_path, &config);
+		if (checkpoint == NULL || (resume && !resumeRun())) {
+			closeCheckpoint(checkpoint);
+			checkpoint = NULL;
+			destroyBatchMeans(in_system);
+			destroyBatchMeans(busy);
+			in_system = busy = NULL;
+			destroyQueue(ready_queue);
+			destroyProcessTable(procs);
+			procs = NULL;
+			return;
+		}
+	}
+	if (!resume) {
+		idle_proc = createProcess();
+		curr_proc = idle_proc;
+	}
+	if (pipelined) {
+		arrival_gen = startArrivalProducer(max_ticks, avg_proc, mean_times, streams);
+		if (arrival_gen == NULL) {
+			printf("could not start the arrival producer, running single-threaded\n");
+			pipelined = FALSE;
+		}
+	}
+	while (counter < max_ticks) {
+		int burst_done = FALSE;
 
-		if (counter % time_slice == 0) {
-			scheduler(0);
+		counter++;
+		if (overhead_left > 0) {
+			overhead_left--;
+			overhead_ticks++;
+		}
+		else {
+			procs->run_count[curr_proc]++;
+			burst_done = procs->burst_left[curr_proc] > 0 && --procs->burst_left[curr_proc] == 0;
 		}
 
-		if (expon(avg_proc) > mean_times) {
-			Process_p new_proc = createProcess();
-			enqueue(ready_queue, new_proc);
+		if (burst_done)
+			scheduler(SCHED_BLOCK);
+		else if (counter == slice_end) {
+			scheduler(SCHED_PREEMPT);
 		}
+		if (io)
+			serviceDevices();
+
+		if (pipelined) {
+			Arrival_p next = nextArrival(arrival_gen->ring);
+			if (next->tick == counter) {
+				int flags = next->flags;
+				popArrival(arrival_gen->ring);
+				if (flags & ARRIVAL_NEW) {
+					arrive();
+				}
+				if (flags & ARRIVAL_TERMINATE) {
+					scheduler(SCHED_TERMINATE);
+				}
+			}
+		} else {
+			if (expon(&streams[STREAM_ARRIVALS], avg_proc) > mean_times) {
+				arrive();
+			}
 
-		if (expon(avg_proc) == mean_times) {
-			scheduler(1);
+			// an exponential demand of mean mean_times ends within the next tick with probability
+			// 1 - exp(-1 / mean_times), whatever the process ran so far
+			if (expon(&streams[STREAM_TERMINATIONS], mean_times) < 1.0) {
+				scheduler(SCHED_TERMINATE);
+			}
 		}
+		// the idle process gives the CPU up as soon as a process is ready
+		if (curr_proc == idle_proc && readyProcesses() > 0)
+			scheduler(SCHED_PREEMPT);
 
-		if (counter == max_ticks){
-			printf("%d\n", total_run_count);
+		if (held_proc != NO_PROCESS)
+			blocked_ticks++;
+		io_blocked_ticks += nblocked;
+		if (isFull(ready_queue))
+			full_ticks++;
+		if (in_system != NULL && sampleRun())
 			break;
+
+		if (checkpoint != NULL && (counter % checkpoint_every == 0 || counter == max_ticks))
+			saveRun();
+	}
+	measureRun(&last_run);
+	if (!quiet) {
+		fprintf(results, "%lld\n", total_run_count);
+		report();
+		if (in_system != NULL)
+			reportPrecision();
+	}
+	destroyBatchMeans(in_system);
+	destroyBatchMeans(busy);
+	in_system = busy = NULL;
+	closeCheckpoint(checkpoint);
+	checkpoint = NULL;
+	if (pipelined)
+		stopArrivalProducer(arrival_gen);
+	destroySpillQueue(spill_queue);
+	spill_queue = NULL;
+	for (i = 0; i < ndevices; i++) {
+		destroyList(devices[i].queue);
+		devices[i].queue = NULL;
+	}
+	destroyQueue(ready_queue);
+	ready_queue = NULL;
+	destroyProcessTable(procs);
+	procs = NULL;
+}
+
+/*	Function: scheduler
+	Input: why the running process leaves the CPU: SCHED_PREEMPT (its time slice is over), SCHED_TERMINATE
+	or SCHED_BLOCK (its CPU burst is over and it starts I/O)
+	Output: none. The running process goes back to the end of the ready queue, leaves the system or
+	blocks, and the process at the head is dispatched for a whole time slice. The idle process is never
+	queued: it runs only when the ready queue is empty
+*/
+void scheduler(int reason) {
+	ProcHandle prev_proc = curr_proc;
+
+	markProcessDirty(procs, curr_proc);	// its run count changed since it was dispatched
+	if (reason == SCHED_TERMINATE && curr_proc != idle_proc) {	// the idle process never terminates
+		total_run_count = addSaturated(total_run_count, procs->run_count[curr_proc]);
+		kahanAdd(&responses, (double) (counter - procs->arrival[curr_proc]));
+		histAdd(&response_times, counter - procs->arrival[curr_proc]);
+		freeProcess(procs, curr_proc);
+		prev_proc = NO_PROCESS;
+	}
+	else {
+		procs->last_ran[curr_proc] = counter;
+		if (reason == SCHED_BLOCK)
+			blockOnIO(curr_proc);
+		else if (reason == SCHED_PREEMPT && curr_proc != idle_proc)
+			enqueueReady(curr_proc);
+	}
+	curr_proc = dequeueReady();
+	if (curr_proc == NO_PROCESS)
+		curr_proc = idle_proc;
+	slice_end = counter + time_slice;
+	if (curr_proc != prev_proc && (switch_cost > 0 || refill > 0)) {
+		overhead_left = dispatchCost(curr_proc);
+		switches++;
+	}
+
+	if (held_proc != NO_PROCESS && !isFull(ready_queue) &&
+			enqueuePayload(ready_queue, PROC_PAYLOAD(held_proc)) != QUEUE_FULL_ERROR)
+		held_proc = NO_PROCESS;
+}
+
+/*	Function: readyProcesses
+	Input: none
+	Output: the # of processes in the ready queue
+*/
+long long readyProcesses() {
+	// isEmpty() returns the # of items
+	return (spill_queue != NULL) ? sizeSpill(spill_queue) : isEmpty(ready_queue);
+}
+
+/*	Function: dispatchCost
+	Input: the process dispatched
+	Output: the ticks of overhead before the process dispatched does useful work: --switch-cost, and
+	the cache refill, which shrinks the more recently the process last ran. The idle process needs no
+	cache, and one that never ran finds it cold
+*/
+Tick dispatchCost(ProcHandle to) {
+	double cold = 1.0;
+
+	if (to == idle_proc)
+		return switch_cost;
+	if (procs->last_ran[to] > 0 && warmth > 0)
+		cold = 1.0 - exp(-(double) (counter - procs->last_ran[to]) / warmth);
+	return switch_cost + (Tick) (refill * cold + 0.5);
+}
+
+/*	Function: arrive
+	Input: none
+	Output: none. A new process asks to join the ready queue, which applies the --admit policy; a
+	refused process leaves the table, or is held back under --admit=block. While one is held the
+	source is blocked and arrivals do not happen
+*/
+void arrive() {
+	ProcHandle new_proc;
+
+	if (held_proc != NO_PROCESS)
+		return;
+	new_proc = createProcess();
+	if (new_proc == NO_PROCESS)
+		return;
+	if (io) {
+		procs->rand_state[new_proc] = splitStream(&streams[STREAM_SERVICE]);
+		procs->burst_left[new_proc] = drawTicks(new_proc, burst);
+	}
+	if (spill_queue != NULL) {
+		enqueueReady(new_proc);
+		return;
+	}
+	if (enqueuePayload(ready_queue, PROC_PAYLOAD(new_proc)) == QUEUE_FULL_ERROR) {
+		if (admit_policy == QUEUE_BLOCK)
+			held_proc = new_proc;
+		else
+			freeProcess(procs, new_proc);
+	}
+}
+
+/*	Function: blockOnIO
+	Input: a process whose CPU burst is over
+	Output: none. The process blocks and joins the queue of a device it picks at random, which starts on
+	it at once if it was idle
+*/
+void blockOnIO(ProcHandle proc) {
+	RandStream stream = { procs->rand_state[proc], streams[STREAM_SERVICE].antithetic };
+	IODevice * dev = &devices[(int) (rand_val(&stream) * ndevices)];
+
+	procs->rand_state[proc] = stream.state;
+	markProcessDirty(procs, proc);
+
+	if (appendPayload(dev->queue, PROC_PAYLOAD(proc), NULL) != NO_ERROR) {
+		printf("could not queue process %lld for I/O, it skips it\n", procs->id[proc]);
+		degraded = TRUE;
+		procs->burst_left[proc] = drawTicks(proc, burst);
+		enqueueReady(proc);
+		return;
+	}
+	procs->blocked_at[proc] = counter;
+	nblocked++;
+	limitReady();
+	if (dev->serving == NO_PROCESS)
+		startService(dev);
+}
+
+/*	Function: serviceDevices
+	Input: none
+	Output: none. Once a tick: every device that finishes a request wakes its process into the ready
+	queue, with a new CPU burst, and starts on the next one in its queue. Then every busy device counts
+	the tick
+*/
+void serviceDevices() {
+	IODevice * dev;
+	ProcHandle proc;
+
+	for (dev = devices; dev < devices + ndevices; dev++) {
+		if (dev->serving != NO_PROCESS && dev->done_at == counter) {
+			proc = dev->serving;
+			dev->completions++;
+			dev->response_ticks += counter - procs->blocked_at[proc];
+			procs->io_ticks[proc] += counter - procs->blocked_at[proc];
+			procs->blocked_at[proc] = 0;
+			procs->burst_left[proc] = drawTicks(proc, burst);
+			nblocked--;
+			limitReady();
+			enqueueReady(proc);
+			startService(dev);
+		}
+		if (dev->serving != NO_PROCESS)
+			dev->busy_ticks++;
+	}
+}
+
+/*	Function: limitReady
+	Input: none
+	Output: none. A process blocked on I/O keeps its place in the system, so the ready queue takes
+	max_proc processes less those blocked, and the --admit policy holds the whole population (ready,
+	blocked and running) to max_proc + 1 as it does without I/O
+*/
+void limitReady() {
+	ready_queue->limit = (nblocked < max_proc) ? max_proc - nblocked : 0;
+}
+
+/*	Function: startService
+	Input: an idle device
+	Output: none. The device takes the first process of its queue, if there is one, and draws how long
+	its request takes
+*/
+void startService(IODevice * dev) {
+	void * next = removeDataFromHead(dev->queue);
+
+	dev->serving = (next != NULL) ? PROC_HANDLE(next) : NO_PROCESS;
+	if (dev->serving != NO_PROCESS)
+		dev->done_at = counter + drawTicks(dev->serving, io_service[dev - devices]);
+}
+
+/*	Function: drawTicks
+	Input: a process, a mean
+	Output: an exponential # of ticks with that mean from the stream of the process, at least 1
+*/
+Tick drawTicks(ProcHandle proc, double mean) {
+	RandStream stream = { procs->rand_state[proc], streams[STREAM_SERVICE].antithetic };
+	Tick ticks = (Tick) (expon(&stream, mean) + 0.5);
+
+	procs->rand_state[proc] = stream.state;
+	markProcessDirty(procs, proc);
+	return (ticks > 0) ? ticks : 1;
+}
+
+/*	Function: dropProcess
+	Input: a process dropped from the full ready queue by --admit=drop
+	Output: none. The process leaves the table (the idle process is never queued, so it is not this one),
+	and what it ran is counted as lost
+*/
+void dropProcess(void * proc) {
+	dropped_ticks = addSaturated(dropped_ticks, procs->run_count[PROC_HANDLE(proc)]);
+	freeProcess(procs, PROC_HANDLE(proc));
+}
+
+/*	Function: report
+	Input: none
+	Output: prints how the ready queue coped with the arrivals (under --admit=drop, with what the dropped
+	processes had run), what the processes still in the system (the idle process aside) have run and
+	waited since they arrived, then the overhead and the I/O if they are modeled
+*/
+void report() {
+	QueueStats stats;
+	Tick run = sumRunCount(procs) - procs->run_count[idle_proc];
+	int i;
+
+	getQueueStats(ready_queue, &stats);
+	fprintf(results, "admitted %lld rejected %lld dropped %lld blocked %lld full ticks %lld blocked ticks %lld\n",
+		stats.admitted, stats.rejected, stats.dropped, stats.blocked, full_ticks, blocked_ticks);
+	fprintf(results, "live %d run ticks %lld mean wait %.3f utilization %.6f\n", liveProcesses(procs) - 1, run,
+		last_run.wait, last_run.utilization);
+	fprintf(results, "terminated %lld mean response %.3f p99 response %.1f\n", responses.n,
+		kahanMean(&responses), last_run.p99);
+	if (admit_policy == QUEUE_DROP_OLDEST)
+		fprintf(results, "dropped run ticks %lld (%.6f of the ticks lost with the processes dropped)\n",
+			dropped_ticks, (double) dropped_ticks / counter);
+	if (switch_cost > 0 || refill > 0)
+		fprintf(results, "useful ticks %lld overhead ticks %lld (%.6f, %lld switches) idle ticks %lld\n",
+			counter - overhead_ticks - procs->run_count[idle_proc], overhead_ticks, last_run.overhead, switches,
+			procs->run_count[idle_proc]);
+	if (io) {
+		fprintf(results, "blocked on I/O %d blocked ticks %lld (%.3f processes on average)\n", nblocked,
+			io_blocked_ticks, (double) io_blocked_ticks / counter);
+		for (i = 0; i < ndevices; i++)
+			fprintf(results, "device %d: mean service %g utilization %.6f completions %lld mean response %.3f queued %d\n",
+				i, io_service[i], (double) devices[i].busy_ticks / counter, devices[i].completions,
+				(devices[i].completions > 0) ? (double) devices[i].response_ticks / devices[i].completions : 0.0,
+				sizeList(devices[i].queue));
+	}
+}
+
+/*	Function: measureRun
+	Input: where to put the metrics of the run that just ended
+	Output: none. The utilization (the share of useful ticks, overhead is not), the share of overhead,
+	the mean wait of the processes still in the system (the idle
+	process aside), the # of arrivals lost to the --admit policy and the 99th percentile of the
+	response times of the processes that terminated
+*/
+void measureRun(RunMetrics * m) {
+	QueueStats stats;
+	KahanSum waits;
+	int live = liveProcesses(procs) - 1;
+
+	kahanInit(&waits);
+	addWaits(procs, counter, &waits);
+	// the idle process is not waiting for anything
+	kahanAdd(&waits, -(double) (counter - procs->arrival[idle_proc] - procs->run_count[idle_proc]));
+	getQueueStats(ready_queue, &stats);
+
+	m->utilization = 1.0 - (double) (procs->run_count[idle_proc] + overhead_ticks) / counter;
+	m->overhead = (double) overhead_ticks / counter;
+	m->wait = (live > 0) ? kahanValue(&waits) / live : 0.0;
+	m->lost = (double) (stats.rejected + stats.dropped);
+	m->p99 = histPercentile(&response_times, 0.99);
+}
+
+/*	Function: runMetric
+	Input: the metrics of a run and a metric, METRIC_UTILIZATION .. METRIC_OVERHEAD
+	Output: that metric of the run
+*/
+double runMetric(const RunMetrics * m, int metric) {
+	switch (metric) {
+		case METRIC_UTILIZATION:
+			return m->utilization;
+		case METRIC_WAIT:
+			return m->wait;
+		case METRIC_LOST:
+			return m->lost;
+		case METRIC_P99:
+			return m->p99;
+		default:
+			return m->overhead;
+	}
+}
+
+/*	Function: replicate
+	Input: none
+	Output: none. Makes --replications runs, each on the substreams of its replication: with
+	--antithetic once more on the antithetic substreams, with --compare once more with the other time
+	slice on the same substreams. Prints the mean of every metric with the half width of its 95%
+	confidence interval, and how much the paired runs cut the variance compared to independent ones
+*/
+void replicate() {
+	int slices = (compare_slice > 0) ? 2 : 1;
+	int slice[2] = { time_slice, compare_slice };
+	double * x = (double *) malloc (sizeof(double) * (size_t) RUN_INDEX(replications, 0, 0, 0));
+	double * y = (double *) malloc (sizeof(double) * (size_t) replications * 3);
+	double mean;
+	int r, s, a, k;
+
+	if (x == NULL || y == NULL) {
+		printf("out of memory for %d replications\n", replications);
+		degraded = TRUE;
+		free(x);
+		free(y);
+		return;
+	}
+	quiet = TRUE;
+	for (r = 0; r < replications; r++)
+		for (s = 0; s < slices; s++)
+			for (a = 0; a <= antithetic; a++) {
+				time_slice = slice[s];
+				seedStreams(streams, seed, r, replications, a);
+				start_loop();
+				for (k = 0; k < RUN_METRICS; k++)
+					x[RUN_INDEX(r, s, a, k)] = runMetric(&last_run, k);
+			}
+	quiet = FALSE;
+	time_slice = slice[0];
+
+	fprintf(results, "%d replications%s, seed %ld\n", replications, antithetic ? " of antithetic pairs" : "", seed);
+	for (s = 0; s < slices; s++) {
+		fprintf(results, "time slice %d:", slice[s]);
+		for (k = 0; k < RUN_METRICS; k++) {
+			pairMeans(x, s, k, y);
+			printInterval(metricNames[k], y);
+		}
+		fprintf(results, "\n");
+		if (antithetic) {
+			// the variance of a pair mean against that of the mean of two independent runs
+			fprintf(results, "  antithetic variance reduction:");
+			for (k = 0; k < RUN_METRICS; k++) {
+				pairMeans(x, s, k, y);
+				for (r = 0; r < replications; r++)
+					y[replications + r] = x[RUN_INDEX(r, s, 0, k)];
+				printReduction(metricNames[k], sampleVariance(y + replications, replications, &mean) / 2,
+					sampleVariance(y, replications, &mean));
+			}
+			fprintf(results, "\n");
 		}
 	}
+	if (compare_slice > 0) {
+		fprintf(results, "difference (time slice %d - %d):", slice[0], slice[1]);
+		for (k = 0; k < RUN_METRICS; k++) {
+			pairMeans(x, 0, k, y);
+			pairMeans(x, 1, k, y + replications);
+			for (r = 0; r < replications; r++)
+				y[2 * replications + r] = y[r] - y[replications + r];
+			printInterval(metricNames[k], y + 2 * replications);
+		}
+		// independent runs would give the difference the variance of both sides added up
+		fprintf(results, "\n  common random numbers variance reduction:");
+		for (k = 0; k < RUN_METRICS; k++) {
+			pairMeans(x, 0, k, y);
+			pairMeans(x, 1, k, y + replications);
+			for (r = 0; r < replications; r++)
+				y[2 * replications + r] = y[r] - y[replications + r];
+			printReduction(metricNames[k], sampleVariance(y, replications, &mean) +
+				sampleVariance(y + replications, replications, &mean),
+				sampleVariance(y + 2 * replications, replications, &mean));
+		}
+		fprintf(results, "\n");
+	}
+	free(x);
+	free(y);
 }
 
-void scheduler(int terminate) {
-	if (terminate) {
-		total_run_count += curr_proc->run_count;
-		free(curr_proc);
+/*	Function: optimize
+	Input: none
+	Output: none. Successive halving over time slices, zooming in: OPT_CANDIDATES time slices spread
+	over the range get OPT_FIRST_REPS replications each, the better half of them twice as many, and so
+	on until two are left or every replication is used. The range then shrinks to the neighbours of the
+	best and the search goes again, until neighbouring candidates are 1 apart. All candidates of a
+	round share substreams (common random numbers), so they are ranked on the same workloads, and a
+	time slice evaluated in one round is not run again in the next. Prints every round, then the best
+	and the runner-up on all replications, with their paired difference
+*/
+void optimize() {
+	int cand[OPT_CANDIDATES + 1];
+	int lo = opt_lo;
+	int hi = opt_hi;
+	int runner_up = 0;
+	int n, step, reps, t;
+
+	for (;;) {
+		step = (hi - lo + OPT_CANDIDATES - 2) / (OPT_CANDIDATES - 1);
+		if (step < 1)
+			step = 1;
+		n = 0;
+		for (t = lo; t <= hi; t += step)
+			cand[n++] = t;
+		if (cand[n - 1] != hi)
+			cand[n++] = hi;
+		reps = (OPT_FIRST_REPS < replications) ? OPT_FIRST_REPS : replications;
+		for (;;) {
+			if (!evaluateSlices(cand, n, reps))
+				return;
+			rankSlices(cand, n, reps);
+			fprintf(results, "time slices %d..%d step %d: %d candidates x %d replications, best %d (%s %.3f)\n",
+				lo, hi, step, n, reps, cand[0], metricNames[objective], sliceMean(cand[0], reps, objective));
+			if (n > 1)
+				runner_up = cand[1];
+			if (n <= 2 || reps >= replications)
+				break;
+			n = (n + 1) / 2;
+			reps = (reps * 2 < replications) ? reps * 2 : replications;
+		}
+		if (step == 1)
+			break;
+		lo = (cand[0] - step + 1 > opt_lo) ? cand[0] - step + 1 : opt_lo;
+		hi = (cand[0] + step - 1 < opt_hi) ? cand[0] + step - 1 : opt_hi;
 	}
+
+	if (runner_up == cand[0] || runner_up == 0)
+		n = 1;
 	else {
-		enqueue(ready_queue, curr_proc);
+		cand[1] = runner_up;
+		n = 2;
 	}
-	curr_proc = dequeue(ready_queue);
+	if (evaluateSlices(cand, n, replications)) {
+		rankSlices(cand, n, replications);
+		reportOptimum(cand[0], (n == 2) ? cand[1] : 0);
+	}
+	free(evaluations);
+	evaluations = NULL;
+	nevaluations = 0;
+}
 
-	if (isEmpty(ready_queue)) {
-		enqueue(ready_queue, idle_proc);
+/*	Function: evaluateSlices
+	Input: time slices and a # of replications
+	Output: TRUE once replications 0 .. reps-1 of every time slice are in evaluations[]. The ones that
+	are neither there nor in the cache run in forked workers, --jobs at a time, and go into the cache.
+	FALSE (after saying so) if some evaluation failed
+*/
+int evaluateSlices(const int * slices, int n, int reps) {
+	Evaluation * todo = (Evaluation *) malloc (sizeof(Evaluation) * (size_t) n * (size_t) reps * 2);
+	Evaluation * done = todo + n * reps;
+	Evaluation * grown;
+	RunKey key;
+	char * text;
+	size_t length;
+	int ntodo = 0;
+	int failed;
+	int i, r;
+
+	grown = (Evaluation *) realloc (evaluations, sizeof(Evaluation) * (size_t) (nevaluations + n * reps));
+	if (todo == NULL || grown == NULL) {
+		printf("out of memory for %d evaluations\n", n * reps);
+		free(todo);
+		if (grown != NULL)
+			evaluations = grown;
+		return FALSE;
 	}
+	evaluations = grown;
+	for (i = 0; i < n; i++)
+		for (r = 0; r < reps; r++) {
+			if (findEvaluation(slices[i], r) != NULL)
+				continue;
+			memset(&todo[ntodo], 0, sizeof(Evaluation));
+			todo[ntodo].slice = slices[i];
+			todo[ntodo].replication = r;
+			makeEvaluationKey(&key, slices[i], r);
+			if (cache != NULL && lookupResult(cache, &key, sizeof(key), &text, &length) == CACHE_HIT) {
+				if (length == sizeof(RunMetrics)) {
+					memcpy(&todo[ntodo].metrics, text, sizeof(RunMetrics));
+					evaluations[nevaluations++] = todo[ntodo];
+					free(text);
+					continue;
+				}
+				free(text);
+			}
+			ntodo++;
+		}
+
+	failed = (ntodo > 0) ? runForkedTasks(runEvaluation, todo, ntodo, jobs, done, sizeof(Evaluation)) : 0;
+	if (failed != 0) {
+		printf("%d of %d evaluations failed\n", (failed < 0) ? ntodo : failed, ntodo);
+		free(todo);
+		return FALSE;
+	}
+	for (i = 0; i < ntodo; i++) {
+		evaluations[nevaluations++] = done[i];
+		if (cache != NULL && !done[i].degraded) {
+			makeEvaluationKey(&key, done[i].slice, done[i].replication);
+			storeResult(cache, &key, sizeof(key), (const char *) &done[i].metrics, sizeof(RunMetrics));
+		}
+	}
+	free(todo);
+	return TRUE;
 }
 
-Process_p createProcess() {
-	Process_p proc = (Process_p) malloc (sizeof(Process));
-	proc->id = id++;
-	proc->run_count = 0;
-	return proc;
+/*	Function: runEvaluation
+	Input: the list of evaluations to make, which one, and where its result goes
+	Output: none. Runs in a forked worker: one quiet run with the time slice of the evaluation on the
+	substreams of its replication
+*/
+void runEvaluation(void * arg, int index, void * result) {
+	Evaluation * e = (Evaluation *) result;
+
+	*e = ((Evaluation *) arg)[index];
+	time_slice = e->slice;
+	quiet = TRUE;
+	degraded = FALSE;
+	seedStreams(streams, seed, e->replication, replications, FALSE);
+	start_loop();
+	e->metrics = last_run;
+	e->degraded = degraded;
+}
+
+/*	Function: findEvaluation
+	Input: a time slice and a replication
+	Output: its evaluation, NULL if there is none yet
+*/
+Evaluation * findEvaluation(int slice, int replication) {
+	int i;
+
+	for (i = 0; i < nevaluations; i++)
+		if (evaluations[i].slice == slice && evaluations[i].replication == replication)
+			return &evaluations[i];
+	return NULL;
+}
+
+/*	Function: makeEvaluationKey
+	Input: the key to fill in, a time slice and a replication
+	Output: none. The cache key of one evaluation: that of the run with this time slice, marked as the
+	metrics of one replication rather than printed results
+*/
+void makeEvaluationKey(RunKey * key, int slice, int replication) {
+	makeRunKey(key);
+	key->time_slice = slice;
+	key->replication = replication;
+	key->metrics = TRUE;
+}
+
+/*	Function: sliceMean
+	Input: a time slice, a # of replications and a metric
+	Output: the mean of the metric over replications 0 .. reps-1 of the time slice (all evaluated)
+*/
+double sliceMean(int slice, int reps, int metric) {
+	double sum = 0.0;
+	int r;
+
+	for (r = 0; r < reps; r++)
+		sum += runMetric(&findEvaluation(slice, r)->metrics, metric);
+	return sum / reps;
+}
+
+/*	Function: rankSlices
+	Input: time slices evaluated on reps replications
+	Output: none. Sorts them best first: those that reach --floor before those that do not, then the
+	lowest objective (among those that miss it, the highest utilization), then the shortest time slice
+*/
+void rankSlices(int * slices, int n, int reps) {
+	double objectives[OPT_CANDIDATES + 1];
+	double utilizations[OPT_CANDIDATES + 1];
+	double o, u;
+	int i, j, s;
+
+	for (i = 0; i < n; i++) {
+		s = slices[i];
+		o = sliceMean(s, reps, objective);
+		u = sliceMean(s, reps, METRIC_UTILIZATION);
+		for (j = i; j > 0 && !betterSlice(slices[j - 1], objectives[j - 1], utilizations[j - 1], s, o, u); j--) {
+			slices[j] = slices[j - 1];
+			objectives[j] = objectives[j - 1];
+			utilizations[j] = utilizations[j - 1];
+		}
+		slices[j] = s;
+		objectives[j] = o;
+		utilizations[j] = u;
+	}
+}
+
+/*	Function: betterSlice
+	Input: two time slices with their mean objective and utilization
+	Output: TRUE if the first ranks before the second (see rankSlices())
+*/
+int betterSlice(int a, double objective_a, double utilization_a, int b, double objective_b, double utilization_b) {
+	int feasible_a = utilization_a >= utilization_floor;
+	int feasible_b = utilization_b >= utilization_floor;
+
+	if (feasible_a != feasible_b)
+		return feasible_a;
+	if (!feasible_a && utilization_a != utilization_b)
+		return utilization_a > utilization_b;
+	if (objective_a != objective_b)
+		return objective_a < objective_b;
+	return a < b;
+}
+
+/*	Function: reportOptimum
+	Input: the best time slice and the runner-up (0 if there was none), both on every replication
+	Output: none. Prints the objective and the utilization of the best with their 95% confidence
+	intervals, and the difference to the runner-up, paired over the replications, and whether that
+	difference of the objective is significant. If not, the two tie as far as the replications tell
+*/
+void reportOptimum(int best, int runner_up) {
+	double * y = (double *) malloc (sizeof(double) * (size_t) replications);
+	int metric[2] = { objective, METRIC_UTILIZATION };
+	double mean = 0, halfWidth = 0;
+	int r, k;
+
+	if (y == NULL)
+		return;
+	if (sliceMean(best, replications, METRIC_UTILIZATION) < utilization_floor)
+		fprintf(results, "no time slice in %d..%d keeps the utilization at %g, closest:\n", opt_lo, opt_hi,
+			utilization_floor);
+	fprintf(results, "best time slice %d over %d replications:", best, replications);
+	for (k = 0; k < 2; k++) {
+		for (r = 0; r < replications; r++)
+			y[r] = runMetric(&findEvaluation(best, r)->metrics, metric[k]);
+		printInterval(metricNames[metric[k]], y);
+	}
+	fprintf(results, "\n");
+	if (runner_up > 0) {
+		fprintf(results, "runner-up %d, difference (%d - %d):", runner_up, best, runner_up);
+		for (k = 0; k < 2; k++) {
+			for (r = 0; r < replications; r++)
+				y[r] = runMetric(&findEvaluation(best, r)->metrics, metric[k]) -
+					runMetric(&findEvaluation(runner_up, r)->metrics, metric[k]);
+			printInterval(metricNames[metric[k]], y);
+			if (k == 0)
+				halfWidth = tQuantile(replications - 1) * sqrt(sampleVariance(y, replications, &mean) / replications);
+		}
+		if (fabs(mean) > halfWidth)
+			fprintf(results, "\n  the %s of %d and %d differs at 95%%\n", metricNames[objective], best, runner_up);
+		else
+			fprintf(results, "\n  the %s of %d and %d does not differ at 95%%, they tie over %d replications\n",
+				metricNames[objective], best, runner_up, replications);
+	}
+	free(y);
+}
+
+/*	Function: pairMeans
+	Input: the metrics of every run of replicate(), a time slice (0 or 1) and a metric
+	Output: none. y[r] is the metric of replication r, the mean of the pair under --antithetic
+*/
+void pairMeans(const double * x, int s, int k, double * y) {
+	int r;
+
+	for (r = 0; r < replications; r++)
+		y[r] = (x[RUN_INDEX(r, s, 0, k)] + x[RUN_INDEX(r, s, antithetic, k)]) / 2;
+}
+
+/*	Function: printInterval
+	Input: a metric and its value in each replication
+	Output: none. Prints their mean with the half width of its 95% confidence interval
+*/
+void printInterval(const char * name, const double * y) {
+	double mean;
+	double var = sampleVariance(y, replications, &mean);
+
+	fprintf(results, " %s %.6f +- %.6f", name, mean, tQuantile(replications - 1) * sqrt(var / replications));
+}
+
+/*	Function: printReduction
+	Input: a metric, its variance without and with the variance reduction
+	Output: none. Prints the factor the variance went down by, the # of independent runs one paired run
+	is worth. A variance left over that is rounding (REDUCTION_EXACT of the one before, or less) counts
+	as none
+*/
+void printReduction(const char * name, double before, double after) {
+	if (after > before * REDUCTION_EXACT)
+		fprintf(results, " %s %.2fx", name, before / after);
+	else if (before > 0)
+		fprintf(results, " %s exact", name);
+	else
+		fprintf(results, " %s n/a", name);
+}
+
+/*	Function: sampleRun
+	Input: none
+	Output: TRUE if the run can stop. The tick's observations go into the batch means, and whenever
+	that completes a batch both estimates are checked against --precision
+*/
+int sampleRun() {
+	BatchEstimate est;
+	int full = addObservation(in_system, liveProcesses(procs) - 1);
+
+	addObservation(busy, curr_proc != idle_proc && overhead_left == 0);
+	return full && estimateBatchMeans(in_system, &est) && isPrecise(&est, precision) &&
+		estimateBatchMeans(busy, &est) && isPrecise(&est, precision);
+}
+
+/*	Function: reportPrecision
+	Input: none
+	Output: prints where the run stopped and the estimates --precision was asking for, with the half
+	widths of their 95% confidence intervals and the ticks cut off as warm-up
+*/
+void reportPrecision() {
+	BatchEstimate sys;
+	BatchEstimate util;
+
+	fprintf(results, "stopped at %lld of %lld ticks", counter, max_ticks);
+	if (estimateBatchMeans(in_system, &sys) && estimateBatchMeans(busy, &util))
+		fprintf(results, ": in system %.4f +- %.4f (warm-up %lld) utilization %.6f +- %.6f (warm-up %lld) batches of %lld\n",
+			sys.mean, sys.halfWidth, sys.warmup, util.mean, util.halfWidth, util.warmup, in_system->size);
+	else
+		fprintf(results, ", too short for an estimate\n");
+}
+
+/*	Function: saveRun
+	Input: none
+	Output: writes a checkpoint of the run to checkpoint_path, stops checkpointing if that fails
+*/
+void saveRun() {
+	List_p device_queues[IO_DEVICES];
+	SimScalars s;
+	int i;
+
+	memset(&s, 0, sizeof(s));
+	s.counter = counter;
+	s.total_run_count = total_run_count;
+	s.id = id;
+	s.full_ticks = full_ticks;
+	s.blocked_ticks = blocked_ticks;
+	s.dropped_ticks = dropped_ticks;
+	s.overhead_left = overhead_left;
+	s.overhead_ticks = overhead_ticks;
+	s.switches = switches;
+	s.slice_end = slice_end;
+	s.io_blocked_ticks = io_blocked_ticks;
+	s.responses = responses;
+	s.response_times = response_times;
+	for (i = 0; i < RAND_STREAMS; i++)
+		s.rand_state[i] = (long long) streams[i].state;
+	s.curr_proc = curr_proc;
+	s.idle_proc = idle_proc;
+	s.held_proc = held_proc;
+	s.nblocked = nblocked;
+	getQueueStats(ready_queue, &s.queue);
+	if (in_system != NULL && (!saveBatchMeans(in_system, &s.in_system) || !saveBatchMeans(busy, &s.busy))) {
+		printf("the batch means do not fit in a checkpoint, going on without\n");
+		closeCheckpoint(checkpoint);
+		checkpoint = NULL;
+		return;
+	}
+	for (i = 0; io && i < ndevices; i++) {
+		s.devices[i].done_at = devices[i].done_at;
+		s.devices[i].busy_ticks = devices[i].busy_ticks;
+		s.devices[i].completions = devices[i].completions;
+		s.devices[i].response_ticks = devices[i].response_ticks;
+		s.devices[i].serving = devices[i].serving;
+		device_queues[i] = devices[i].queue;
+	}
+	markProcessDirty(procs, curr_proc);
+	if (saveCheckpoint(checkpoint, &s, procs, ready_queue, device_queues) != CHECKPOINT_OK) {
+		printf("could not write the checkpoint %s, going on without\n", checkpoint_path);
+		closeCheckpoint(checkpoint);
+		checkpoint = NULL;
+	}
+}
+
+/*	Function: resumeRun
+	Input: none
+	Output: TRUE if the state saved at checkpoint_path was loaded into the (empty) process table, ready
+	queue and device queues, FALSE (after saying why) if not
+*/
+int resumeRun() {
+	List_p device_queues[IO_DEVICES];
+	SimScalars s;
+	int i;
+
+	for (i = 0; io && i < ndevices; i++)
+		device_queues[i] = devices[i].queue;
+	switch (loadCheckpoint(checkpoint, &s, procs, ready_queue, device_queues)) {
+		case CHECKPOINT_OK:
+			break;
+		case CHECKPOINT_NONE:
+			printf("no checkpoint at %s\n", checkpoint_path);
+			return FALSE;
+		case CHECKPOINT_MISMATCH:
+			printf("the checkpoint at %s is of a run with other arguments\n", checkpoint_path);
+			return FALSE;
+		default:
+			printf("the checkpoint at %s could not be read\n", checkpoint_path);
+			return FALSE;
+	}
+	counter = s.counter;
+	total_run_count = s.total_run_count;
+	id = s.id;
+	full_ticks = s.full_ticks;
+	blocked_ticks = s.blocked_ticks;
+	dropped_ticks = s.dropped_ticks;
+	overhead_left = s.overhead_left;
+	overhead_ticks = s.overhead_ticks;
+	switches = s.switches;
+	slice_end = s.slice_end;
+	io_blocked_ticks = s.io_blocked_ticks;
+	responses = s.responses;
+	response_times = s.response_times;
+	for (i = 0; i < RAND_STREAMS; i++)
+		streams[i].state = (unsigned long long) s.rand_state[i];
+	curr_proc = s.curr_proc;
+	idle_proc = s.idle_proc;
+	held_proc = s.held_proc;
+	nblocked = s.nblocked;
+	ready_queue->stats = s.queue;
+	if (in_system != NULL && (!restoreBatchMeans(in_system, &s.in_system) || !restoreBatchMeans(busy, &s.busy))) {
+		printf("the checkpoint at %s could not be read\n", checkpoint_path);
+		return FALSE;
+	}
+	for (i = 0; io && i < ndevices; i++) {
+		devices[i].done_at = s.devices[i].done_at;
+		devices[i].busy_ticks = s.devices[i].busy_ticks;
+		devices[i].completions = s.devices[i].completions;
+		devices[i].response_ticks = s.devices[i].response_ticks;
+		devices[i].serving = s.devices[i].serving;
+	}
+	if (io)
+		limitReady();
+	return TRUE;
+}
+
+/*	Function: enqueueReady
+	Input: a process that is ready to run
+	Output: none. The process was admitted before, so the limit does not apply
+*/
+void enqueueReady(ProcHandle proc) {
+	if (spill_queue == NULL)
+		requeuePayload(ready_queue, PROC_PAYLOAD(proc));
+	else if (enqueueSpill(spill_queue, &proc) != TRUE) {
+		printf("could not spill process %lld\n", procs->id[proc]);
+		degraded = TRUE;
+	}
+}
+
+/*	Function: dequeueReady
+	Input: none
+	Output: the next process to run, NO_PROCESS if there is none
+*/
+ProcHandle dequeueReady() {
+	ProcHandle proc;
+
+	if (spill_queue == NULL) {
+		void * payload = dequeue(ready_queue);
+		return (payload != NULL) ? PROC_HANDLE(payload) : NO_PROCESS;
+	}
+	return (dequeueSpill(spill_queue, &proc) == TRUE) ? proc : NO_PROCESS;
+}
+
+/*	Function: createProcess
+	Input: none
+	Output: the handle of a new process in the process table, arrived now
+*/
+ProcHandle createProcess() {
+	return allocProcess(procs, id++, counter);
 }
 
 //===========================================================================
@@ -133,13 +1428,13 @@ Process_p createProcess() {
 //=    - Input:  Mean value of distribution                                 =
 //=    - Output: Returns with exponentially distributed random variable     =
 //===========================================================================
-double expon(double x) {
+double expon(RandStream_p stream, double x) {
   double z;                     // Uniform random number (0 < z < 1)
   double exp_value;             // Computed exponential value to be returned
 
   // Pull a uniform random number (0 < z < 1)
   do {
-    z = rand_val();
+    z = rand_val(stream);
   }
   while ((z == 0) || (z == 1));
 
@@ -148,33 +1443,3 @@ double expon(double x) {
 
   return(exp_value);
 }
-
-//=========================================================================
-//= Multiplicative LCG for generating uniform(0.0, 1.0) random numbers    =
-//=   - x_n = 7^5*x_(n-1)mod(2^31 - 1)                                    =
-//=   - With x seeded to 1 the 10000th x value should be 1043618065       =
-//=   - From R. Jain, "The Art of Computer Systems Performance Analysis," =
-//=     John Wiley & Sons, 1991. (Page 443, Figure 26.2)                  =
-//=========================================================================
-double rand_val() {
-  const long  a =      16807;  // Multiplier
-  const long  m = 2147483647;  // Modulus
-  const long  q =     127773;  // m div a
-  const long  r =       2836;  // m mod a
-  static long x = 1;               // Random int value
-  long        x_div_q;         // x divided by q
-  long        x_mod_q;         // x modulo q
-  long        x_new;           // New x value
-
-  // RNG using integer arithmetic
-  x_div_q = x / q;
-  x_mod_q = x % q;
-  x_new = (a * x_mod_q) - (r * x_div_q);
-  if (x_new > 0)
-    x = x_new;
-  else
-    x = x_new + m;
-
-  // Return a random value between 0.0 and 1.0
-  return((double) x / m);
-}
\ No newline at end of file
@@ -14,27 +14,173 @@
 /*********************************************************************************************************
  *                                        Preprocessor Directives
  ********************************************************************************************************/
+#ifndef _SIMULATOR_H_
+#define _SIMULATOR_H_
 
+#include "process_table.h"
+#include "rand_stream.h"
+#include "d_linkedList.h"
+
+#define SPILL_BATCH 4096		// processes per batch of the spilling ready queue
+#define CHECKPOINT_EVERY 10000000	// ticks between checkpoints unless --checkpoint-every says otherwise
+#define BATCH_TICKS 1000		// ticks per batch of the --precision estimates to start with
+#define SIM_VERSION "1.0"
+// Results in the cache belong to a build, named by SIM_BUILD (up to 47 characters). Build with a hash of
+// every source as the name, so a change anywhere gives a new one:
+//   gcc -std=gnu11 -O2 -pthread -DSIM_BUILD="\"$(cat *.c *.h | sha1sum | cut -c1-40)\""
+//       $(ls *.c | grep -v -e randexp -e _stress -e _bench) -lm -o simulator
+// Without it the name is the time simulator.c was compiled, which a change to another source leaves as
+// it was: clear the --cache files after such a change.
+#ifndef SIM_BUILD
+#define SIM_BUILD SIM_VERSION " " __DATE__ " " __TIME__
+#endif
+#define RUN_METRICS 5			// doubles in a RunMetrics, in this order:
+#define METRIC_UTILIZATION 0
+#define METRIC_WAIT 1
+#define METRIC_LOST 2
+#define METRIC_P99 3
+#define METRIC_OVERHEAD 4
+#define IO_DEVICES 8				// devices of --io at most, no more than CHECKPOINT_DEVICES
+#define SCHED_PREEMPT 0			// why scheduler() takes the running process off the CPU
+#define SCHED_TERMINATE 1
+#define SCHED_BLOCK 2			// it starts I/O
+#define OPT_CANDIDATES 16		// time slices per round of --optimize
+#define OPT_FIRST_REPS 2		// replications per candidate in the first halving step
+#define OPT_REPLICATIONS 16		// replications per time slice at most, unless --replications says
+// metric k of replication r, time slice s (0 or 1, --compare) and antithetic run a (0 or 1) in replicate()
+#define RUN_INDEX(r, s, a, k) ((((r) * 2 + (s)) * 2 + (a)) * RUN_METRICS + (k))
+#define REDUCTION_EXACT 1e-12		// variance left over by a reduction that is only rounding
 
 /*********************************************************************************************************
  *                                              ADTs
  ********************************************************************************************************/
-typedef struct process {
-	int id;
-	int run_count;
-} Process;
+typedef struct run_metrics {	// what replicate() compares between runs
+	double utilization;
+	double wait;				// mean over the processes in the system at the end
+	double lost;				// arrivals rejected or dropped
+	double p99;					// 99th percentile of the response times (arrival to termination)
+	double overhead;			// share of the ticks spent dispatching (--switch-cost, --refill)
+} RunMetrics;
+
+typedef struct io_device {		// one device of --io, serving its queue in arrival order
+	List_p queue;				// blocked processes waiting for it, as PROC_PAYLOAD() handles
+	ProcHandle serving;			// NO_PROCESS while it is idle
+	Tick done_at;				// tick the service under way ends
+	Tick busy_ticks;
+	Tick completions;
+	Tick response_ticks;		// from blocking to waking, over the completions
+} IODevice;
+
+typedef struct evaluation {		// one run of --optimize
+	int slice;
+	int replication;
+	int degraded;				// the run fell back on something, do not cache it
+	int reserved;
+	RunMetrics metrics;
+} Evaluation;
+
+typedef struct run_key {		// what the result cache files a run under
+	char build[48];				// SIM_BUILD
+	int max_proc;
+	int avg_proc;
+	int mean_times;
+	int time_slice;
+	int spill;
+	int admit_policy;
+	int replications;
+	int antithetic;
+	int compare_slice;
+	int replication;			// of an evaluation of --optimize
+	int metrics;				// TRUE: the result is the RunMetrics of one replication, not printed output
+	int switch_cost;
+	int refill;
+	int devices;
+	Tick max_ticks;
+	long long seed;
+	double precision;
+	double warmth;
+	double burst;
+	double io_service[IO_DEVICES];	// 0 past the last device
+} RunKey;
 
-typedef Process * Process_p;
 
 /*********************************************************************************************************
  *                                           Prototypes
  ********************************************************************************************************/
+void run();
+
+void runCached();
+
+void makeRunKey(RunKey * key);
+
 void start_loop();
 
-void scheduler();
+void scheduler(int reason);
+
+long long readyProcesses();
+
+Tick dispatchCost(ProcHandle to);
+
+void enqueueReady(ProcHandle proc);
+
+ProcHandle dequeueReady();
+
+void arrive();
+
+void blockOnIO(ProcHandle proc);
+
+void serviceDevices();
+
+void limitReady();
+
+void startService(IODevice * dev);
+
+Tick drawTicks(ProcHandle proc, double mean);
+
+void dropProcess(void * proc);
+
+void report();
+
+void measureRun(RunMetrics * m);
+
+double runMetric(const RunMetrics * m, int metric);
+
+void replicate();
+
+void optimize();
+
+int evaluateSlices(const int * slices, int n, int reps);
+
+void runEvaluation(void * arg, int index, void * result);
+
+Evaluation * findEvaluation(int slice, int replication);
+
+void makeEvaluationKey(RunKey * key, int slice, int replication);
+
+double sliceMean(int slice, int reps, int metric);
+
+void rankSlices(int * slices, int n, int reps);
+
+int betterSlice(int a, double objective_a, double utilization_a, int b, double objective_b, double utilization_b);
+
+void reportOptimum(int best, int runner_up);
+
+void pairMeans(const double * x, int s, int k, double * y);
+
+void printInterval(const char * name, const double * y);
+
+void printReduction(const char * name, double before, double after);
+
+int sampleRun();
+
+void reportPrecision();
+
+void saveRun();
+
+int resumeRun();
 
-Process_p createProcess();
+ProcHandle createProcess();
 
-double expon(double x);
+double expon(RandStream_p stream, double x);
 
-double rand_val();
\ No newline at end of file
+#endif
@@ -0,0 +1,457 @@
+/*
+	spill_queue.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Implementation of the disk spilling queue (see spill_queue.h).
+
+	The records in the queue are, oldest first: head[headPos .. headCount), then staging (when a prefetch
+	is READY or PENDING), then the file between readPos and writePos, then tail[0 .. tailCount). Enqueue
+	only ever adds to the head while everything behind it is empty, and otherwise to the tail, so this
+	order is kept. The file is only appended to; once everything in it was read back it is truncated and
+	written from the start again.
+
+	The prefetch thread owns the staging buffer while the state is SPILL_PENDING, the queue owns it
+	otherwise. Only the prefetch thread and refillHead() read the state; everywhere else the queue goes
+	by its own staged flag, which is set from the request until the batch is taken into the head. The
+	file regions read by the thread are never written again before it is done with them.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "spill_queue.h"
+
+#define SPILL_TEMPLATE "/spillXXXXXX"
+
+/*********************************************************************************************************
+ *                                           Functions
+ ********************************************************************************************************/
+/************************************************************************************************************
+ * writeFully / readFully
+ *
+ * Synopsis: static int writeFully (int fd, const char * buffer, size_t length, off_t pos)
+ *
+ * Description: pwrite()/pread() of length bytes at pos, retrying short and interrupted transfers.
+ *
+ * Returns: 0, or -1 if the transfer failed or the file ended early.
+ *
+ ************************************************************************************************************/
+static int writeFully (int fd, const char * buffer, size_t length, off_t pos) {
+	while (length > 0) {
+		ssize_t n = pwrite(fd, buffer, length, pos);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return -1;
+		buffer += n;
+		length -= (size_t) n;
+		pos += n;
+	}
+	return 0;
+}
+
+static int readFully (int fd, char * buffer, size_t length, off_t pos) {
+	while (length > 0) {
+		ssize_t n = pread(fd, buffer, length, pos);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return -1;
+		buffer += n;
+		length -= (size_t) n;
+		pos += n;
+	}
+	return 0;
+}
+/************************************************************************************************************
+ * prefetchLoop
+ *
+ * Synopsis: static void * prefetchLoop (void * arg)
+ *
+ * Description: Body of the prefetch thread: waits for a request, reads the batch into staging and
+ * marks it READY, until the queue is destroyed.
+ *
+ * Returns: NULL.
+ *
+ ************************************************************************************************************/
+static void * prefetchLoop (void * arg) {
+	SpillQueue_p queue = (SpillQueue_p) arg;
+	off_t pos;
+	size_t length;
+	int error;
+
+	pthread_mutex_lock(&queue->lock);
+	for (;;) {
+		while (!queue->shutdown && queue->state != SPILL_PENDING)
+			pthread_cond_wait(&queue->cond, &queue->lock);
+		if (queue->shutdown)
+			break;
+		pos = queue->requestPos;
+		length = (size_t) queue->requestCount * queue->recordSize;
+		pthread_mutex_unlock(&queue->lock);
+
+		error = readFully(queue->fd, queue->staging, length, pos);
+
+		pthread_mutex_lock(&queue->lock);
+		queue->readError = error;
+		queue->state = SPILL_READY;
+		pthread_cond_broadcast(&queue->cond);
+	}
+	pthread_mutex_unlock(&queue->lock);
+	return NULL;
+}
+/************************************************************************************************************
+ * openScratch
+ *
+ * Synopsis: static int openScratch (SpillQueue_p queue)
+ *
+ * Description: Creates the scratch file, removes its name right away and starts the prefetch thread.
+ *
+ * Returns: 0, or -1 if not successful.
+ *
+ ************************************************************************************************************/
+static int openScratch (SpillQueue_p queue) {
+	char * path = (char *) malloc (strlen(queue->dir) + sizeof(SPILL_TEMPLATE));
+
+	if (path == NULL)
+		return -1;
+	sprintf(path, "%s%s", queue->dir, SPILL_TEMPLATE);
+	queue->fd = mkstemp(path);
+	if (queue->fd >= 0)
+		unlink(path);
+	free(path);
+	if (queue->fd < 0)
+		return -1;
+	if (pthread_create(&queue->prefetcher, NULL, prefetchLoop, queue) != 0) {
+		close(queue->fd);
+		queue->fd = -1;
+		return -1;
+	}
+	queue->started = TRUE;
+	return 0;
+}
+/************************************************************************************************************
+ * diskRecords
+ *
+ * Synopsis: static long diskRecords (SpillQueue_p queue)
+ *
+ * Description: # of records in the file that were not read back or requested yet.
+ *
+ * Returns: The # of records.
+ *
+ ************************************************************************************************************/
+static long diskRecords (SpillQueue_p queue) {
+	return (long) ((queue->writePos - queue->readPos) / (off_t) queue->recordSize);
+}
+/************************************************************************************************************
+ * rewindScratch
+ *
+ * Synopsis: static void rewindScratch (SpillQueue_p queue)
+ *
+ * Description: Once the file was read back completely (and no read is in flight) it is cut to 0 bytes, so
+ * the file never grows beyond the largest backlog.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void rewindScratch (SpillQueue_p queue) {
+	if (queue->fd < 0 || queue->writePos == 0 || queue->readPos != queue->writePos || queue->staged)
+		return;
+	if (ftruncate(queue->fd, 0) == 0)
+		queue->readPos = queue->writePos = 0;
+}
+/************************************************************************************************************
+ * startPrefetch
+ *
+ * Synopsis: static void startPrefetch (SpillQueue_p queue)
+ *
+ * Description: Asks the prefetch thread for the next batch of the file when the head is at most half full
+ * and staging is free.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+static void startPrefetch (SpillQueue_p queue) {
+	long n = diskRecords(queue);
+
+	if (n == 0 || queue->staged || queue->headCount - queue->headPos > queue->batch / 2)
+		return;
+	if (n > queue->batch)
+		n = queue->batch;
+	pthread_mutex_lock(&queue->lock);
+	queue->requestPos = queue->readPos;
+	queue->requestCount = (int) n;
+	queue->stagingCount = (int) n;
+	queue->state = SPILL_PENDING;
+	queue->staged = TRUE;
+	pthread_cond_broadcast(&queue->cond);
+	pthread_mutex_unlock(&queue->lock);
+	queue->readPos += (off_t) n * (off_t) queue->recordSize;
+	queue->stats.prefetches++;
+}
+/************************************************************************************************************
+ * spillTail
+ *
+ * Synopsis: static int spillTail (SpillQueue_p queue)
+ *
+ * Description: Makes room in a full tail. If nothing lies between the head and the tail, the tail simply
+ * becomes the staging batch; otherwise it is appended to the file with one write.
+ *
+ * Returns: 0, or -1 if the file could not be created or written.
+ *
+ ************************************************************************************************************/
+static int spillTail (SpillQueue_p queue) {
+	size_t length = (size_t) queue->tailCount * queue->recordSize;
+	char * swap;
+
+	if (!queue->staged && diskRecords(queue) == 0) {
+		swap = queue->staging;
+		queue->staging = queue->tail;
+		queue->tail = swap;
+		queue->stagingCount = queue->tailCount;
+		queue->tailCount = 0;
+		queue->staged = TRUE;
+		pthread_mutex_lock(&queue->lock);
+		queue->readError = 0;
+		queue->state = SPILL_READY;
+		pthread_mutex_unlock(&queue->lock);
+		return 0;
+	}
+	if (queue->fd < 0 && openScratch(queue) != 0)
+		return -1;
+	if (writeFully(queue->fd, queue->tail, length, queue->writePos) != 0)
+		return -1;
+	queue->writePos += (off_t) length;
+	queue->stats.spilledBatches++;
+	queue->stats.spilledRecords += queue->tailCount;
+	queue->tailCount = 0;
+	startPrefetch(queue);
+	return 0;
+}
+/************************************************************************************************************
+ * refillHead
+ *
+ * Synopsis: static int refillHead (SpillQueue_p queue)
+ *
+ * Description: Loads the next batch into the empty head: the staging batch (waiting for it if the read
+ * is still in flight), else a batch read from the file right now, else the tail.
+ *
+ * Returns: 0, or -1 if the file could not be read.
+ *
+ ************************************************************************************************************/
+static int refillHead (SpillQueue_p queue) {
+	char * swap;
+	long n;
+	int state;
+	int error;
+
+	pthread_mutex_lock(&queue->lock);
+	if (queue->state == SPILL_PENDING) {
+		queue->stats.waits++;
+		while (queue->state == SPILL_PENDING)
+			pthread_cond_wait(&queue->cond, &queue->lock);
+	}
+	state = queue->state;
+	error = queue->readError;
+	queue->state = SPILL_IDLE;
+	pthread_mutex_unlock(&queue->lock);
+	queue->staged = FALSE;
+
+	queue->headPos = 0;
+	queue->headCount = 0;
+	if (state == SPILL_READY) {
+		if (error)
+			return -1;
+		swap = queue->head;
+		queue->head = queue->staging;
+		queue->staging = swap;
+		queue->headCount = queue->stagingCount;
+	} else if ((n = diskRecords(queue)) > 0) {
+		if (n > queue->batch)
+			n = queue->batch;
+		if (readFully(queue->fd, queue->head, (size_t) n * queue->recordSize, queue->readPos) != 0)
+			return -1;
+		queue->readPos += (off_t) n * (off_t) queue->recordSize;
+		queue->headCount = (int) n;
+		queue->stats.syncReads++;
+	} else {
+		swap = queue->head;
+		queue->head = queue->tail;
+		queue->tail = swap;
+		queue->headCount = queue->tailCount;
+		queue->tailCount = 0;
+	}
+	rewindScratch(queue);
+	return 0;
+}
+/************************************************************************************************************
+ * createSpillQueue
+ *
+ * Synopsis: SpillQueue_p createSpillQueue (const char * title, size_t recordSize, int batch, const char * dir)
+ *
+ * Description: Allocates the queue and its three batch buffers. The file and the prefetch thread are only
+ * created by the first spill, so a queue that never outgrows memory costs no more than the buffers, but
+ * dir is checked now so a queue that could never spill is refused up front.
+ *
+ * Returns: A pointer to the queue in the heap, NULL if not successful.
+ *
+ ************************************************************************************************************/
+SpillQueue_p createSpillQueue (const char * title, size_t recordSize, int batch, const char * dir) {
+	SpillQueue_p queue;
+	size_t bytes;
+
+	if (recordSize == 0 || access((dir != NULL) ? dir : "/tmp", W_OK | X_OK) != 0)
+		return NULL;
+	if (batch < SPILL_MIN_BATCH)
+		batch = SPILL_MIN_BATCH;
+	queue = (SpillQueue_p) calloc (1, sizeof(SpillQueue));
+	if (queue == NULL)
+		return NULL;
+	bytes = (size_t) batch * recordSize;
+	queue->recordSize = recordSize;
+	queue->batch = batch;
+	queue->fd = -1;
+	queue->title = (title != NULL) ? strdup(title) : NULL;
+	queue->dir = strdup((dir != NULL) ? dir : "/tmp");
+	queue->head = (char *) malloc (bytes);
+	queue->tail = (char *) malloc (bytes);
+	queue->staging = (char *) malloc (bytes);
+	if ((title != NULL && queue->title == NULL) || queue->dir == NULL || queue->head == NULL ||
+			queue->tail == NULL || queue->staging == NULL) {
+		free(queue->title);
+		free(queue->dir);
+		free(queue->head);
+		free(queue->tail);
+		free(queue->staging);
+		free(queue);
+		return NULL;
+	}
+	pthread_mutex_init(&queue->lock, NULL);
+	pthread_cond_init(&queue->cond, NULL);
+	queue->state = SPILL_IDLE;
+	return queue;
+}
+/************************************************************************************************************
+ * destroySpillQueue
+ *
+ * Synopsis: void destroySpillQueue (SpillQueue_p queue)
+ *
+ * Description: Stops the prefetch thread (a read in flight is finished first), closes the file, which
+ * has no name left and so disappears, and frees the queue.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void destroySpillQueue (SpillQueue_p queue) {
+	if (queue == NULL)
+		return;
+	if (queue->started) {
+		pthread_mutex_lock(&queue->lock);
+		queue->shutdown = TRUE;
+		pthread_cond_broadcast(&queue->cond);
+		pthread_mutex_unlock(&queue->lock);
+		pthread_join(queue->prefetcher, NULL);
+	}
+	if (queue->fd >= 0)
+		close(queue->fd);
+	pthread_mutex_destroy(&queue->lock);
+	pthread_cond_destroy(&queue->cond);
+	free(queue->title);
+	free(queue->dir);
+	free(queue->head);
+	free(queue->tail);
+	free(queue->staging);
+	free(queue);
+}
+/************************************************************************************************************
+ * sizeSpill
+ *
+ * Synopsis: long sizeSpill (SpillQueue_p queue)
+ *
+ * Description: Status function of the queue.
+ *
+ * Returns: The # of records, 0 if queue is NULL.
+ *
+ ************************************************************************************************************/
+long sizeSpill (SpillQueue_p queue) {
+	return (queue != NULL) ? queue->count : 0;
+}
+/************************************************************************************************************
+ * enqueueSpill
+ *
+ * Synopsis: int enqueueSpill (SpillQueue_p queue, const void * record)
+ *
+ * Description: Copies the record behind the head while nothing else is queued and the head has room,
+ * else into the tail, spilling the tail first if it is full.
+ *
+ * Returns: TRUE if successful, PUSH_ERROR if not.
+ *
+ ************************************************************************************************************/
+int enqueueSpill (SpillQueue_p queue, const void * record) {
+	if (queue == NULL || record == NULL)
+		return PUSH_ERROR;
+	if (queue->headPos == queue->headCount)
+		queue->headPos = queue->headCount = 0;
+
+	if (queue->tailCount == 0 && !queue->staged && diskRecords(queue) == 0 &&
+			queue->headCount < queue->batch) {
+		memcpy(queue->head + (size_t) queue->headCount * queue->recordSize, record, queue->recordSize);
+		queue->headCount++;
+	} else {
+		if (queue->tailCount == queue->batch && spillTail(queue) != 0)
+			return PUSH_ERROR;
+		memcpy(queue->tail + (size_t) queue->tailCount * queue->recordSize, record, queue->recordSize);
+		queue->tailCount++;
+	}
+	queue->count++;
+	return TRUE;
+}
+/************************************************************************************************************
+ * dequeueSpill
+ *
+ * Synopsis: int dequeueSpill (SpillQueue_p queue, void * record)
+ *
+ * Description: Copies out the oldest record of the head, refilling the head first if it is empty, and
+ * starts the prefetch of the next batch once the head is half used.
+ *
+ * Returns: TRUE if a record was removed, FALSE if the queue is empty, PUSH_ERROR on a read error.
+ *
+ ************************************************************************************************************/
+int dequeueSpill (SpillQueue_p queue, void * record) {
+	if (queue == NULL || record == NULL)
+		return PUSH_ERROR;
+	if (queue->count == 0)
+		return FALSE;
+	if (queue->headPos == queue->headCount && refillHead(queue) != 0)
+		return PUSH_ERROR;
+
+	memcpy(record, queue->head + (size_t) queue->headPos * queue->recordSize, queue->recordSize);
+	queue->headPos++;
+	queue->count--;
+	startPrefetch(queue);
+	return TRUE;
+}
+/************************************************************************************************************
+ * getSpillStats
+ *
+ * Synopsis: void getSpillStats (SpillQueue_p queue, SpillStats * stats)
+ *
+ * Description: Copies the counters of the queue to stats.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void getSpillStats (SpillQueue_p queue, SpillStats * stats) {
+	if (queue == NULL || stats == NULL)
+		return;
+	*stats = queue->stats;
+}
@@ -0,0 +1,118 @@
+/*
+	spill_queue.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Header file for the disk spilling queue ADT.
+
+	spill_queue.c implements a FIFO queue of fixed size records whose memory use stays bounded however
+	long the backlog grows. Only the oldest records (the head batch) and the newest ones (the tail batch)
+	are kept in memory. When the tail batch fills up it is appended to a scratch file with one write, and
+	the records in the file form the cold middle of the queue. While the head batch is being consumed a
+	background thread reads the next batch from the file into a staging buffer, so dequeue rarely waits
+	for the disk.
+
+	             in memory                      on disk                        in memory
+	+---------------------------+   +--------------------------------+   +-----------------------+
+	| head batch (oldest) +     | < | batch | batch | batch | ...    | < | tail batch (newest)   |
+	| staging (next batch)      |   | append-only scratch file       |   |                       |
+	+---------------------------+   +--------------------------------+   +-----------------------+
+
+	Records are copied in and out by value, so they must not hold pointers that matter to anybody else
+	(store a handle or the struct itself, not a pointer to it).
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _SPILL_QUEUE_H_
+#define _SPILL_QUEUE_H_
+
+#include <stddef.h>
+#include <sys/types.h>
+#include <pthread.h>
+
+#include "queue.h"			// shares PUSH_ERROR, TRUE and FALSE
+
+#define SPILL_MIN_BATCH 16		// records per batch at the least
+#define SPILL_IDLE 0			// prefetch states
+#define SPILL_PENDING 1
+#define SPILL_READY 2
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef struct spill_stats {
+	long spilledBatches;	// batches written to the file
+	long spilledRecords;
+	long prefetches;		// batches read back by the prefetch thread
+	long waits;				// dequeues that had to wait for a prefetch still in flight
+	long syncReads;			// batches read back by dequeue itself (no prefetch was started in time)
+} SpillStats;
+
+typedef struct spill_queue {
+	char * title;			// optional name of the queue
+	size_t recordSize;
+	int batch;				// records per batch
+	long count;				// records in the queue
+
+	char * head;			// oldest records: [headPos, headCount)
+	int headPos;
+	int headCount;
+	char * tail;			// newest records: [0, tailCount)
+	int tailCount;
+	char * staging;			// next batch from the file, filled by the prefetch thread
+	int stagingCount;
+	int staged;				// staging holds (or is being filled with) the next batch
+
+	int fd;					// scratch file, -1 until the first spill
+	off_t readPos;			// file holds the records in [readPos, writePos)
+	off_t writePos;
+	char * dir;				// where the scratch file is created
+
+	pthread_t prefetcher;
+	int started;			// prefetch thread running
+	pthread_mutex_t lock;	// guards the fields below
+	pthread_cond_t cond;
+	int state;				// SPILL_IDLE, SPILL_PENDING or SPILL_READY
+	off_t requestPos;		// batch the prefetch thread is asked to read
+	int requestCount;
+	int readError;
+	int shutdown;
+
+	SpillStats stats;
+} SpillQueue;
+
+typedef SpillQueue * SpillQueue_p;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+SpillQueue_p createSpillQueue (const char * title, size_t recordSize, int batch, const char * dir);
+// constructor for a spilling queue of records of recordSize
+// bytes. At most 3 * batch records are held in memory. The
+// scratch file is created in dir (NULL: /tmp) on the first
+// spill and deleted right away, so it goes with the process.
+// Returns NULL if not successful or dir is not writable
+
+void destroySpillQueue (SpillQueue_p queue);
+// stops the prefetch thread, closes the file and frees the
+// queue and every record still in it
+
+long sizeSpill (SpillQueue_p queue);
+// returns the # of records in the queue, 0 if empty
+
+int enqueueSpill (SpillQueue_p queue, const void * record);
+// copies the record to the end of the queue. Returns TRUE, or
+// PUSH_ERROR on bad arguments or if a spill failed
+
+int dequeueSpill (SpillQueue_p queue, void * record);
+// copies the oldest record to record and removes it. Returns
+// TRUE, FALSE if the queue is empty, or PUSH_ERROR if the file
+// could not be read
+
+void getSpillStats (SpillQueue_p queue, SpillStats * stats);
+
+#endif
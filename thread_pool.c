@@ -0,0 +1,191 @@
+/*
+	thread_pool.c
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: thread_pool.c implements a fixed size pool of worker threads that run batches of numbered
+	tasks. Tasks are meant to be coarse (a segment of a list each), so handing them out under the pool's
+	mutex costs nothing noticeable.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "thread_pool.h"
+
+/************************************************************************************************************
+ * runClaimed
+ *
+ * Synopsis: static void runClaimed (ThreadPool_p pool)
+ *
+ * Description: Called with the lock held. Claims and runs tasks of the current batch until none are left,
+ * dropping the lock while a task runs. Whoever finishes the last task wakes the caller.
+ *
+ * Returns: Nothing (void), with the lock held.
+ *
+ ************************************************************************************************************/
+static void runClaimed (ThreadPool_p pool) {
+	while (pool->next < pool->ntasks) {
+		int index = pool->next++;
+		PoolTask task = pool->task;
+		void * arg = pool->arg;
+
+		pthread_mutex_unlock(&pool->lock);
+		task(arg, index);
+		pthread_mutex_lock(&pool->lock);
+		if (++pool->finished == pool->ntasks)
+			pthread_cond_signal(&pool->done);
+	}
+}
+/************************************************************************************************************
+ * worker
+ *
+ * Synopsis: static void * worker (void * arg)
+ *
+ * Description: Body of every worker thread: waits for a batch it has not seen yet and helps run it.
+ *
+ * Returns: NULL when the pool shuts down.
+ *
+ ************************************************************************************************************/
+static void * worker (void * arg) {
+	ThreadPool_p pool = (ThreadPool_p) arg;
+	unsigned long seen = 0;
+
+	pthread_mutex_lock(&pool->lock);
+	for (;;) {
+		while (!pool->shutdown && pool->generation == seen)
+			pthread_cond_wait(&pool->work, &pool->lock);
+		if (pool->shutdown)
+			break;
+		seen = pool->generation;
+		runClaimed(pool);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return NULL;
+}
+/************************************************************************************************************
+ * createThreadPool
+ *
+ * Synopsis: ThreadPool_p createThreadPool (int nthreads)
+ *
+ * Description: Creates the pool and starts its workers. With nthreads <= 0 one worker per online CPU is
+ * started; the caller runs tasks too, so a batch may use one thread more than the pool holds.
+ *
+ * Returns: A pointer to the pool in the heap, NULL if not successful.
+ *
+ ************************************************************************************************************/
+ThreadPool_p createThreadPool (int nthreads) {
+	ThreadPool_p pool;
+	int i;
+
+	if (nthreads <= 0)
+		nthreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	if (nthreads <= 0)
+		nthreads = 1;
+	if (nthreads > POOL_MAX_THREADS)
+		nthreads = POOL_MAX_THREADS;
+
+	pool = (ThreadPool_p) malloc (sizeof(ThreadPool));
+	if (pool == NULL)
+		return NULL;
+	pool->threads = (pthread_t *) malloc (sizeof(pthread_t) * nthreads);
+	if (pool->threads == NULL) {
+		free(pool);
+		return NULL;
+	}
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->work, NULL);
+	pthread_cond_init(&pool->done, NULL);
+	pool->task = NULL;
+	pool->arg = NULL;
+	pool->ntasks = 0;
+	pool->next = 0;
+	pool->finished = 0;
+	pool->generation = 0;
+	pool->shutdown = 0;
+	pool->size = 0;
+	for (i = 0; i < nthreads; i++) {
+		if (pthread_create(&pool->threads[i], NULL, worker, pool) != 0)
+			break;
+		pool->size++;
+	}
+	return pool;
+}
+/************************************************************************************************************
+ * destroyThreadPool
+ *
+ * Synopsis: void destroyThreadPool (ThreadPool_p pool)
+ *
+ * Description: Tells the workers to stop, joins them and frees the pool.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void destroyThreadPool (ThreadPool_p pool) {
+	int i;
+
+	if (pool == NULL)
+		return;
+	pthread_mutex_lock(&pool->lock);
+	pool->shutdown = 1;
+	pthread_cond_broadcast(&pool->work);
+	pthread_mutex_unlock(&pool->lock);
+	for (i = 0; i < pool->size; i++)
+		pthread_join(pool->threads[i], NULL);
+	pthread_cond_destroy(&pool->work);
+	pthread_cond_destroy(&pool->done);
+	pthread_mutex_destroy(&pool->lock);
+	free(pool->threads);
+	free(pool);
+}
+/************************************************************************************************************
+ * sizeThreadPool
+ *
+ * Synopsis: int sizeThreadPool (ThreadPool_p pool)
+ *
+ * Description: Counts the threads a batch runs on: the workers plus the caller.
+ *
+ * Returns: The # of threads, 1 for a NULL pool.
+ *
+ ************************************************************************************************************/
+int sizeThreadPool (ThreadPool_p pool) {
+	return (pool != NULL) ? pool->size + 1 : 1;
+}
+/************************************************************************************************************
+ * runPoolTasks
+ *
+ * Synopsis: void runPoolTasks (ThreadPool_p pool, PoolTask task, void * arg, int ntasks)
+ *
+ * Description: Posts the batch, wakes the workers, runs tasks on the calling thread as well and waits for
+ * the last one to finish.
+ *
+ * Returns: Nothing (void).
+ *
+ ************************************************************************************************************/
+void runPoolTasks (ThreadPool_p pool, PoolTask task, void * arg, int ntasks) {
+	int i;
+
+	if (task == NULL || ntasks <= 0)
+		return;
+	if (pool == NULL || pool->size == 0) {
+		for (i = 0; i < ntasks; i++)
+			task(arg, i);
+		return;
+	}
+
+	pthread_mutex_lock(&pool->lock);
+	pool->task = task;
+	pool->arg = arg;
+	pool->ntasks = ntasks;
+	pool->next = 0;
+	pool->finished = 0;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->work);
+	runClaimed(pool);
+	while (pool->finished < pool->ntasks)
+		pthread_cond_wait(&pool->done, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+}
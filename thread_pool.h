@@ -0,0 +1,68 @@
+/*
+	thread_pool.h
+
+	Programmer: agent
+	Date: 10/18/2026
+	Revision: 1.0
+
+	Purpose: Header file for the thread pool ADT.
+
+	thread_pool.c keeps a fixed set of worker threads alive so that parallel passes over a list do not
+	pay for creating threads every time. Work is handed out as a batch of numbered tasks: the caller and
+	the workers claim task numbers until the batch is exhausted, and runPoolTasks() returns once every
+	task of the batch has finished.
+*/
+
+/*********************************************************************************************************
+ *                                        Preprocessor Directives
+ ********************************************************************************************************/
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#include <pthread.h>
+
+#define POOL_MAX_THREADS 256
+
+/*********************************************************************************************************
+ *                                              ADTs
+ ********************************************************************************************************/
+typedef void (*PoolTask)(void * arg, int index);	// runs task # index of a batch
+
+typedef struct thread_pool {
+	pthread_t * threads;
+	int size;					// # of worker threads
+	pthread_mutex_t lock;		// guards everything below
+	pthread_cond_t work;		// a new batch was posted (or the pool is shutting down)
+	pthread_cond_t done;		// the last task of the batch finished
+	PoolTask task;				// the current batch
+	void * arg;
+	int ntasks;
+	int next;					// next task # to hand out
+	int finished;				// # of tasks of the batch that are done
+	unsigned long generation;	// bumped with every batch so workers can tell them apart
+	int shutdown;
+} ThreadPool;
+
+typedef ThreadPool * ThreadPool_p;
+
+/*********************************************************************************************************
+ *                                           Prototypes
+ ********************************************************************************************************/
+ThreadPool_p createThreadPool (int nthreads);
+// starts nthreads workers (0: one per online CPU). Returns
+// NULL if not successful
+
+void destroyThreadPool (ThreadPool_p pool);
+// stops and joins the workers, then frees the pool
+
+int sizeThreadPool (ThreadPool_p pool);
+// returns the # of threads that run a batch, the caller
+// included (1 for a NULL pool)
+
+void runPoolTasks (ThreadPool_p pool, PoolTask task, void * arg, int ntasks);
+// runs task(arg, 0) ... task(arg, ntasks - 1) on the workers
+// and the calling thread, and returns when all are done. A
+// NULL pool runs them in order on the calling thread. One
+// batch at a time: do not call from several threads at once
+
+#endif